@@ -0,0 +1,189 @@
+#include "GiExecutor.hpp"
+
+#include <algorithm>
+
+/**
+ * @brief Creates a pool that runs loops on the given number of threads.
+ *
+ * The calling thread of parallel_for counts as one of them, so threads - 1 workers are
+ * started.
+ *
+ * @param threads Number of threads; 0 uses std::thread::hardware_concurrency().
+ */
+GiExecutor::GiExecutor(size_t threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (size_t i = 1; i < threads; ++i) {
+        queues_.emplace_back(new Queue());
+    }
+    for (size_t i = 0; i + 1 < threads; ++i) {
+        workers_.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+GiExecutor::~GiExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Returns the process-wide pool, sized to the hardware, created on first use.
+ */
+GiExecutor& GiExecutor::shared() {
+    static GiExecutor executor;
+    return executor;
+}
+
+/**
+ * @brief Returns the number of threads loops are spread over, including the caller.
+ */
+size_t GiExecutor::concurrency() const {
+    return workers_.size() + 1;
+}
+
+bool GiExecutor::try_pop(size_t index, Task& task) {
+    Queue& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+    pending_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool GiExecutor::try_steal(size_t thief, Task& task) {
+    for (size_t k = 0; k < queues_.size(); ++k) {
+        Queue& queue = *queues_[(thief + 1 + k) % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void GiExecutor::run(const Task& task) {
+    Job* job = task.job;
+    try {
+        (*job->body)(task.begin, task.end);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        if (!job->error) {
+            job->error = std::current_exception();
+        }
+    }
+    // The caller may destroy the job as soon as it sees the last task finish, so the
+    // decrement and notification happen under the job's mutex
+    std::lock_guard<std::mutex> lock(job->mutex);
+    if (job->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        job->done.notify_all();
+    }
+}
+
+void GiExecutor::worker_loop(size_t index) {
+    for (;;) {
+        Task task;
+        if (try_pop(index, task) || try_steal(index, task)) {
+            run(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        wake_.wait(lock, [this] { return stop_ || pending_.load(std::memory_order_relaxed) > 0; });
+        if (stop_ && pending_.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Runs body over [begin, end) split into chunks of at least grain indices.
+ *
+ * The range is cut into a few chunks per thread and spread over the worker deques; idle
+ * threads steal chunks from busy ones. Ranges that fit in a single chunk run inline on
+ * the calling thread. Returns once every chunk has finished.
+ *
+ * @param begin First index of the range.
+ * @param end One past the last index of the range.
+ * @param grain Minimum number of indices per chunk (0 is treated as 1).
+ * @param body Called as body(chunk_begin, chunk_end); chunks never overlap.
+ *
+ * @throws Rethrows the first exception thrown by body, after all chunks have finished.
+ */
+void GiExecutor::parallel_for(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& body) {
+    if (end <= begin) {
+        return;
+    }
+    size_t count = end - begin;
+    size_t per_task = std::max(std::max<size_t>(grain, 1), (count + concurrency() * 4 - 1) / (concurrency() * 4));
+    if (workers_.empty() || count <= per_task) {
+        body(begin, end);
+        return;
+    }
+
+    Job job;
+    job.body = &body;
+    size_t tasks = (count + per_task - 1) / per_task;
+    job.remaining.store(tasks, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        pending_.fetch_add(tasks, std::memory_order_relaxed);
+    }
+    size_t first = next_queue_.fetch_add(1, std::memory_order_relaxed);
+
+    // Help out until the job's chunks are all taken, then wait for the ones still running
+    auto finish = [&] {
+        Task task;
+        while (job.remaining.load(std::memory_order_acquire) > 0 && try_steal(first, task)) {
+            run(task);
+        }
+        std::unique_lock<std::mutex> lock(job.mutex);
+        job.done.wait(lock, [&job] { return job.remaining.load(std::memory_order_acquire) == 0; });
+    };
+
+    size_t queued = 0;
+    try {
+        for (; queued < tasks; ++queued) {
+            size_t chunk_begin = begin + queued * per_task;
+            Queue& queue = *queues_[(first + queued) % queues_.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(Task{&job, chunk_begin, std::min(end, chunk_begin + per_task)});
+        }
+    } catch (...) {
+        // The chunks already queued point at job, so they have to finish before it goes away
+        std::exception_ptr error = std::current_exception();
+        pending_.fetch_sub(tasks - queued, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(job.mutex);
+            job.remaining.fetch_sub(tasks - queued, std::memory_order_acq_rel);
+        }
+        wake_.notify_all();
+        finish();
+        std::rethrow_exception(error);
+    }
+    wake_.notify_all();
+    finish();
+    if (job.error) {
+        std::rethrow_exception(job.error);
+    }
+}
+
+// Example usage:
+// std::vector<std::string> lines = load_lines();
+// std::vector<size_t> widths(lines.size());
+// GiExecutor::shared().parallel_for(0, lines.size(), 64, [&](size_t begin, size_t end) {
+//     for (size_t i = begin; i < end; ++i) {
+//         widths[i] = GiUnicode::display_width(lines[i]);
+//     }
+// });
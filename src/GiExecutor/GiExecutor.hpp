@@ -0,0 +1,72 @@
+#ifndef GIEXECUTOR_HPP
+#define GIEXECUTOR_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Work-stealing thread pool for data-parallel loops.
+ *
+ * Each worker owns a task deque: it pops its own work from the back and, when empty,
+ * steals from the front of the other workers' deques. The thread calling parallel_for
+ * runs tasks too until its loop is done, so nested parallel_for calls cannot deadlock.
+ */
+class GiExecutor
+{
+public:
+    explicit GiExecutor(size_t threads = 0);
+    GiExecutor(const GiExecutor &) = delete;
+    GiExecutor &operator=(const GiExecutor &) = delete;
+    ~GiExecutor();
+
+    static GiExecutor &shared();
+
+    size_t concurrency() const;
+    void parallel_for(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)> &body);
+
+private:
+    struct Job
+    {
+        const std::function<void(size_t, size_t)> *body;
+        std::atomic<size_t> remaining{0};
+        std::mutex mutex;
+        std::condition_variable done;
+        std::exception_ptr error;
+    };
+
+    struct Task
+    {
+        Job *job;
+        size_t begin;
+        size_t end;
+    };
+
+    struct alignas(64) Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void worker_loop(size_t index);
+    bool try_pop(size_t index, Task &task);
+    bool try_steal(size_t thief, Task &task);
+    void run(const Task &task);
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t> pending_{0};
+    std::atomic<size_t> next_queue_{0};
+    bool stop_ = false;
+};
+
+#endif // GIEXECUTOR_HPP
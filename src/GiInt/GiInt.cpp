@@ -1,4 +1,5 @@
 #include "GiInt.hpp"
+#include "../GiRandom/GiRandom.hpp"
 
 
 
@@ -2134,11 +2135,7 @@ int GiInt::generateRandom(int min, int max) {
         throw std::invalid_argument("generateRandom: Minimum value cannot be greater than the maximum value.");
     }
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<int> dis(min, max);
-
-    return dis(gen);
+    return static_cast<int>(GiRandom::local().uniform(min, max));
 }
 
 // Example usage:
@@ -2769,9 +2766,7 @@ int GiInt::shuffleDigits(int number) {
     std::string numStr = std::to_string(number);
 
     // Shuffle the digits randomly
-    std::random_device rd;
-    std::mt19937 g(rd());
-    std::shuffle(numStr.begin(), numStr.end(), g);
+    GiRandom::local().shuffle(numStr.begin(), numStr.end());
 
     // Convert the shuffled string back to an integer
     int shuffledNumber = std::stoi(numStr);
@@ -1,4 +1,5 @@
 #include "GiLogs.hpp"
+#include "../GiUnicode/GiUnicode.hpp"
 #if defined(_WIN32) || defined(_WIN64)
 #include <windows.h>
 #elif defined(__unix__) || defined(__APPLE__)
@@ -91,7 +92,7 @@ void Glogs::Table(std::vector<std::vector<std::string>> rows)
             {
                 colWidths.push_back(0);
             }
-            colWidths[i] = std::max(colWidths[i], static_cast<int>(row[i].length()));
+            colWidths[i] = std::max(colWidths[i], static_cast<int>(GiUnicode::display_width(row[i])));
         }
     }
 
@@ -99,7 +100,8 @@ void Glogs::Table(std::vector<std::vector<std::string>> rows)
     {
         for (size_t i = 0; i < row.size(); ++i)
         {
-            std::cout << std::left << std::setw(colWidths[i] + 2) << row[i];
+            // std::setw pads by bytes, so wide and multi-byte cells are padded by display width
+            std::cout << row[i] << std::string(colWidths[i] + 2 - GiUnicode::display_width(row[i]), ' ');
         }
         std::cout << std::endl;
     }
@@ -0,0 +1,236 @@
+#include "GiRandom.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+
+namespace
+{
+    uint64_t splitmix64(uint64_t &state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // High and low halves of the 128-bit product a * b
+    uint64_t multiply_high(uint64_t a, uint64_t b, uint64_t &low) {
+#if defined(__SIZEOF_INT128__)
+        unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+        low = static_cast<uint64_t>(product);
+        return static_cast<uint64_t>(product >> 64);
+#else
+        uint64_t a_lo = a & 0xFFFFFFFFu, a_hi = a >> 32;
+        uint64_t b_lo = b & 0xFFFFFFFFu, b_hi = b >> 32;
+        uint64_t lo_lo = a_lo * b_lo;
+        uint64_t hi_lo = a_hi * b_lo;
+        uint64_t lo_hi = a_lo * b_hi;
+        uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFu) + lo_hi;
+        low = (cross << 32) | (lo_lo & 0xFFFFFFFFu);
+        return a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+    }
+
+    // Process-wide seeding state; a thread reseeds its engine when the epoch changes
+    struct SeedState
+    {
+        std::mutex mutex;
+        std::atomic<uint64_t> epoch{1};
+        uint64_t base = std::random_device{}() | (static_cast<uint64_t>(std::random_device{}()) << 32);
+        uint64_t streams = 0;
+    };
+
+    SeedState &seed_state() {
+        static SeedState state;
+        return state;
+    }
+
+    struct LocalEngine
+    {
+        GiRandom engine{0};
+        uint64_t epoch = 0;
+    };
+}
+
+/**
+ * @brief Creates an engine seeded from the calling thread's engine, so each instance gets its own stream.
+ */
+GiRandom::GiRandom() : GiRandom(local().next()) {}
+
+/**
+ * @brief Creates an engine with a fixed seed; equal seeds produce equal sequences.
+ *
+ * @param seed Any 64-bit value; it is expanded into the 256-bit state with SplitMix64.
+ */
+GiRandom::GiRandom(uint64_t seed) {
+    for (uint64_t &word : state_) {
+        word = splitmix64(seed);
+    }
+}
+
+/**
+ * @brief Returns a uniformly distributed integer in [0, bound) (Lemire's method).
+ *
+ * @param bound The exclusive upper bound; 0 yields 0.
+ */
+uint64_t GiRandom::bounded(uint64_t bound) {
+    uint64_t low;
+    uint64_t high = multiply_high(next(), bound, low);
+    if (low < bound) {
+        uint64_t threshold = (0 - bound) % bound;
+        while (low < threshold) {
+            high = multiply_high(next(), bound, low);
+        }
+    }
+    return high;
+}
+
+/**
+ * @brief Returns a uniformly distributed integer in [min, max].
+ *
+ * @throws std::invalid_argument If min is greater than max.
+ */
+int64_t GiRandom::uniform(int64_t min, int64_t max) {
+    if (min > max) {
+        throw std::invalid_argument("Minimum value cannot be greater than the maximum value (GiRandom::uniform)");
+    }
+    uint64_t span = static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+    uint64_t offset = span == static_cast<uint64_t>(-1) ? next() : bounded(span + 1);
+    return static_cast<int64_t>(static_cast<uint64_t>(min) + offset);
+}
+
+/**
+ * @brief Returns a uniformly distributed double in [0, 1) with 53 random bits.
+ */
+double GiRandom::real() {
+    return static_cast<double>(next() >> 11) * 0x1.0p-53;
+}
+
+/**
+ * @brief Advances the engine by 2^128 steps, giving a non-overlapping stream.
+ */
+void GiRandom::jump() {
+    static const uint64_t polynomial[] = {0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+                                          0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL};
+    uint64_t jumped[4] = {0, 0, 0, 0};
+    for (uint64_t word : polynomial) {
+        for (int bit = 0; bit < 64; ++bit) {
+            if (word & (uint64_t(1) << bit)) {
+                for (int i = 0; i < 4; ++i) {
+                    jumped[i] ^= state_[i];
+                }
+            }
+            next();
+        }
+    }
+    std::memcpy(state_, jumped, sizeof(state_));
+}
+
+/**
+ * @brief Fills a buffer with random bytes, eight bytes per engine step.
+ *
+ * @param data The buffer to fill.
+ * @param size Number of bytes to write.
+ */
+void GiRandom::fill(void *data, size_t size) {
+    unsigned char *bytes = static_cast<unsigned char *>(data);
+    while (size >= 8) {
+        uint64_t word = next();
+        std::memcpy(bytes, &word, 8);
+        bytes += 8;
+        size -= 8;
+    }
+    if (size > 0) {
+        uint64_t word = next();
+        std::memcpy(bytes, &word, size);
+    }
+}
+
+/**
+ * @brief Fills an array with uniformly distributed integers in [0, bound).
+ *
+ * @param values The array to fill.
+ * @param count Number of values to write.
+ * @param bound The exclusive upper bound.
+ */
+void GiRandom::fill(uint64_t *values, size_t count, uint64_t bound) {
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = bounded(bound);
+    }
+}
+
+/**
+ * @brief Fills a buffer with characters drawn uniformly from charset.
+ *
+ * @param data The buffer to fill.
+ * @param size Number of characters to write.
+ * @param charset The characters to draw from.
+ *
+ * @throws std::invalid_argument If charset is empty.
+ */
+void GiRandom::fill(char *data, size_t size, std::string_view charset) {
+    if (charset.empty()) {
+        throw std::invalid_argument("Character set cannot be empty (GiRandom::fill)");
+    }
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = charset[bounded(charset.size())];
+    }
+}
+
+/**
+ * @brief Returns the calling thread's engine.
+ *
+ * The engine is created on first use from the process seed plus a per-thread stream
+ * number, and is reseeded the same way after seed() or seed_from_device().
+ */
+GiRandom &GiRandom::local() {
+    thread_local LocalEngine local;
+    SeedState &state = seed_state();
+    if (local.epoch != state.epoch.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        uint64_t mix = state.base ^ (0xD1B54A32D192ED03ULL * state.streams++);
+        local.engine = GiRandom(splitmix64(mix));
+        local.epoch = state.epoch.load(std::memory_order_relaxed);
+    }
+    return local.engine;
+}
+
+/**
+ * @brief Seeds every thread's engine from seed for reproducible runs.
+ *
+ * The calling thread's engine is reseeded immediately with the first stream, so a
+ * single-threaded program produces the same results for the same seed; other threads
+ * reseed on their next use with the following streams, in the order they get there.
+ *
+ * @param seed The process seed.
+ */
+void GiRandom::seed(uint64_t seed) {
+    SeedState &state = seed_state();
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.base = seed;
+        state.streams = 0;
+        state.epoch.fetch_add(1, std::memory_order_release);
+    }
+    local();
+}
+
+/**
+ * @brief Reseeds every thread's engine from std::random_device.
+ */
+void GiRandom::seed_from_device() {
+    std::random_device device;
+    seed(device() | (static_cast<uint64_t>(device()) << 32));
+}
+
+// Example usage:
+// GiRandom::seed(42);
+// GiRandom &rng = GiRandom::local();
+// int64_t die = rng.uniform(1, 6);
+// std::string id(8, ' ');
+// rng.fill(&id[0], id.size(), "0123456789abcdef");
+// std::vector<int> deck = {1, 2, 3, 4, 5};
+// rng.shuffle(deck.begin(), deck.end());
+// std::cout << die << " " << id << " " << deck[0] << std::endl;
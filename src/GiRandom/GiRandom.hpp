@@ -0,0 +1,80 @@
+#ifndef GIRANDOM_HPP
+#define GIRANDOM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <utility>
+
+/**
+ * @brief xoshiro256** random engine with per-thread instances for the library's random functions.
+ *
+ * GiRandom satisfies UniformRandomBitGenerator, so it works with <random> distributions
+ * and std::shuffle. Bounded integers use Lemire's multiply-shift method, which is unbiased
+ * and needs no division in the common case. local() returns the calling thread's engine,
+ * seeded once from std::random_device per process; seed() makes runs reproducible.
+ * Not suitable for cryptographic use.
+ */
+class GiRandom
+{
+public:
+    using result_type = uint64_t;
+
+    GiRandom();
+    explicit GiRandom(uint64_t seed);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return static_cast<result_type>(-1); }
+
+    result_type operator()() { return next(); }
+    uint64_t next()
+    {
+        uint64_t result = rotl(state_[1] * 5, 7) * 9;
+        uint64_t t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+        return result;
+    }
+
+    uint64_t bounded(uint64_t bound);
+    int64_t uniform(int64_t min, int64_t max);
+    double real();
+    bool coin() { return next() >> 63; }
+    void jump();
+
+    void fill(void *data, size_t size);
+    void fill(uint64_t *values, size_t count, uint64_t bound);
+    void fill(char *data, size_t size, std::string_view charset);
+
+    template <typename RandomIt>
+    void shuffle(RandomIt first, RandomIt last);
+
+    static GiRandom &local();
+    static void seed(uint64_t seed);
+    static void seed_from_device();
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    uint64_t state_[4];
+};
+
+/**
+ * @brief Fisher-Yates shuffle of [first, last) using unbiased bounded draws.
+ */
+template <typename RandomIt>
+void GiRandom::shuffle(RandomIt first, RandomIt last)
+{
+    auto size = last - first;
+    for (decltype(size) i = size - 1; i > 0; --i) {
+        using std::swap;
+        swap(first[i], first[static_cast<decltype(size)>(bounded(static_cast<uint64_t>(i) + 1))]);
+    }
+}
+
+#endif // GIRANDOM_HPP
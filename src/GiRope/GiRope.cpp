@@ -0,0 +1,486 @@
+#include "GiRope.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * @brief Rope node; leaves hold up to max_leaf bytes of text, inner nodes hold two children.
+ *
+ * The tree is kept AVL-balanced by join(), which every edit is built on: insert, erase and
+ * slicing are splits followed by joins.
+ */
+struct GiRope::Node
+{
+    static const size_t max_leaf = 1024;
+
+    NodePtr left;
+    NodePtr right;
+    std::string text;
+    size_t length = 0;
+    size_t newlines = 0;
+    int height = 1;
+
+    bool is_leaf() const { return !left; }
+
+    static int height_of(const NodePtr &node) { return node ? node->height : 0; }
+    static size_t length_of(const NodePtr &node) { return node ? node->length : 0; }
+
+    static NodePtr leaf(std::string_view text)
+    {
+        auto node = std::make_shared<Node>();
+        node->text.assign(text.data(), text.size());
+        node->length = text.size();
+        node->newlines = static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+        return node;
+    }
+
+    static NodePtr inner(const NodePtr &left, const NodePtr &right)
+    {
+        auto node = std::make_shared<Node>();
+        node->left = left;
+        node->right = right;
+        node->length = left->length + right->length;
+        node->newlines = left->newlines + right->newlines;
+        node->height = 1 + std::max(left->height, right->height);
+        return node;
+    }
+
+    // Joins two subtrees of similar height, merging neighbouring small leaves
+    static NodePtr pair(const NodePtr &left, const NodePtr &right)
+    {
+        if (left->is_leaf() && right->is_leaf() && left->length + right->length <= max_leaf) {
+            std::string text;
+            text.reserve(left->length + right->length);
+            text.append(left->text).append(right->text);
+            return leaf(text);
+        }
+        return inner(left, right);
+    }
+
+    static NodePtr rotate_left(const NodePtr &node)
+    {
+        return inner(inner(node->left, node->right->left), node->right->right);
+    }
+
+    static NodePtr rotate_right(const NodePtr &node)
+    {
+        return inner(node->left->left, inner(node->left->right, node->right));
+    }
+
+    // left is at least two levels taller than right
+    static NodePtr join_right(const NodePtr &left, const NodePtr &right)
+    {
+        const NodePtr &outer = left->left;
+        const NodePtr &inner_child = left->right;
+        if (inner_child->height <= right->height + 1) {
+            NodePtr merged = pair(inner_child, right);
+            if (merged->height <= outer->height + 1) {
+                return inner(outer, merged);
+            }
+            return rotate_left(inner(outer, rotate_right(merged)));
+        }
+        NodePtr merged = join_right(inner_child, right);
+        NodePtr node = inner(outer, merged);
+        if (merged->height <= outer->height + 1) {
+            return node;
+        }
+        return rotate_left(node);
+    }
+
+    // right is at least two levels taller than left
+    static NodePtr join_left(const NodePtr &left, const NodePtr &right)
+    {
+        const NodePtr &outer = right->right;
+        const NodePtr &inner_child = right->left;
+        if (inner_child->height <= left->height + 1) {
+            NodePtr merged = pair(left, inner_child);
+            if (merged->height <= outer->height + 1) {
+                return inner(merged, outer);
+            }
+            return rotate_right(inner(rotate_left(merged), outer));
+        }
+        NodePtr merged = join_left(left, inner_child);
+        NodePtr node = inner(merged, outer);
+        if (merged->height <= outer->height + 1) {
+            return node;
+        }
+        return rotate_right(node);
+    }
+
+    static NodePtr join(const NodePtr &left, const NodePtr &right)
+    {
+        if (!left || left->length == 0) {
+            return right;
+        }
+        if (!right || right->length == 0) {
+            return left;
+        }
+        if (left->height > right->height + 1) {
+            return join_right(left, right);
+        }
+        if (right->height > left->height + 1) {
+            return join_left(left, right);
+        }
+        return pair(left, right);
+    }
+
+    static std::pair<NodePtr, NodePtr> split(const NodePtr &node, size_t pos)
+    {
+        if (!node || pos == 0) {
+            return {nullptr, node};
+        }
+        if (pos >= node->length) {
+            return {node, nullptr};
+        }
+        if (node->is_leaf()) {
+            std::string_view text(node->text);
+            return {leaf(text.substr(0, pos)), leaf(text.substr(pos))};
+        }
+        size_t left_length = node->left->length;
+        if (pos < left_length) {
+            auto parts = split(node->left, pos);
+            return {parts.first, join(parts.second, node->right)};
+        }
+        if (pos == left_length) {
+            return {node->left, node->right};
+        }
+        auto parts = split(node->right, pos - left_length);
+        return {join(node->left, parts.first), parts.second};
+    }
+
+    // Builds a balanced tree over the text in O(n)
+    static NodePtr build(std::string_view text)
+    {
+        if (text.empty()) {
+            return nullptr;
+        }
+        if (text.size() <= max_leaf) {
+            return leaf(text);
+        }
+        size_t leaves = (text.size() + max_leaf - 1) / max_leaf;
+        size_t middle = (leaves / 2) * max_leaf;
+        return inner(build(text.substr(0, middle)), build(text.substr(middle)));
+    }
+
+    static void visit(const NodePtr &node, const std::function<void(std::string_view)> &callback)
+    {
+        if (!node) {
+            return;
+        }
+        if (node->is_leaf()) {
+            callback(node->text);
+            return;
+        }
+        visit(node->left, callback);
+        visit(node->right, callback);
+    }
+};
+
+GiRope::GiRope(NodePtr root) : root_(std::move(root)) {}
+
+/**
+ * @brief Creates a rope holding a copy of the given text.
+ *
+ * @param text The initial contents.
+ */
+GiRope::GiRope(std::string_view text) : root_(Node::build(text)) {}
+
+GiRope::GiRope(const std::string &text) : GiRope(std::string_view(text)) {}
+
+GiRope::GiRope(const char *text) : GiRope(std::string_view(text ? text : "")) {}
+
+// Example usage:
+// GiRope document("int main() {\n}\n");
+// document.insert(13, "    return 0;\n");
+// std::cout << document.str();
+
+/**
+ * @brief Returns the number of bytes in the rope.
+ */
+size_t GiRope::size() const {
+    return Node::length_of(root_);
+}
+
+/**
+ * @brief Returns the number of bytes in the rope.
+ */
+size_t GiRope::length() const {
+    return size();
+}
+
+/**
+ * @brief Checks whether the rope is empty.
+ */
+bool GiRope::empty() const {
+    return size() == 0;
+}
+
+/**
+ * @brief Returns the number of '\n' characters in the rope (cached, O(1)).
+ */
+size_t GiRope::newline_count() const {
+    return root_ ? root_->newlines : 0;
+}
+
+/**
+ * @brief Returns the number of lines as std::getline would produce them.
+ *
+ * A final line without a terminating newline counts as a line; an empty rope has none.
+ */
+size_t GiRope::line_count() const {
+    if (empty()) {
+        return 0;
+    }
+    return newline_count() + (at(size() - 1) == '\n' ? 0 : 1);
+}
+
+/**
+ * @brief Returns the byte offset at which the given zero-based line starts.
+ *
+ * @param line The line number.
+ * @return The offset of the first byte of the line.
+ *
+ * @throws std::out_of_range If the rope has fewer than line + 1 line starts.
+ */
+size_t GiRope::line_offset(size_t line) const {
+    if (line == 0) {
+        return 0;
+    }
+    if (line > newline_count()) {
+        throw std::out_of_range("Line number is out of range (GiRope::line_offset)");
+    }
+
+    // Find the position just past the line-th newline
+    size_t offset = 0;
+    size_t remaining = line;
+    const Node *node = root_.get();
+    while (!node->is_leaf()) {
+        if (remaining <= node->left->newlines) {
+            node = node->left.get();
+        } else {
+            remaining -= node->left->newlines;
+            offset += node->left->length;
+            node = node->right.get();
+        }
+    }
+    size_t pos = 0;
+    while (true) {
+        pos = node->text.find('\n', pos) + 1;
+        if (--remaining == 0) {
+            return offset + pos;
+        }
+    }
+}
+
+/**
+ * @brief Returns the byte at the given index.
+ *
+ * @throws std::out_of_range If the index is out of range.
+ */
+char GiRope::at(size_t index) const {
+    if (index >= size()) {
+        throw std::out_of_range("Index is out of range (GiRope::at)");
+    }
+    return (*this)[index];
+}
+
+/**
+ * @brief Returns the byte at the given index without bounds checking.
+ */
+char GiRope::operator[](size_t index) const {
+    const Node *node = root_.get();
+    while (!node->is_leaf()) {
+        if (index < node->left->length) {
+            node = node->left.get();
+        } else {
+            index -= node->left->length;
+            node = node->right.get();
+        }
+    }
+    return node->text[index];
+}
+
+/**
+ * @brief Inserts text at the given position in O(log n + text size).
+ *
+ * @param pos The byte offset to insert at.
+ * @param text The text to insert.
+ * @return A reference to this rope.
+ *
+ * @throws std::out_of_range If pos is greater than the size.
+ */
+GiRope &GiRope::insert(size_t pos, std::string_view text) {
+    return insert(pos, GiRope(text));
+}
+
+/**
+ * @brief Inserts another rope at the given position in O(log n); the chunks are shared.
+ *
+ * @throws std::out_of_range If pos is greater than the size.
+ */
+GiRope &GiRope::insert(size_t pos, const GiRope &other) {
+    if (pos > size()) {
+        throw std::out_of_range("Position is out of range (GiRope::insert)");
+    }
+    auto parts = Node::split(root_, pos);
+    root_ = Node::join(Node::join(parts.first, other.root_), parts.second);
+    return *this;
+}
+
+/**
+ * @brief Removes up to count bytes starting at pos in O(log n).
+ *
+ * @throws std::out_of_range If pos is greater than the size.
+ */
+GiRope &GiRope::erase(size_t pos, size_t count) {
+    if (pos > size()) {
+        throw std::out_of_range("Position is out of range (GiRope::erase)");
+    }
+    count = std::min(count, size() - pos);
+    auto head = Node::split(root_, pos);
+    auto tail = Node::split(head.second, count);
+    root_ = Node::join(head.first, tail.second);
+    return *this;
+}
+
+/**
+ * @brief Appends text to the end of the rope.
+ */
+GiRope &GiRope::append(std::string_view text) {
+    root_ = Node::join(root_, Node::build(text));
+    return *this;
+}
+
+/**
+ * @brief Appends another rope in O(log n); the chunks are shared.
+ */
+GiRope &GiRope::append(const GiRope &other) {
+    root_ = Node::join(root_, other.root_);
+    return *this;
+}
+
+GiRope &GiRope::operator+=(std::string_view text) {
+    return append(text);
+}
+
+GiRope &GiRope::operator+=(const GiRope &other) {
+    return append(other);
+}
+
+/**
+ * @brief Returns the rope [pos, pos + count) in O(log n), sharing chunks with this rope.
+ *
+ * @throws std::out_of_range If pos is greater than the size.
+ */
+GiRope GiRope::substr(size_t pos, size_t count) const {
+    if (pos > size()) {
+        throw std::out_of_range("Position is out of range (GiRope::substr)");
+    }
+    count = std::min(count, size() - pos);
+    auto tail = Node::split(root_, pos).second;
+    return GiRope(Node::split(tail, count).first);
+}
+
+/**
+ * @brief Finds the first occurrence of needle at or after pos without flattening the rope.
+ *
+ * @return The offset of the match, or GiRope::npos.
+ */
+size_t GiRope::find(std::string_view needle, size_t pos) const {
+    if (pos > size()) {
+        return npos;
+    }
+    if (needle.empty()) {
+        return pos;
+    }
+
+    // Search each chunk together with the tail of the previous ones, so matches
+    // spanning chunk boundaries are found
+    std::string window;
+    size_t window_start = pos;
+    size_t found = npos;
+    GiRope rest = substr(pos);
+    Node::visit(rest.root_, [&](std::string_view chunk) {
+        if (found != npos) {
+            return;
+        }
+        window.append(chunk.data(), chunk.size());
+        size_t hit = window.find(needle);
+        if (hit != std::string::npos) {
+            found = window_start + hit;
+            return;
+        }
+        if (window.size() >= needle.size()) {
+            size_t keep = needle.size() - 1;
+            window_start += window.size() - keep;
+            window.erase(0, window.size() - keep);
+        }
+    });
+    return found;
+}
+
+/**
+ * @brief Concatenates two ropes in O(log n).
+ */
+GiRope GiRope::concat(const GiRope &left, const GiRope &right) {
+    return GiRope(Node::join(left.root_, right.root_));
+}
+
+GiRope operator+(const GiRope &left, const GiRope &right) {
+    return GiRope::concat(left, right);
+}
+
+/**
+ * @brief Flattens the rope into a contiguous string.
+ */
+std::string GiRope::str() const {
+    std::string output;
+    flatten(output);
+    return output;
+}
+
+/**
+ * @brief Appends the rope's contents to output, reusing its capacity.
+ */
+void GiRope::flatten(std::string &output) const {
+    output.reserve(output.size() + size());
+    Node::visit(root_, [&](std::string_view chunk) { output.append(chunk.data(), chunk.size()); });
+}
+
+GiRope::operator std::string() const {
+    return str();
+}
+
+/**
+ * @brief Calls visit for each chunk in order, without flattening.
+ */
+void GiRope::for_each_chunk(const std::function<void(std::string_view)> &visit) const {
+    Node::visit(root_, visit);
+}
+
+bool operator==(const GiRope &rope, std::string_view text) {
+    if (rope.size() != text.size()) {
+        return false;
+    }
+    size_t offset = 0;
+    bool equal = true;
+    rope.for_each_chunk([&](std::string_view chunk) {
+        equal = equal && text.compare(offset, chunk.size(), chunk) == 0;
+        offset += chunk.size();
+    });
+    return equal;
+}
+
+bool operator!=(const GiRope &rope, std::string_view text) {
+    return !(rope == text);
+}
+
+// Example usage:
+// GiRope log;
+// for (int i = 0; i < 1000; ++i) {
+//     log.insert(0, "line " + std::to_string(i) + "\n");
+// }
+// GiRope first_ten = log.substr(0, log.line_offset(10));
+// std::cout << first_ten.line_count() << " lines, " << log.size() << " bytes total" << std::endl;
+// Output: "10 lines, 8890 bytes total"
@@ -0,0 +1,68 @@
+#ifndef GIROPE_HPP
+#define GIROPE_HPP
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <functional>
+#include <cstddef>
+
+/**
+ * @brief Rope: a height-balanced tree of immutable text chunks.
+ *
+ * Every node caches the length and newline count of its subtree, so insert, erase, concat,
+ * slicing, indexing and line lookup are O(log n). Nodes are shared and never modified, so
+ * copying a rope or taking a slice is cheap and earlier versions stay valid after edits.
+ * The rope converts to std::string on demand, so it can be passed to any function taking
+ * a const std::string&.
+ */
+class GiRope
+{
+public:
+    static const size_t npos = static_cast<size_t>(-1);
+
+    GiRope() = default;
+    explicit GiRope(std::string_view text);
+    explicit GiRope(const std::string &text);
+    explicit GiRope(const char *text);
+
+    size_t size() const;
+    size_t length() const;
+    bool empty() const;
+    size_t newline_count() const;
+    size_t line_count() const;
+    size_t line_offset(size_t line) const;
+    char at(size_t index) const;
+    char operator[](size_t index) const;
+
+    GiRope &insert(size_t pos, std::string_view text);
+    GiRope &insert(size_t pos, const GiRope &other);
+    GiRope &erase(size_t pos, size_t count = npos);
+    GiRope &append(std::string_view text);
+    GiRope &append(const GiRope &other);
+    GiRope &operator+=(std::string_view text);
+    GiRope &operator+=(const GiRope &other);
+    GiRope substr(size_t pos, size_t count = npos) const;
+    size_t find(std::string_view needle, size_t pos = 0) const;
+
+    static GiRope concat(const GiRope &left, const GiRope &right);
+
+    std::string str() const;
+    void flatten(std::string &output) const;
+    operator std::string() const;
+    void for_each_chunk(const std::function<void(std::string_view)> &visit) const;
+
+    friend GiRope operator+(const GiRope &left, const GiRope &right);
+    friend bool operator==(const GiRope &rope, std::string_view text);
+    friend bool operator!=(const GiRope &rope, std::string_view text);
+
+private:
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    explicit GiRope(NodePtr root);
+
+    NodePtr root_;
+};
+
+#endif // GIROPE_HPP
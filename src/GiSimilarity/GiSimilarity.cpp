@@ -0,0 +1,611 @@
+#include "GiSimilarity.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace
+{
+    // Largest string, in q-grams, compared without building a Profile
+    const size_t stack_grams = 64;
+
+    inline size_t count_trailing_zeros(uint64_t mask) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, mask);
+        return index;
+#else
+        return static_cast<size_t>(__builtin_ctzll(mask));
+#endif
+    }
+
+    // Mask of the bits below bit n
+    inline uint64_t low_bits(size_t n) {
+        return n >= 64 ? ~0ULL : (1ULL << n) - 1;
+    }
+
+    void check_q(size_t q, const char *function) {
+        if (q == 0) {
+            throw std::invalid_argument(std::string("q must be positive (") + function + ")");
+        }
+    }
+
+    size_t gram_count(size_t size, size_t q) {
+        if (size == 0) {
+            return 0;
+        }
+        return size < q ? 1 : size - q + 1;
+    }
+
+    // Grams of up to 7 bytes are packed with their length, so equal keys mean equal grams;
+    // longer ones are hashed with FNV-1a
+    uint64_t gram_key(const char *data, size_t size) {
+        if (size <= 7) {
+            uint64_t key = static_cast<uint64_t>(size) << 56;
+            for (size_t i = 0; i < size; ++i) {
+                key |= static_cast<uint64_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+            }
+            return key;
+        }
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 0x100000001b3ULL;
+        }
+        return hash;
+    }
+
+    // Writes the keys of the q-grams of text to keys, which has room for gram_count() of them
+    void gram_keys(std::string_view text, size_t q, uint64_t *keys) {
+        if (text.size() < q) {
+            if (!text.empty()) {
+                keys[0] = gram_key(text.data(), text.size());
+            }
+            return;
+        }
+        for (size_t i = 0; i + q <= text.size(); ++i) {
+            keys[i] = gram_key(text.data() + i, q);
+        }
+    }
+
+    // Sums over the grams two strings share, and over each string alone
+    struct GramOverlap
+    {
+        double shared = 0.0; // sum of min(count in a, count in b)
+        double dot = 0.0;    // sum of count in a * count in b
+    };
+
+    double qgram_score(GiSimilarity::Metric metric, const GramOverlap &overlap, size_t total_a, size_t total_b, double norm_a, double norm_b) {
+        if (total_a == 0 || total_b == 0) {
+            return total_a == total_b ? 1.0 : 0.0;
+        }
+        switch (metric) {
+        case GiSimilarity::Metric::jaccard:
+            return overlap.shared / (static_cast<double>(total_a + total_b) - overlap.shared);
+        case GiSimilarity::Metric::dice:
+            return 2.0 * overlap.shared / static_cast<double>(total_a + total_b);
+        case GiSimilarity::Metric::cosine:
+            return std::min(1.0, overlap.dot / (norm_a * norm_b));
+        }
+        return 0.0;
+    }
+
+    // qgram_similarity for strings of at most stack_grams grams: keys are sorted on the
+    // stack and merged run by run
+    double small_qgram_similarity(std::string_view a, std::string_view b, size_t q, GiSimilarity::Metric metric) {
+        uint64_t keys_a[stack_grams];
+        uint64_t keys_b[stack_grams];
+        size_t count_a = gram_count(a.size(), q);
+        size_t count_b = gram_count(b.size(), q);
+        gram_keys(a, q, keys_a);
+        gram_keys(b, q, keys_b);
+        std::sort(keys_a, keys_a + count_a);
+        std::sort(keys_b, keys_b + count_b);
+
+        GramOverlap overlap;
+        double square_a = 0.0;
+        double square_b = 0.0;
+        size_t i = 0;
+        size_t j = 0;
+        while (i < count_a || j < count_b) {
+            uint64_t key = j == count_b || (i < count_a && keys_a[i] < keys_b[j]) ? keys_a[i] : keys_b[j];
+            size_t run_a = 0;
+            size_t run_b = 0;
+            for (; i < count_a && keys_a[i] == key; ++i) {
+                ++run_a;
+            }
+            for (; j < count_b && keys_b[j] == key; ++j) {
+                ++run_b;
+            }
+            overlap.shared += static_cast<double>(std::min(run_a, run_b));
+            overlap.dot += static_cast<double>(run_a * run_b);
+            square_a += static_cast<double>(run_a * run_a);
+            square_b += static_cast<double>(run_b * run_b);
+        }
+        return qgram_score(metric, overlap, count_a, count_b, std::sqrt(square_a), std::sqrt(square_b));
+    }
+
+    // Myers' bit-parallel edit distance for a pattern of 1 to 64 bytes
+    size_t levenshtein_word(std::string_view pattern, std::string_view text) {
+        uint64_t peq[256] = {};
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            peq[static_cast<unsigned char>(pattern[i])] |= 1ULL << i;
+        }
+        uint64_t pv = ~0ULL;
+        uint64_t mv = 0;
+        uint64_t last = 1ULL << (pattern.size() - 1);
+        size_t score = pattern.size();
+        for (char c : text) {
+            uint64_t eq = peq[static_cast<unsigned char>(c)];
+            uint64_t xv = eq | mv;
+            uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+            uint64_t ph = mv | ~(xh | pv);
+            uint64_t mh = pv & xh;
+            if (ph & last) {
+                ++score;
+            } else if (mh & last) {
+                --score;
+            }
+            ph = (ph << 1) | 1;
+            mh <<= 1;
+            pv = mh | ~(xv | ph);
+            mv = ph & xv;
+        }
+        return score;
+    }
+
+    // The same recurrence over 64-bit blocks, carrying the addition and the horizontal
+    // deltas from each block into the next
+    size_t levenshtein_blocks(std::string_view pattern, std::string_view text) {
+        size_t words = (pattern.size() + 63) / 64;
+        std::vector<uint64_t> peq(256 * words);
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            peq[static_cast<unsigned char>(pattern[i]) * words + i / 64] |= 1ULL << (i % 64);
+        }
+        std::vector<uint64_t> pv(words, ~0ULL);
+        std::vector<uint64_t> mv(words, 0);
+        uint64_t last = 1ULL << ((pattern.size() - 1) % 64);
+        size_t score = pattern.size();
+        for (char c : text) {
+            const uint64_t *eqs = &peq[static_cast<unsigned char>(c) * words];
+            uint64_t ph_in = 1;
+            uint64_t mh_in = 0;
+            uint64_t carry = 0;
+            for (size_t w = 0; w < words; ++w) {
+                uint64_t eq = eqs[w];
+                uint64_t xv = eq | mv[w];
+                uint64_t x = eq & pv[w];
+                uint64_t sum = x + pv[w];
+                uint64_t total = sum + carry;
+                carry = (sum < x) | (total < sum);
+                uint64_t xh = (total ^ pv[w]) | eq;
+                uint64_t ph = mv[w] | ~(xh | pv[w]);
+                uint64_t mh = pv[w] & xh;
+                if (w == words - 1) {
+                    if (ph & last) {
+                        ++score;
+                    } else if (mh & last) {
+                        --score;
+                    }
+                }
+                uint64_t ph_out = ph >> 63;
+                uint64_t mh_out = mh >> 63;
+                ph = (ph << 1) | ph_in;
+                mh = (mh << 1) | mh_in;
+                ph_in = ph_out;
+                mh_in = mh_out;
+                pv[w] = mh | ~(xv | ph);
+                mv[w] = ph & xv;
+            }
+        }
+        return score;
+    }
+}
+
+/**
+ * @brief Calculates the Jaro similarity of two strings.
+ *
+ * Bytes match when equal and at most max(|a|, |b|) / 2 - 1 positions apart; the score
+ * averages the matched share of each string and the share of matches in the same order.
+ * When both strings have at most 64 bytes, matching runs on bit masks without allocating.
+ *
+ * @param a The first string.
+ * @param b The second string.
+ * @return The similarity in [0, 1]; two empty strings score 1.
+ */
+double GiSimilarity::jaro(std::string_view a, std::string_view b) {
+    if (a.empty() || b.empty()) {
+        return a.empty() && b.empty() ? 1.0 : 0.0;
+    }
+    size_t window = std::max(a.size(), b.size()) / 2;
+    window = window > 0 ? window - 1 : 0;
+    size_t matches = 0;
+    size_t transpositions = 0;
+
+    if (a.size() <= 64 && b.size() <= 64) {
+        uint64_t positions[256] = {};
+        for (size_t j = 0; j < b.size(); ++j) {
+            positions[static_cast<unsigned char>(b[j])] |= 1ULL << j;
+        }
+        uint64_t a_matched = 0;
+        uint64_t b_matched = 0;
+        for (size_t i = 0; i < a.size(); ++i) {
+            size_t lo = i > window ? i - window : 0;
+            size_t hi = std::min(b.size(), i + window + 1);
+            if (lo >= hi) {
+                break;
+            }
+            uint64_t candidates = positions[static_cast<unsigned char>(a[i])] & low_bits(hi) & ~low_bits(lo) & ~b_matched;
+            if (candidates) {
+                b_matched |= candidates & (~candidates + 1);
+                a_matched |= 1ULL << i;
+                ++matches;
+            }
+        }
+        if (matches == 0) {
+            return 0.0;
+        }
+        while (a_matched) {
+            if (a[count_trailing_zeros(a_matched)] != b[count_trailing_zeros(b_matched)]) {
+                ++transpositions;
+            }
+            a_matched &= a_matched - 1;
+            b_matched &= b_matched - 1;
+        }
+    } else {
+        std::vector<char> a_matched(a.size());
+        std::vector<char> b_matched(b.size());
+        for (size_t i = 0; i < a.size(); ++i) {
+            size_t lo = i > window ? i - window : 0;
+            size_t hi = std::min(b.size(), i + window + 1);
+            for (size_t j = lo; j < hi; ++j) {
+                if (!b_matched[j] && a[i] == b[j]) {
+                    a_matched[i] = b_matched[j] = 1;
+                    ++matches;
+                    break;
+                }
+            }
+        }
+        if (matches == 0) {
+            return 0.0;
+        }
+        size_t j = 0;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a_matched[i]) {
+                while (!b_matched[j]) {
+                    ++j;
+                }
+                if (a[i] != b[j]) {
+                    ++transpositions;
+                }
+                ++j;
+            }
+        }
+    }
+
+    double m = static_cast<double>(matches);
+    return (m / a.size() + m / b.size() + (m - static_cast<double>(transpositions / 2)) / m) / 3.0;
+}
+
+/**
+ * @brief Calculates the Jaro-Winkler similarity, which favours strings with a common prefix.
+ *
+ * Scores above 0.7 are raised by prefix_scale for each of up to 4 leading bytes the strings
+ * share, as in Winkler's original definition.
+ *
+ * @param a The first string.
+ * @param b The second string.
+ * @param prefix_scale Weight of each common prefix byte, at most 0.25.
+ * @return The similarity in [0, 1].
+ *
+ * @throws std::invalid_argument If prefix_scale is outside [0, 0.25].
+ */
+double GiSimilarity::jaro_winkler(std::string_view a, std::string_view b, double prefix_scale) {
+    if (!(prefix_scale >= 0.0 && prefix_scale <= 0.25)) {
+        throw std::invalid_argument("prefix_scale must be in [0, 0.25] (GiSimilarity::jaro_winkler)");
+    }
+    double similarity = jaro(a, b);
+    if (similarity > 0.7) {
+        size_t limit = std::min<size_t>(4, std::min(a.size(), b.size()));
+        size_t prefix = 0;
+        while (prefix < limit && a[prefix] == b[prefix]) {
+            ++prefix;
+        }
+        similarity += static_cast<double>(prefix) * prefix_scale * (1.0 - similarity);
+    }
+    return similarity;
+}
+
+// Example usage:
+// std::cout << GiSimilarity::jaro("MARTHA", "MARHTA") << " " << GiSimilarity::jaro_winkler("MARTHA", "MARHTA") << std::endl;
+// Output: "0.944444 0.961111"
+
+/**
+ * @brief Calculates the Levenshtein (edit) distance between two strings.
+ *
+ * Uses Myers' bit-parallel algorithm after stripping the common prefix and suffix: one
+ * 64-bit word per text byte when the shorter string has at most 64 bytes (no allocation),
+ * otherwise one word per 64 bytes of it.
+ *
+ * @param a The first string.
+ * @param b The second string.
+ * @return The minimum number of single-byte insertions, deletions and substitutions.
+ */
+size_t GiSimilarity::levenshtein(std::string_view a, std::string_view b) {
+    while (!a.empty() && !b.empty() && a.front() == b.front()) {
+        a.remove_prefix(1);
+        b.remove_prefix(1);
+    }
+    while (!a.empty() && !b.empty() && a.back() == b.back()) {
+        a.remove_suffix(1);
+        b.remove_suffix(1);
+    }
+    if (a.size() > b.size()) {
+        std::swap(a, b);
+    }
+    if (a.empty()) {
+        return b.size();
+    }
+    return a.size() <= 64 ? levenshtein_word(a, b) : levenshtein_blocks(a, b);
+}
+
+/**
+ * @brief Calculates 1 - levenshtein(a, b) / max(|a|, |b|).
+ *
+ * @return The similarity in [0, 1]; two empty strings score 1.
+ */
+double GiSimilarity::normalized_levenshtein(std::string_view a, std::string_view b) {
+    size_t longest = std::max(a.size(), b.size());
+    if (longest == 0) {
+        return 1.0;
+    }
+    return 1.0 - static_cast<double>(levenshtein(a, b)) / static_cast<double>(longest);
+}
+
+// Example usage:
+// std::cout << GiSimilarity::levenshtein("kitten", "sitting") << " "
+//           << GiSimilarity::normalized_levenshtein("kitten", "sitting") << std::endl;
+// Output: "3 0.571429"
+
+/**
+ * @brief Calculates the Jaccard index of the sets of distinct bytes of two strings.
+ *
+ * Each set is a 256-bit bitset, so the cost is one pass over each string.
+ *
+ * @return The similarity in [0, 1]; two empty strings score 1.
+ */
+double GiSimilarity::char_jaccard(std::string_view a, std::string_view b) {
+    std::bitset<256> set_a;
+    std::bitset<256> set_b;
+    for (char c : a) {
+        set_a.set(static_cast<unsigned char>(c));
+    }
+    for (char c : b) {
+        set_b.set(static_cast<unsigned char>(c));
+    }
+    size_t union_size = (set_a | set_b).count();
+    if (union_size == 0) {
+        return 1.0;
+    }
+    return static_cast<double>((set_a & set_b).count()) / static_cast<double>(union_size);
+}
+
+/**
+ * @brief Compares the q-gram multisets of two strings.
+ *
+ * Strings of at most 64 grams are compared on the stack without allocating; longer ones
+ * go through Profile. To compare one string with many, build its Profile once, or put the
+ * many into a ProfileTable.
+ *
+ * @param a The first string.
+ * @param b The second string.
+ * @param q The gram length in bytes.
+ * @param metric How shared grams are turned into a score.
+ * @return The similarity in [0, 1]; two empty strings score 1.
+ *
+ * @throws std::invalid_argument If q is 0.
+ */
+double GiSimilarity::qgram_similarity(std::string_view a, std::string_view b, size_t q, Metric metric) {
+    check_q(q, "GiSimilarity::qgram_similarity");
+    if (gram_count(a.size(), q) <= stack_grams && gram_count(b.size(), q) <= stack_grams) {
+        return small_qgram_similarity(a, b, q, metric);
+    }
+    return Profile(a, q).similarity(Profile(b, q), metric);
+}
+
+double GiSimilarity::jaccard(std::string_view a, std::string_view b, size_t q) {
+    return qgram_similarity(a, b, q, Metric::jaccard);
+}
+
+double GiSimilarity::dice(std::string_view a, std::string_view b, size_t q) {
+    return qgram_similarity(a, b, q, Metric::dice);
+}
+
+double GiSimilarity::cosine(std::string_view a, std::string_view b, size_t q) {
+    return qgram_similarity(a, b, q, Metric::cosine);
+}
+
+// Example usage:
+// std::cout << GiSimilarity::jaccard("night", "nacht") << " " << GiSimilarity::dice("night", "nacht") << std::endl;
+// Output: "0.142857 0.25"
+
+/**
+ * @brief Builds the q-gram profile of text.
+ *
+ * @param text The string to profile.
+ * @param q The gram length in bytes.
+ *
+ * @throws std::invalid_argument If q is 0.
+ */
+GiSimilarity::Profile::Profile(std::string_view text, size_t q) : q_(q) {
+    check_q(q, "GiSimilarity::Profile");
+    std::vector<uint64_t> keys(gram_count(text.size(), q));
+    gram_keys(text, q, keys.data());
+    std::sort(keys.begin(), keys.end());
+
+    double squares = 0.0;
+    for (size_t i = 0; i < keys.size();) {
+        size_t run = 1;
+        while (i + run < keys.size() && keys[i + run] == keys[i]) {
+            ++run;
+        }
+        grams_.emplace_back(keys[i], static_cast<uint32_t>(run));
+        squares += static_cast<double>(run) * static_cast<double>(run);
+        i += run;
+    }
+    total_ = keys.size();
+    norm_ = std::sqrt(squares);
+}
+
+/**
+ * @brief Compares two profiles in one merge over their sorted grams.
+ *
+ * @throws std::invalid_argument If the profiles were built with different q.
+ */
+double GiSimilarity::Profile::similarity(const Profile &other, Metric metric) const {
+    if (q_ != other.q_) {
+        throw std::invalid_argument("Profiles use different q (GiSimilarity::Profile::similarity)");
+    }
+    GramOverlap overlap;
+    auto a = grams_.begin();
+    auto b = other.grams_.begin();
+    while (a != grams_.end() && b != other.grams_.end()) {
+        if (a->first < b->first) {
+            ++a;
+        } else if (b->first < a->first) {
+            ++b;
+        } else {
+            overlap.shared += std::min(a->second, b->second);
+            overlap.dot += static_cast<double>(a->second) * b->second;
+            ++a;
+            ++b;
+        }
+    }
+    return qgram_score(metric, overlap, total_, other.total_, norm_, other.norm_);
+}
+
+// Example usage:
+// GiSimilarity::Profile query("jonathan smith", 3);
+// for (const std::string& name : names) {
+//     if (query.cosine(GiSimilarity::Profile(name, 3)) > 0.8) {
+//         std::cout << name << std::endl;
+//     }
+// }
+
+/**
+ * @brief Creates an empty table of q-gram profiles.
+ *
+ * @throws std::invalid_argument If q is 0.
+ */
+GiSimilarity::ProfileTable::ProfileTable(size_t q) : q_(q) {
+    check_q(q, "GiSimilarity::ProfileTable");
+}
+
+/**
+ * @brief Creates a table holding the profile of every string; entry i is strings[i].
+ */
+GiSimilarity::ProfileTable::ProfileTable(const std::vector<std::string> &strings, size_t q) : ProfileTable(q) {
+    totals_.reserve(strings.size());
+    norms_.reserve(strings.size());
+    for (const std::string &str : strings) {
+        add(str);
+    }
+}
+
+/**
+ * @brief Adds the profile of text to the table.
+ *
+ * @return The index of the new entry.
+ *
+ * @throws std::length_error If the table already holds 2^32 entries.
+ */
+size_t GiSimilarity::ProfileTable::add(std::string_view text) {
+    if (totals_.size() > UINT32_MAX) {
+        throw std::length_error("Too many entries (GiSimilarity::ProfileTable::add)");
+    }
+    Profile profile(text, q_);
+    uint32_t index = static_cast<uint32_t>(totals_.size());
+    for (const std::pair<uint64_t, uint32_t> &gram : profile.grams()) {
+        postings_[gram.first].emplace_back(index, gram.second);
+    }
+    totals_.push_back(profile.size());
+    norms_.push_back(profile.norm());
+    return index;
+}
+
+/**
+ * @brief Scores query against every entry of the table.
+ *
+ * @param query The string to compare.
+ * @param metric How shared grams are turned into a score.
+ * @return The similarity of query to each entry, indexed like the entries.
+ */
+std::vector<double> GiSimilarity::ProfileTable::score(std::string_view query, Metric metric) const {
+    return score(Profile(query, q_), metric);
+}
+
+/**
+ * @brief Scores a prepared query profile against every entry of the table.
+ *
+ * @throws std::invalid_argument If query was built with a different q than the table.
+ */
+std::vector<double> GiSimilarity::ProfileTable::score(const Profile &query, Metric metric) const {
+    if (query.q() != q_) {
+        throw std::invalid_argument("Query uses a different q (GiSimilarity::ProfileTable::score)");
+    }
+    // Shared gram counts for Jaccard and Dice, dot products for cosine
+    std::vector<double> sums(totals_.size(), 0.0);
+    for (const std::pair<uint64_t, uint32_t> &gram : query.grams()) {
+        auto found = postings_.find(gram.first);
+        if (found == postings_.end()) {
+            continue;
+        }
+        for (const std::pair<uint32_t, uint32_t> &posting : found->second) {
+            sums[posting.first] += metric == Metric::cosine ? static_cast<double>(gram.second) * posting.second
+                                                            : static_cast<double>(std::min(gram.second, posting.second));
+        }
+    }
+    for (size_t i = 0; i < sums.size(); ++i) {
+        GramOverlap overlap;
+        overlap.shared = overlap.dot = sums[i];
+        sums[i] = qgram_score(metric, overlap, query.size(), totals_[i], query.norm(), norms_[i]);
+    }
+    return sums;
+}
+
+/**
+ * @brief Returns the k entries most similar to query, best first.
+ *
+ * @param query The string to compare.
+ * @param k The maximum number of entries to return.
+ * @param metric How shared grams are turned into a score.
+ * @param min_score Entries scoring below this are left out.
+ * @return (entry index, score) pairs; equal scores are ordered by index.
+ */
+std::vector<std::pair<size_t, double>> GiSimilarity::ProfileTable::best(std::string_view query, size_t k, Metric metric, double min_score) const {
+    std::vector<double> scores = score(query, metric);
+    std::vector<std::pair<size_t, double>> ranked;
+    for (size_t i = 0; i < scores.size(); ++i) {
+        if (scores[i] >= min_score) {
+            ranked.emplace_back(i, scores[i]);
+        }
+    }
+    auto better = [](const std::pair<size_t, double> &lhs, const std::pair<size_t, double> &rhs) {
+        return lhs.second != rhs.second ? lhs.second > rhs.second : lhs.first < rhs.first;
+    };
+    k = std::min(k, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + k, ranked.end(), better);
+    ranked.resize(k);
+    return ranked;
+}
+
+// Example usage:
+// GiSimilarity::ProfileTable products({"apple iphone 15", "samsung galaxy s24", "apple ipad air"}, 3);
+// for (const auto& [index, score] : products.best("iphone 15 apple", 2, GiSimilarity::Metric::dice, 0.3)) {
+//     std::cout << index << " " << score << std::endl;
+// }
@@ -0,0 +1,104 @@
+#ifndef GISIMILARITY_HPP
+#define GISIMILARITY_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief String similarity metrics, all returning a score in [0, 1] where 1 means equal.
+ *
+ * Strings are compared byte by byte. Jaro, Jaro-Winkler and Levenshtein run on 64-bit
+ * match masks and do not allocate when both strings (Jaro, Jaro-Winkler) or the shorter
+ * string (Levenshtein) have at most 64 bytes. The
+ * q-gram metrics compare multisets of overlapping q-byte substrings; a Profile holds the
+ * grams of one string so it can be compared many times, and a ProfileTable indexes many
+ * profiles to score one query against all of them at once.
+ */
+class GiSimilarity
+{
+public:
+    class Profile;
+    class ProfileTable;
+
+    enum class Metric
+    {
+        jaccard, // shared grams / all grams
+        dice,    // 2 * shared grams / (grams of a + grams of b)
+        cosine   // cosine of the angle between the gram count vectors
+    };
+
+    static double jaro(std::string_view a, std::string_view b);
+    static double jaro_winkler(std::string_view a, std::string_view b, double prefix_scale = 0.1);
+    static size_t levenshtein(std::string_view a, std::string_view b);
+    static double normalized_levenshtein(std::string_view a, std::string_view b);
+    static double char_jaccard(std::string_view a, std::string_view b);
+
+    static double jaccard(std::string_view a, std::string_view b, size_t q = 2);
+    static double dice(std::string_view a, std::string_view b, size_t q = 2);
+    static double cosine(std::string_view a, std::string_view b, size_t q = 2);
+    static double qgram_similarity(std::string_view a, std::string_view b, size_t q, Metric metric);
+};
+
+/**
+ * @brief The q-gram multiset of one string, sorted by gram for linear-time comparison.
+ *
+ * A string shorter than q has a single gram: the whole string.
+ */
+class GiSimilarity::Profile
+{
+public:
+    Profile() = default;
+    explicit Profile(std::string_view text, size_t q = 2);
+
+    size_t q() const { return q_; }
+    size_t size() const { return total_; }
+    bool empty() const { return total_ == 0; }
+    double norm() const { return norm_; }
+    const std::vector<std::pair<uint64_t, uint32_t>> &grams() const { return grams_; }
+
+    double similarity(const Profile &other, Metric metric) const;
+    double jaccard(const Profile &other) const { return similarity(other, Metric::jaccard); }
+    double dice(const Profile &other) const { return similarity(other, Metric::dice); }
+    double cosine(const Profile &other) const { return similarity(other, Metric::cosine); }
+
+private:
+    std::vector<std::pair<uint64_t, uint32_t>> grams_; // (gram key, occurrences)
+    size_t q_ = 2;
+    size_t total_ = 0;
+    double norm_ = 0.0;
+};
+
+/**
+ * @brief Many-vs-one q-gram scoring over an inverted index of gram postings.
+ *
+ * Scoring a query only visits the entries that share a gram with it, so a query against a
+ * large table costs the length of its posting lists plus one pass over the scores.
+ */
+class GiSimilarity::ProfileTable
+{
+public:
+    explicit ProfileTable(size_t q = 2);
+    explicit ProfileTable(const std::vector<std::string> &strings, size_t q = 2);
+
+    size_t add(std::string_view text);
+    size_t size() const { return totals_.size(); }
+    bool empty() const { return totals_.empty(); }
+    size_t q() const { return q_; }
+
+    std::vector<double> score(std::string_view query, Metric metric = Metric::cosine) const;
+    std::vector<double> score(const Profile &query, Metric metric = Metric::cosine) const;
+    std::vector<std::pair<size_t, double>> best(std::string_view query, size_t k, Metric metric = Metric::cosine, double min_score = 0.0) const;
+
+private:
+    size_t q_;
+    std::vector<size_t> totals_;
+    std::vector<double> norms_;
+    std::unordered_map<uint64_t, std::vector<std::pair<uint32_t, uint32_t>>> postings_; // gram -> (entry, occurrences)
+};
+
+#endif // GISIMILARITY_HPP
@@ -1,38 +1,106 @@
 
 
 #include "GiString.hpp"
+#include "../GiUnicode/GiUnicode.hpp"
+#include "../GiRandom/GiRandom.hpp"
+#include "../GiSimilarity/GiSimilarity.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace
+{
+    // Letters that change under case mapping: ASCII letters plus every cased non-ASCII code point
+    bool is_cased_letter(char32_t cp)
+    {
+        return cp < 0x80 ? std::isalpha(static_cast<int>(cp)) != 0 : GiUnicode::is_cased(cp);
+    }
+
+    // Appends the full case mapping of the code point at str[pos] and returns its length in bytes
+    size_t append_case_mapped(const std::string &str, size_t pos, GiUnicode::CaseMapping mapping, GiString::Appender out)
+    {
+        char mapped[12];
+        size_t length;
+        size_t written = GiUnicode::map_case(str.data() + pos, str.size() - pos, mapping, mapped, length);
+        out.append(mapped, written);
+        return length;
+    }
+
+    // Upper or lower case conversion; ASCII runs take the GiStringCore byte loop
+    void append_case_converted(const std::string &str, GiUnicode::CaseMapping mapping, GiString::Appender out)
+    {
+        for (size_t pos = 0; pos < str.size();)
+        {
+            size_t run = GiUnicode::ascii_prefix(str.data() + pos, str.size() - pos);
+            if (run > 0)
+            {
+                std::string_view ascii(str.data() + pos, run);
+                if (mapping == GiUnicode::CaseMapping::upper)
+                {
+                    GiStringCore::upper(ascii, out);
+                }
+                else
+                {
+                    GiStringCore::lower(ascii, out);
+                }
+                pos += run;
+                continue;
+            }
+            pos += append_case_mapped(str, pos, mapping, out);
+        }
+    }
+}
 
 /**
  * @brief Capitalizes the first letter of a string and converts the rest to lowercase.
  *
+ * The string is treated as UTF-8: the first code point is mapped to titlecase and the rest
+ * to lowercase with the full Unicode mappings.
+ *
  * @param str The input string to capitalize.
  * @return The capitalized string.
  *
  * @throws std::invalid_argument If the input string is empty.
  */
 std::string GiString::capitalize(const std::string &str)
+{
+    std::string result;
+    result.reserve(str.size());
+    capitalize(str, result);
+    return result;
+}
+
+/**
+ * @brief Capitalizes a string, appending the result to an output sink.
+ *
+ * @param str The input string to capitalize.
+ * @param out The sink the result is appended to.
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::capitalize(const std::string &str, Appender out)
 {
     if (str.empty())
     {
         throw std::invalid_argument("Input string cannot be empty.");
     }
 
-    std::string result = str;
-    result[0] = std::toupper(result[0]); // Capitalize first character
-
-    // Convert rest of the characters to lowercase
-    for (size_t i = 1; i < result.size(); ++i)
-    {
-        result[i] = std::tolower(result[i]);
-    }
-
-    return result;
+    out.reserve(str.size());
+    size_t first = append_case_mapped(str, 0, GiUnicode::CaseMapping::title, out);
+    append_case_converted(str.substr(first), GiUnicode::CaseMapping::lower, out);
 }
 
 // Example usage:
 // std::string input = "heLLo WoRLd";
 // std::string result = capitalize(input);
 // std::cout << "Capitalized string: " << result << std::endl;
+// std::cout << capitalize("ŻÓŁW") << std::endl;  // Output: "Żółw"
 
 /**
  * @brief Capitalizes the first letter of each word in a string.
@@ -44,39 +112,48 @@ std::string GiString::capitalize(const std::string &str)
  */
 std::string GiString::capitalizeWords(const std::string &str)
 {
-    // Check if the input string is empty
+    std::string result;
+    result.reserve(str.size());
+    capitalizeWords(str, result);
+    return result;
+}
+
+/**
+ * @brief Capitalizes the first letter of each word, appending the result to an output sink.
+ *
+ * A word is a run of cased letters (ASCII or Unicode); its first letter is mapped to
+ * titlecase and the rest to lowercase.
+ *
+ * @param str The input string to capitalize.
+ * @param out The sink the result is appended to.
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::capitalizeWords(const std::string &str, Appender out)
+{
     if (str.empty())
     {
         throw std::invalid_argument("Input string is empty");
     }
 
-    std::string capitalized_str = str;
-    bool capitalize_next = true; // Flag to indicate whether the next character should be capitalized
-
-    for (size_t i = 0; i < capitalized_str.length(); ++i)
+    out.reserve(str.size());
+    bool capitalize_next = true;
+    for (size_t pos = 0; pos < str.size();)
     {
-        // Check if the current character is a letter
-        if (std::isalpha(capitalized_str[i]))
+        size_t length;
+        char32_t cp = GiUnicode::decode_utf8(str.data() + pos, str.size() - pos, length);
+        if (is_cased_letter(cp))
         {
-            // Capitalize the letter if it's the first letter of a word
-            if (capitalize_next)
-            {
-                capitalized_str[i] = std::toupper(capitalized_str[i]);
-                capitalize_next = false; // Next letter should not be capitalized
-            }
-            else
-            {
-                capitalized_str[i] = std::tolower(capitalized_str[i]);
-            }
+            pos += append_case_mapped(str, pos, capitalize_next ? GiUnicode::CaseMapping::title : GiUnicode::CaseMapping::lower, out);
+            capitalize_next = false;
         }
         else
         {
-            // If the current character is not a letter, the next one should be capitalized
+            out.append(str.data() + pos, length);
+            pos += length;
             capitalize_next = true;
         }
     }
-
-    return capitalized_str;
 }
 
 // Example usage:
@@ -94,27 +171,41 @@ std::string GiString::capitalizeWords(const std::string &str)
  */
 std::string GiString::swapcase(const std::string &str)
 {
-    // Check if the input string is empty
+    std::string result;
+    result.reserve(str.size());
+    swapcase(str, result);
+    return result;
+}
+
+/**
+ * @brief Swaps the case of all letters, appending the result to an output sink.
+ *
+ * @param str The input string to swap case.
+ * @param out The sink the result is appended to.
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::swapcase(const std::string &str, Appender out)
+{
     if (str.empty())
     {
         throw std::invalid_argument("Input string is empty");
     }
 
-    std::string swapped_str = str;
-
-    for (char &c : swapped_str)
+    out.reserve(str.size());
+    for (char c : str)
     {
-        if (std::islower(c))
+        unsigned char uc = static_cast<unsigned char>(c);
+        if (std::islower(uc))
         {
-            c = std::toupper(c);
+            c = static_cast<char>(std::toupper(uc));
         }
-        else if (std::isupper(c))
+        else if (std::isupper(uc))
         {
-            c = std::tolower(c);
+            c = static_cast<char>(std::tolower(uc));
         }
+        out.push_back(c);
     }
-
-    return swapped_str;
 }
 
 // Example usage:
@@ -132,15 +223,8 @@ std::string GiString::swapcase(const std::string &str)
  */
 std::string GiString::reverse(const std::string &str)
 {
-    // Check if the input string is empty
-    if (str.empty())
-    {
-        throw std::invalid_argument("Input string is empty");
-    }
-
     std::string reversed_str = str;
-    std::reverse(reversed_str.begin(), reversed_str.end());
-
+    inplace::reverse(reversed_str);
     return reversed_str;
 }
 
@@ -213,23 +297,22 @@ bool GiString::is_palindrome(const std::string &str) const
  */
 std::string GiString::trim_left(const std::string &str)
 {
-    // Check if the input string is empty
-    if (str.empty())
-    {
-        throw std::invalid_argument("Input string is empty");
-    }
-
-    // Find the first non-white space character
-    size_t start_pos = str.find_first_not_of(" \t\n\r\f\v");
-
-    // If all characters are white spaces, return an empty string
-    if (start_pos == std::string::npos)
-    {
-        return "";
-    }
+    std::string result;
+    trim_left(str, result);
+    return result;
+}
 
-    // Return the substring starting from the first non-white space character
-    return str.substr(start_pos);
+/**
+ * @brief Appends the trim_left result to an output sink without an intermediate copy.
+ *
+ * @param str The input string to trim.
+ * @param out The sink the trimmed text is appended to.
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::trim_left(const std::string &str, Appender out)
+{
+    out.append(views::trim_left(str));
 }
 
 /**
@@ -242,23 +325,22 @@ std::string GiString::trim_left(const std::string &str)
  */
 std::string GiString::trim_right(const std::string &str)
 {
-    // Check if the input string is empty
-    if (str.empty())
-    {
-        throw std::invalid_argument("Input string is empty");
-    }
-
-    // Find the last non-white space character
-    size_t end_pos = str.find_last_not_of(" \t\n\r\f\v");
-
-    // If all characters are white spaces, return an empty string
-    if (end_pos == std::string::npos)
-    {
-        return "";
-    }
+    std::string result;
+    trim_right(str, result);
+    return result;
+}
 
-    // Return the substring up to the last non-white space character
-    return str.substr(0, end_pos + 1);
+/**
+ * @brief Appends the trim_right result to an output sink without an intermediate copy.
+ *
+ * @param str The input string to trim.
+ * @param out The sink the trimmed text is appended to.
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::trim_right(const std::string &str, Appender out)
+{
+    out.append(views::trim_right(str));
 }
 
 /**
@@ -271,26 +353,22 @@ std::string GiString::trim_right(const std::string &str)
  */
 std::string GiString::trim(const std::string &str)
 {
-    // Check if the input string is empty
-    if (str.empty())
-    {
-        throw std::invalid_argument("Input string is empty");
-    }
-
-    // Find the first non-white space character from the left
-    size_t start_pos = str.find_first_not_of(" \t\n\r\f\v");
-
-    // If all characters are white spaces, return an empty string
-    if (start_pos == std::string::npos)
-    {
-        return "";
-    }
-
-    // Find the last non-white space character from the right
-    size_t end_pos = str.find_last_not_of(" \t\n\r\f\v");
+    std::string result;
+    trim(str, result);
+    return result;
+}
 
-    // Return the substring between the first and last non-white space characters
-    return str.substr(start_pos, end_pos - start_pos + 1);
+/**
+ * @brief Appends the trim result to an output sink without an intermediate copy.
+ *
+ * @param str The input string to trim.
+ * @param out The sink the trimmed text is appended to.
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::trim(const std::string &str, Appender out)
+{
+    out.append(views::trim(str));
 }
 
 /**
@@ -305,25 +383,40 @@ std::string GiString::trim(const std::string &str)
  */
 std::string GiString::center(const std::string &str, size_t width, char fill = ' ')
 {
-    // Check if the width is valid
-    if (width <= str.length())
+    std::string result;
+    result.reserve(width);
+    center(str, width, fill, result);
+    return result;
+}
+
+/**
+ * @brief Centers a string, appending the result to an output sink.
+ *
+ * Width is measured in terminal columns (GiUnicode::display_width), so wide characters,
+ * combining marks and emoji line up.
+ *
+ * @param str The input string to center.
+ * @param width The desired width of the result.
+ * @param fill The character to use for filling.
+ * @param out The sink the result is appended to.
+ *
+ * @throws std::invalid_argument If the width is less than or equal to the length of the input string.
+ */
+void GiString::center(const std::string &str, size_t width, char fill, Appender out)
+{
+    size_t columns = GiUnicode::display_width(str);
+    if (width <= columns)
     {
         throw std::invalid_argument("Width must be greater than the length of the input string");
     }
 
-    // Calculate the number of characters to pad on each side
-    size_t total_padding = width - str.length();
+    size_t total_padding = width - columns;
     size_t left_padding = total_padding / 2;
-    size_t right_padding = total_padding - left_padding;
 
-    // Construct the centered string
-    std::string centered_str;
-    centered_str.reserve(width);
-    centered_str.append(left_padding, fill);
-    centered_str.append(str);
-    centered_str.append(right_padding, fill);
-
-    return centered_str;
+    out.reserve(str.size() + total_padding);
+    out.append(left_padding, fill);
+    out.append(str);
+    out.append(total_padding - left_padding, fill);
 }
 
 /**
@@ -339,23 +432,40 @@ std::string GiString::center(const std::string &str, size_t width, char fill = '
  */
 std::string GiString::ljust(const std::string &str, size_t width, char fillchar = ' ')
 {
-    // Check if width is less than the length of the input string
-    if (width < str.length())
+    std::string result;
+    result.reserve(width);
+    ljust(str, width, fillchar, result);
+    return result;
+}
+
+/**
+ * @brief Left-aligns a string, appending the result to an output sink.
+ *
+ * Width is measured in terminal columns, as in center().
+ *
+ * @param str The input string to left-align.
+ * @param width The width to which the string should be aligned.
+ * @param fillchar The character used for padding.
+ * @param out The sink the result is appended to.
+ *
+ * @throws std::invalid_argument If width is less than the length of the input string.
+ * @throws std::invalid_argument If fillchar is the null character.
+ */
+void GiString::ljust(const std::string &str, size_t width, char fillchar, Appender out)
+{
+    size_t columns = GiUnicode::display_width(str);
+    if (width < columns)
     {
         throw std::invalid_argument("GiString::ljust: Width is less than the length of the input string");
     }
-
-    // Check if fillchar is a single character
     if (fillchar == '\0')
     {
         throw std::invalid_argument("GiString::ljust: Fill character cannot be null");
     }
 
-    // Calculate the number of characters to pad
-    size_t padding = width - str.length();
-
-    // Left-align the string and pad it
-    return str + std::string(padding, fillchar);
+    out.reserve(str.size() + width - columns);
+    out.append(str);
+    out.append(width - columns, fillchar);
 }
 
 /**
@@ -371,32 +481,47 @@ std::string GiString::ljust(const std::string &str, size_t width, char fillchar
  */
 std::string GiString::rjust(const std::string &str, size_t width, char fillchar = ' ')
 {
-    // Check if width is valid
-    if (width <= str.length())
+    std::string result;
+    result.reserve(width);
+    rjust(str, width, fillchar, result);
+    return result;
+}
+
+/**
+ * @brief Right-justifies a string, appending the result to an output sink.
+ *
+ * Width is measured in terminal columns, as in center().
+ *
+ * @param str The input string to be right-justified.
+ * @param width The width of the result.
+ * @param fillchar The character used for filling the space.
+ * @param out The sink the result is appended to.
+ *
+ * @throws std::invalid_argument If the width is less than or equal to the length of the input string.
+ * @throws std::invalid_argument If the fill character is not a printable ASCII character.
+ */
+void GiString::rjust(const std::string &str, size_t width, char fillchar, Appender out)
+{
+    size_t columns = GiUnicode::display_width(str);
+    if (width <= columns)
     {
         throw std::invalid_argument("Width must be greater than the length of the input string (GiString::rjust)");
     }
-
-    // Check if fill character is a printable ASCII character
-    if (!isprint(fillchar))
+    if (!isprint(static_cast<unsigned char>(fillchar)))
     {
         throw std::invalid_argument("Fill character must be a printable ASCII character (GiString::rjust)");
     }
 
-    // Calculate the number of characters to fill
-    size_t fill_count = width - str.length();
-
-    // Construct the justified string
-    std::string justified_str(fill_count, fillchar);
-    justified_str += str;
-
-    return justified_str;
+    out.reserve(str.size() + width - columns);
+    out.append(width - columns, fillchar);
+    out.append(str);
 }
 
 // Example usage:
 // std::string input = "hello";
 // std::string result = GiString::rjust(input, 10, '-');
 // std::cout << "Right-justified string: " << result << std::endl;
+// std::cout << "[" << GiString::rjust("中文", 6, ' ') << "]" << std::endl;  // Output: "[  中文]"
 
 /**
  * @brief Converts all letters in a string to uppercase.
@@ -408,26 +533,53 @@ std::string GiString::rjust(const std::string &str, size_t width, char fillchar
  */
 std::string GiString::upper(const std::string &str)
 {
-    // Check if the input string is empty
+    std::string result;
+    result.reserve(str.size());
+    upper(str, result);
+    return result;
+}
+
+/**
+ * @brief Converts all letters to uppercase, appending the result to an output sink.
+ *
+ * The string is treated as UTF-8 and mapped with the full Unicode mappings, so the result
+ * can be longer than the input ("ß" becomes "SS"). Pure ASCII input stays on the byte loop.
+ * Bytes that are not valid UTF-8 are copied through unchanged.
+ *
+ * @param str The input string to be converted.
+ * @param out The sink the result is appended to.
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::upper(const std::string &str, Appender out)
+{
     if (str.empty())
     {
         throw std::invalid_argument("Input string is empty (GiString::upper)");
     }
 
-    // Convert each character to uppercase
-    std::string uppercase_str;
-    for (char c : str)
-    {
-        uppercase_str += std::toupper(c);
-    }
-
-    return uppercase_str;
+    out.reserve(str.size());
+    append_case_converted(str, GiUnicode::CaseMapping::upper, out);
 }
 
 // Example usage:
 // std::string input = "hello World";
 // std::string result = GiString::upper(input);
 // std::cout << "Uppercase string: " << result << std::endl;
+//
+// std::string line;                        // reused across records, no per-call allocation
+// for (const std::string& record : records) {
+//     line.clear();
+//     gs.upper(record, line);
+// }
+//
+// char buffer[16];
+// GiString::FixedBuffer fixed(buffer, sizeof(buffer));
+// gs.upper(input, fixed);
+// if (fixed.truncated()) { /* retry with fixed.required bytes */ }
+//
+// std::cout << gs.upper("zażółć gęślą jaźń, straße") << std::endl;
+// Output: "ZAŻÓŁĆ GĘŚLĄ JAŹŃ, STRASSE"
 
 /**
  * @brief Converts all letters in a string to lowercase.
@@ -439,22 +591,31 @@ std::string GiString::upper(const std::string &str)
  */
 std::string GiString::lower(const std::string &str)
 {
-    // Check if the input string is empty
+    std::string result;
+    result.reserve(str.size());
+    lower(str, result);
+    return result;
+}
+
+/**
+ * @brief Converts all letters to lowercase, appending the result to an output sink.
+ *
+ * Like upper(), the string is treated as UTF-8 and mapped with the full Unicode mappings.
+ *
+ * @param str The input string to convert.
+ * @param out The sink the result is appended to.
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::lower(const std::string &str, Appender out)
+{
     if (str.empty())
     {
         throw std::invalid_argument("Input string is empty (GiString::lower)");
     }
 
-    std::string result = str;
-    for (char &c : result)
-    {
-        if (std::isalpha(c))
-        {
-            c = std::tolower(c);
-        }
-    }
-
-    return result;
+    out.reserve(str.size());
+    append_case_converted(str, GiUnicode::CaseMapping::lower, out);
 }
 
 // Example usage:
@@ -462,6 +623,7 @@ std::string GiString::lower(const std::string &str)
 // std::string input = "Hello World";
 // std::string result = gs->lower(input);
 // std::cout << "Lowercase string: " << result << std::endl;
+// std::cout << gs->lower("ZAŻÓŁĆ GĘŚLĄ") << std::endl;  // Output: "zażółć gęślą"
 
 /**
  * @brief Counts the occurrences of a substring in a string.
@@ -474,25 +636,7 @@ std::string GiString::lower(const std::string &str)
  */
 size_t GiString::count(const std::string &str, const std::string &sub)
 {
-    // Check if the input string or substring is empty
-    if (str.empty())
-    {
-        throw std::invalid_argument("Input string is empty (GiString::count)");
-    }
-    if (sub.empty())
-    {
-        throw std::invalid_argument("Substring is empty (GiString::count)");
-    }
-
-    size_t count = 0;
-    size_t pos = 0;
-    while ((pos = str.find(sub, pos)) != std::string::npos)
-    {
-        ++count;
-        pos += sub.length();
-    }
-
-    return count;
+    return views::count(str, sub);
 }
 
 // Example usage:
@@ -514,23 +658,7 @@ size_t GiString::count(const std::string &str, const std::string &sub)
  */
 std::string GiString::substring(const std::string &str, size_t start, size_t end)
 {
-    // Check if the start index is out of range
-    if (start >= str.length())
-    {
-        throw std::out_of_range("Start index out of range (GiString::substring)");
-    }
-    // Check if the end index is out of range
-    if (end > str.length())
-    {
-        throw std::out_of_range("End index out of range (GiString::substring)");
-    }
-    // Check if the start index is greater than the end index
-    if (start >= end)
-    {
-        throw std::invalid_argument("Start index must be less than end index (GiString::substring)");
-    }
-
-    return str.substr(start, end - start);
+    return std::string(views::substring(str, start, end));
 }
 
 // Example usage:
@@ -553,25 +681,42 @@ std::string GiString::substring(const std::string &str, size_t start, size_t end
  */
 std::string GiString::replace(const std::string &str, const std::string &old_sub, const std::string &new_sub)
 {
-    // Check if the input string or substrings are empty
-    if (str.empty())
-    {
-        throw std::invalid_argument("Input string is empty (GiString::replace)");
-    }
-    if (old_sub.empty())
-    {
-        throw std::invalid_argument("Old substring is empty (GiString::replace)");
-    }
-
-    std::string result = str;
-    size_t pos = 0;
-    while ((pos = result.find(old_sub, pos)) != std::string::npos)
+    std::string result;
+    result.reserve(str.size());
+    replace(str, old_sub, new_sub, result);
+    return result;
+}
+
+/**
+ * @brief Replaces all occurrences of a substring, appending the result to an output sink.
+ *
+ * @param str The input string in which to perform replacements.
+ * @param old_sub The substring to be replaced.
+ * @param new_sub The string to replace occurrences of the substring with.
+ * @param out The sink the result is appended to.
+ *
+ * @throws std::invalid_argument If the input string or old substring is empty.
+ */
+void GiString::replace(const std::string &str, const std::string &old_sub, const std::string &new_sub, Appender out)
+{
+    if (str.empty())
+    {
+        throw std::invalid_argument("Input string is empty (GiString::replace)");
+    }
+    if (old_sub.empty())
     {
-        result.replace(pos, old_sub.length(), new_sub);
-        pos += new_sub.length();
+        throw std::invalid_argument("Old substring is empty (GiString::replace)");
     }
 
-    return result;
+    size_t start = 0;
+    size_t pos;
+    while ((pos = str.find(old_sub, start)) != std::string::npos)
+    {
+        out.append(str.data() + start, pos - start);
+        out.append(new_sub);
+        start = pos + old_sub.length();
+    }
+    out.append(str.data() + start, str.size() - start);
 }
 
 // Example usage:
@@ -593,18 +738,42 @@ std::string GiString::replace(const std::string &str, const std::string &old_sub
  */
 std::vector<std::string> GiString::split(const std::string &str, char delimiter)
 {
-    // Check if the delimiter is empty
+    std::vector<std::string_view> parts = views::split(str, delimiter);
+    return std::vector<std::string>(parts.begin(), parts.end());
+}
+
+/**
+ * @brief Splits a string using the specified delimiter, allocating from a memory resource.
+ *
+ * Produces the same tokens as split(const std::string&, char); the vector and every token
+ * are allocated from resource, so with a GiString::Arena the call makes no heap allocations.
+ *
+ * @param str The input string to split.
+ * @param delimiter The delimiter character.
+ * @param resource The memory resource used for the vector and the tokens.
+ * @return The tokens, allocated from resource.
+ *
+ * @throws std::invalid_argument If the delimiter is the null character.
+ */
+std::pmr::vector<std::pmr::string> GiString::split(const std::string &str, char delimiter, std::pmr::memory_resource *resource)
+{
     if (delimiter == '\0')
     {
         throw std::invalid_argument("Delimiter cannot be empty (GiString::split)");
     }
 
-    std::vector<std::string> tokens;
-    std::stringstream ss(str);
-    std::string token;
-    while (std::getline(ss, token, delimiter))
+    std::pmr::vector<std::pmr::string> tokens(resource);
+    tokens.reserve(static_cast<size_t>(std::count(str.begin(), str.end(), delimiter)) + 1);
+    size_t start = 0;
+    while (start < str.size())
     {
-        tokens.push_back(token);
+        size_t pos = str.find(delimiter, start);
+        if (pos == std::string::npos)
+        {
+            pos = str.size();
+        }
+        tokens.emplace_back(str.data() + start, pos - start);
+        start = pos + 1;
     }
 
     return tokens;
@@ -669,17 +838,7 @@ std::string GiString::join(const std::vector<std::string> &strs, const std::stri
  */
 bool GiString::startswith(const std::string &str, const std::string &prefix)
 {
-    // Check if the input string or prefix is empty
-    if (str.empty())
-    {
-        throw std::invalid_argument("Input string is empty (GiString::startswith)");
-    }
-    if (prefix.empty())
-    {
-        throw std::invalid_argument("Prefix is empty (GiString::startswith)");
-    }
-
-    return str.compare(0, prefix.length(), prefix) == 0;
+    return views::startswith(str, prefix);
 }
 
 // Example usage:
@@ -700,22 +859,7 @@ bool GiString::startswith(const std::string &str, const std::string &prefix)
  */
 bool GiString::endswith(const std::string &str, const std::string &suffix)
 {
-    // Check if the input string or suffix is empty
-    if (str.empty())
-    {
-        throw std::invalid_argument("Input string is empty (GiString::endswith)");
-    }
-    if (suffix.empty())
-    {
-        throw std::invalid_argument("Suffix is empty (GiString::endswith)");
-    }
-
-    if (str.length() < suffix.length())
-    {
-        return false;
-    }
-
-    return str.compare(str.length() - suffix.length(), suffix.length(), suffix) == 0;
+    return views::endswith(str, suffix);
 }
 
 // Example usage:
@@ -735,21 +879,7 @@ bool GiString::endswith(const std::string &str, const std::string &suffix)
  */
 bool GiString::is_ascii(const std::string &str)
 {
-    // Check if the input string is empty
-    if (str.empty())
-    {
-        throw std::invalid_argument("Input string is empty (GiString::is_ascii)");
-    }
-
-    for (char c : str)
-    {
-        if (static_cast<unsigned char>(c) > 127)
-        {
-            return false;
-        }
-    }
-
-    return true;
+    return views::is_ascii(str);
 }
 
 // Example usage:
@@ -768,21 +898,7 @@ bool GiString::is_ascii(const std::string &str)
  */
 bool GiString::is_numeric(const std::string &str)
 {
-    // Check if the input string is empty
-    if (str.empty())
-    {
-        throw std::invalid_argument("Input string is empty (GiString::is_numeric)");
-    }
-
-    for (char c : str)
-    {
-        if (!std::isdigit(c))
-        {
-            return false;
-        }
-    }
-
-    return true;
+    return views::is_numeric(str);
 }
 
 // Example usage:
@@ -801,21 +917,7 @@ bool GiString::is_numeric(const std::string &str)
  */
 bool GiString::is_alpha(const std::string &str)
 {
-    // Check if the input string is empty
-    if (str.empty())
-    {
-        throw std::invalid_argument("Input string is empty (GiString::is_alpha)");
-    }
-
-    for (char c : str)
-    {
-        if (!std::isalpha(c))
-        {
-            return false;
-        }
-    }
-
-    return true;
+    return views::is_alpha(str);
 }
 
 // Example usage:
@@ -834,21 +936,7 @@ bool GiString::is_alpha(const std::string &str)
  */
 bool GiString::is_alphanumeric(const std::string &str)
 {
-    // Check if the input string is empty
-    if (str.empty())
-    {
-        throw std::invalid_argument("Input string is empty (GiString::is_alphanumeric)");
-    }
-
-    for (char c : str)
-    {
-        if (!std::isalnum(c))
-        {
-            return false;
-        }
-    }
-
-    return true;
+    return views::is_alphanumeric(str);
 }
 
 // Example usage:
@@ -870,13 +958,31 @@ bool GiString::is_alphanumeric(const std::string &str)
  */
 std::string GiString::zfill(const std::string &str, size_t width)
 {
-    // Check if the specified width is less than the length of the input string
+    std::string result;
+    result.reserve(width);
+    zfill(str, width, result);
+    return result;
+}
+
+/**
+ * @brief Fills the string with leading zeros, appending the result to an output sink.
+ *
+ * @param str The input string to fill with zeros.
+ * @param width The desired width of the result.
+ * @param out The sink the result is appended to.
+ *
+ * @throws std::invalid_argument If the specified width is not greater than the length of the input string.
+ */
+void GiString::zfill(const std::string &str, size_t width, Appender out)
+{
     if (width <= str.length())
     {
         throw std::invalid_argument("Width must be greater than the length of the input string (GiString::zfill)");
     }
 
-    return std::string(width - str.length(), '0') + str;
+    out.reserve(width);
+    out.append(width - str.length(), '0');
+    out.append(str);
 }
 
 // Example usage:
@@ -894,9 +1000,20 @@ std::string GiString::zfill(const std::string &str, size_t width)
  */
 std::string GiString::ltrim(const std::string &str)
 {
-    auto it = std::find_if(str.begin(), str.end(), [](unsigned char ch)
-                           { return !std::isspace(ch); });
-    return std::string(it, str.end());
+    std::string result;
+    ltrim(str, result);
+    return result;
+}
+
+/**
+ * @brief Appends the ltrim result to an output sink without an intermediate copy.
+ *
+ * @param str The input string to trim.
+ * @param out The sink the trimmed text is appended to.
+ */
+void GiString::ltrim(const std::string &str, Appender out)
+{
+    out.append(views::ltrim(str));
 }
 
 // Example usage:
@@ -913,9 +1030,20 @@ std::string GiString::ltrim(const std::string &str)
  */
 std::string GiString::rtrim(const std::string &str)
 {
-    auto it = std::find_if(str.rbegin(), str.rend(), [](unsigned char ch)
-                           { return !std::isspace(ch); });
-    return std::string(str.begin(), it.base());
+    std::string result;
+    rtrim(str, result);
+    return result;
+}
+
+/**
+ * @brief Appends the rtrim result to an output sink without an intermediate copy.
+ *
+ * @param str The input string to trim.
+ * @param out The sink the trimmed text is appended to.
+ */
+void GiString::rtrim(const std::string &str, Appender out)
+{
+    out.append(views::rtrim(str));
 }
 
 // Example usage:
@@ -935,17 +1063,7 @@ std::string GiString::rtrim(const std::string &str)
  */
 size_t GiString::find(const std::string &str, const std::string &sub)
 {
-    // Check if the input string or substring is empty
-    if (str.empty())
-    {
-        throw std::invalid_argument("Input string is empty (GiString::find)");
-    }
-    if (sub.empty())
-    {
-        throw std::invalid_argument("Substring is empty (GiString::find)");
-    }
-
-    return str.find(sub);
+    return views::find(str, sub);
 }
 
 // Example usage:
@@ -966,17 +1084,7 @@ size_t GiString::find(const std::string &str, const std::string &sub)
  */
 size_t GiString::rfind(const std::string &str, const std::string &sub)
 {
-    // Check if the input string or substring is empty
-    if (str.empty())
-    {
-        throw std::invalid_argument("Input string is empty (GiString::rfind)");
-    }
-    if (sub.empty())
-    {
-        throw std::invalid_argument("Substring is empty (GiString::rfind)");
-    }
-
-    return str.rfind(sub);
+    return views::rfind(str, sub);
 }
 
 // Example usage:
@@ -997,17 +1105,7 @@ size_t GiString::rfind(const std::string &str, const std::string &sub)
  */
 bool GiString::contains(const std::string &str, const std::string &sub)
 {
-    // Check if the input string or substring is empty
-    if (str.empty())
-    {
-        throw std::invalid_argument("Input string is empty (GiString::contains)");
-    }
-    if (sub.empty())
-    {
-        throw std::invalid_argument("Substring is empty (GiString::contains)");
-    }
-
-    return str.find(sub) != std::string::npos;
+    return views::contains(str, sub);
 }
 
 // Example usage:
@@ -1029,20 +1127,7 @@ bool GiString::contains(const std::string &str, const std::string &sub)
  */
 bool GiString::equals_ignore_case(const std::string &str1, const std::string &str2)
 {
-    if (str1.length() != str2.length())
-    {
-        return false;
-    }
-
-    for (size_t i = 0; i < str1.length(); ++i)
-    {
-        if (std::tolower(str1[i]) != std::tolower(str2[i]))
-        {
-            return false;
-        }
-    }
-
-    return true;
+    return views::equals_ignore_case(str1, str2);
 }
 
 // Example usage:
@@ -1062,15 +1147,9 @@ bool GiString::equals_ignore_case(const std::string &str1, const std::string &st
  *
  * @throws std::out_of_range If the specified position is out of range.
  */
-std::string GiString::insert(std::string str, size_t pos, const std::string &sub)
+std::string GiString::insert(const std::string &str, size_t pos, const std::string &sub)
 {
-    // Check if the specified position is out of range
-    if (pos > str.length())
-    {
-        throw std::out_of_range("Position is out of range (GiString::insert)");
-    }
-
-    return str.insert(pos, sub);
+    return views::insert(str, pos, sub);
 }
 
 // Example usage:
@@ -1320,31 +1399,6 @@ std::string GiString::filter_chars(const std::string &str, std::function<bool(ch
 // std::string result = gs->filter_chars(str, [](char c) { return std::isalpha(c); });
 // std::cout << "Filtered string: " << result << std::endl;
 
-/**
- * @brief Reduces a string to a single value using a given binary function.
- *
- * @param str The input string to reduce.
- * @param init The initial value for the reduction.
- * @param binary_func The binary function to apply to each character.
- * @return The result of the reduction.
- */
-template <typename T>
-T GiString::reduce(const std::string &str, T init, std::function<T(T, char)> binary_func)
-{
-    T result = init;
-    for (char c : str)
-    {
-        result = binary_func(result, c);
-    }
-    return result;
-}
-
-// Example usage:
-// GiString* gs = new GiString();
-// std::string str = "hello";
-// int result_length = gs->reduce<int>(str, 0, [](int acc, char c) { return acc + 1; });
-// std::cout << "Length of the string: " << result_length << std::endl;
-
 /**
  * @brief Checks if all characters in a string satisfy a given predicate function.
  *
@@ -1394,23 +1448,7 @@ bool GiString::none_of(const std::string &str, std::function<bool(char)> predica
  */
 std::string GiString::slice(const std::string &str, size_t start, size_t end)
 {
-    // Check if the start index is out of range
-    if (start >= str.length())
-    {
-        throw std::out_of_range("Start index is out of range (GiString::slice)");
-    }
-    // Check if the end index is out of range
-    if (end > str.length())
-    {
-        throw std::out_of_range("End index is out of range (GiString::slice)");
-    }
-    // Check if the end index is less than the start index
-    if (end < start)
-    {
-        throw std::invalid_argument("End index is less than the start index (GiString::slice)");
-    }
-
-    return str.substr(start, end - start);
+    return std::string(views::slice(str, start, end));
 }
 
 // Example usage:
@@ -1425,12 +1463,9 @@ std::string GiString::slice(const std::string &str, size_t start, size_t end)
  * @param str The input string to modify.
  * @return The string with only ASCII characters.
  */
-std::string GiString::ascii_only(std::string str)
+std::string GiString::ascii_only(const std::string &str)
 {
-    str.erase(std::remove_if(str.begin(), str.end(), [](unsigned char c)
-                             { return c > 127; }),
-              str.end());
-    return str;
+    return views::ascii_only(str);
 }
 
 // Example usage:
@@ -1528,6 +1563,47 @@ std::string GiString::indent(const std::string &str, int count)
 // std::string indentedString = myString->indent(4);
 // std::cout << "Indented string:\n" << indentedString << std::endl;
 
+namespace
+{
+    // Shared by both dedent overloads; lines are split like std::getline
+    template <typename String>
+    void dedent_into(const std::string &str, String &result)
+    {
+        // Find the minimum indentation in the string
+        size_t minIndent = std::string::npos;
+        for (size_t start = 0; start < str.size();)
+        {
+            size_t end = std::min(str.find('\n', start), str.size());
+            if (end > start)
+            {
+                size_t lineIndent = str.find_first_not_of(' ', start);
+                if (lineIndent < end && (minIndent == std::string::npos || lineIndent - start < minIndent))
+                {
+                    minIndent = lineIndent - start;
+                }
+            }
+            start = end + 1;
+        }
+
+        // Remove indentation from each line
+        result.reserve(str.size() + 1);
+        for (size_t start = 0; start < str.size();)
+        {
+            size_t end = std::min(str.find('\n', start), str.size());
+            if (end > start)
+            {
+                if (minIndent > end - start)
+                {
+                    throw std::out_of_range("Line is shorter than the common indentation (GiString::dedent)");
+                }
+                result.append(str, start + minIndent, end - start - minIndent);
+            }
+            result += '\n';
+            start = end + 1;
+        }
+    }
+}
+
 /**
  * @brief Removes indentation from each line of the string.
  *
@@ -1545,38 +1621,28 @@ std::string GiString::dedent(const std::string &str)
     }
 
     std::string result;
-    std::istringstream iss(str);
-    std::string line;
-
-    // Find the minimum indentation in the string
-    size_t minIndent = std::string::npos;
-    while (std::getline(iss, line))
-    {
-        if (!line.empty())
-        {
-            size_t lineIndent = line.find_first_not_of(" ");
-            if (lineIndent != std::string::npos && (minIndent == std::string::npos || lineIndent < minIndent))
-            {
-                minIndent = lineIndent;
-            }
-        }
-    }
+    dedent_into(str, result);
+    return result;
+}
 
-    // Remove indentation from each line
-    iss.clear();
-    iss.seekg(0);
-    while (std::getline(iss, line))
+/**
+ * @brief Removes indentation from each line, allocating the result from a memory resource.
+ *
+ * @param str The input string to remove indentation from.
+ * @param resource The memory resource used for the result.
+ * @return The string with indentation removed from each line.
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+std::pmr::string GiString::dedent(const std::string &str, std::pmr::memory_resource *resource)
+{
+    if (str.empty())
     {
-        if (!line.empty())
-        {
-            result += line.substr(minIndent) + "\n";
-        }
-        else
-        {
-            result += "\n";
-        }
+        throw std::invalid_argument("Input string is empty (GiString::dedent)");
     }
 
+    std::pmr::string result(resource);
+    dedent_into(str, result);
     return result;
 }
 
@@ -1597,22 +1663,36 @@ std::string GiString::dedent(const std::string &str)
  * @throws std::invalid_argument If the input string is empty.
  */
 std::string GiString::replace_first(const std::string& str, const std::string& from, const std::string& to) {
-    // Check if the input string is empty
-    if (str.empty()) {
-        throw std::invalid_argument("Input string is empty (GiString::replace_first)");
-    }
+    std::string result;
+    result.reserve(str.size() + to.size());
+    replace_first(str, from, to, result);
+    return result;
+}
+
+/**
+ * @brief Replaces the first occurrence of a substring, appending the result to an output sink.
+ *
+ * @param str The input string where the replacement will be performed.
+ * @param from The substring to be replaced.
+ * @param to The string to replace the substring with.
+ * @param out The sink the result is appended to.
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::replace_first(const std::string& str, const std::string& from, const std::string& to, Appender out) {
+    if (str.empty()) {
+        throw std::invalid_argument("Input string is empty (GiString::replace_first)");
+    }
 
-    // Find the position of the first occurrence of the substring to be replaced
     size_t startPos = str.find(from);
     if (startPos == std::string::npos) {
-        // If the substring to be replaced is not found, return the original string
-        return str;
+        out.append(str);
+        return;
     }
 
-    // Replace the first occurrence of the substring
-    std::string result = str;
-    result.replace(startPos, from.length(), to);
-    return result;
+    out.append(str.data(), startPos);
+    out.append(to);
+    out.append(str.data() + startPos + from.length(), str.size() - startPos - from.length());
 }
 
 // Example usage:
@@ -1633,22 +1713,36 @@ std::string GiString::replace_first(const std::string& str, const std::string& f
  * @throws std::invalid_argument If the input string is empty.
  */
 std::string GiString::replace_last(const std::string& str, const std::string& from, const std::string& to) {
-    // Check if the input string is empty
+    std::string result;
+    result.reserve(str.size() + to.size());
+    replace_last(str, from, to, result);
+    return result;
+}
+
+/**
+ * @brief Replaces the last occurrence of a substring, appending the result to an output sink.
+ *
+ * @param str The input string where the replacement will be performed.
+ * @param from The substring to be replaced.
+ * @param to The string to replace the substring with.
+ * @param out The sink the result is appended to.
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::replace_last(const std::string& str, const std::string& from, const std::string& to, Appender out) {
     if (str.empty()) {
         throw std::invalid_argument("Input string is empty (GiString::replace_last)");
     }
 
-    // Find the position of the last occurrence of the substring to be replaced
     size_t startPos = str.rfind(from);
     if (startPos == std::string::npos) {
-        // If the substring to be replaced is not found, return the original string
-        return str;
+        out.append(str);
+        return;
     }
 
-    // Replace the last occurrence of the substring
-    std::string result = str;
-    result.replace(startPos, from.length(), to);
-    return result;
+    out.append(str.data(), startPos);
+    out.append(to);
+    out.append(str.data() + startPos + from.length(), str.size() - startPos - from.length());
 }
 
 // Example usage:
@@ -1701,12 +1795,8 @@ std::string GiString::shuffle(const std::string& str) {
     // Create a copy of the input string
     std::string result = str;
 
-    // Obtain a random seed based on current time
-    std::random_device rd;
-    std::mt19937 gen(rd());
-
     // Shuffle the characters randomly
-    std::shuffle(result.begin(), result.end(), gen);
+    GiRandom::local().shuffle(result.begin(), result.end());
     return result;
 }
 
@@ -1716,8 +1806,121 @@ std::string GiString::shuffle(const std::string& str) {
 // std::cout << "Shuffled string: " << shuffledString << std::endl;
 
 
+namespace
+{
+    // Adds the number of occurrences of every byte value to counts. Four interleaved
+    // sub-histograms keep runs of equal bytes from serialising on one counter; SSE2/AVX2
+    // have no scatter-add, so this is the fastest form on x86.
+    void byte_histogram(const char* data, size_t size, size_t counts[256]) {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+        size_t i = 0;
+        if (size >= 1024) {
+            size_t sub[4][256] = {};
+            for (; i + 4 <= size; i += 4) {
+                ++sub[0][p[i]];
+                ++sub[1][p[i + 1]];
+                ++sub[2][p[i + 2]];
+                ++sub[3][p[i + 3]];
+            }
+            for (size_t b = 0; b < 256; ++b) {
+                counts[b] += sub[0][b] + sub[1][b] + sub[2][b] + sub[3][b];
+            }
+        }
+        for (; i < size; ++i) {
+            ++counts[p[i]];
+        }
+    }
+
+    // Appends the bytes of str in char order (descending if asked), as std::sort would
+    // order them. Counting sort; short strings are cheaper to sort in place.
+    void append_sorted_bytes(const std::string& str, bool descending, std::string& out) {
+        if (str.size() < 32) {
+            size_t start = out.size();
+            out.append(str);
+            if (descending) {
+                std::sort(out.begin() + start, out.end(), std::greater<char>());
+            } else {
+                std::sort(out.begin() + start, out.end());
+            }
+            return;
+        }
+        size_t counts[256] = {};
+        byte_histogram(str.data(), str.size(), counts);
+        out.reserve(out.size() + str.size());
+        for (int v = 0; v < 256; ++v) {
+            char c = static_cast<char>(descending ? CHAR_MAX - v : CHAR_MIN + v);
+            size_t n = counts[static_cast<unsigned char>(c)];
+            if (n > 0) {
+                out.append(n, c);
+            }
+        }
+    }
+
+    // Appends the first occurrence of every byte of str, in order of appearance
+    void append_first_occurrences(const std::string& str, std::string& out) {
+        std::bitset<256> seen;
+        size_t distinct = 0;
+        for (char c : str) {
+            unsigned char b = static_cast<unsigned char>(c);
+            if (!seen[b]) {
+                seen.set(b);
+                out.push_back(c);
+                if (++distinct == 256) {
+                    break;
+                }
+            }
+        }
+    }
+
+    // True when no char is greater than the one after it
+    bool chars_sorted(const char* data, size_t size) {
+        size_t i = 0;
+#if defined(__SSE2__)
+        // Signed byte compares; flipping the top bit turns them into unsigned ones
+        const __m128i bias = _mm_set1_epi8(std::is_signed<char>::value ? 0 : static_cast<char>(0x80));
+        for (; i + 17 <= size; i += 16) {
+            __m128i current = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), bias);
+            __m128i next = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 1)), bias);
+            if (_mm_movemask_epi8(_mm_cmpgt_epi8(current, next)) != 0) {
+                return false;
+            }
+        }
+#endif
+        for (; i + 1 < size; ++i) {
+            if (data[i] > data[i + 1]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Index of the first position where a and b differ, or size
+    size_t first_mismatch(const char* a, const char* b, size_t size) {
+        size_t i = 0;
+#if defined(__SSE2__)
+        for (; i + 16 <= size; i += 16) {
+            unsigned equal = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)))));
+            if (equal != 0xFFFF) {
+                while (equal & 1) {
+                    equal >>= 1;
+                    ++i;
+                }
+                return i;
+            }
+        }
+#endif
+        while (i < size && a[i] == b[i]) {
+            ++i;
+        }
+        return i;
+    }
+}
+
 /**
  * @brief Sorts the characters in a string in alphabetical order.
+ *
+ * Uses a counting sort over the 256 byte values, so the cost is O(n).
  * 
  * @param str The input string to sort.
  * @return The string with characters sorted in alphabetical order.
@@ -1730,11 +1933,8 @@ std::string GiString::sort(const std::string& str) {
         throw std::invalid_argument("Input string is empty (GiString::sort)");
     }
 
-    // Create a copy of the input string
-    std::string result = str;
-
-    // Sort the characters in alphabetical order
-    std::sort(result.begin(), result.end());
+    std::string result;
+    append_sorted_bytes(str, false, result);
     return result;
 }
 
@@ -1746,6 +1946,8 @@ std::string GiString::sort(const std::string& str) {
 
 /**
  * @brief Sorts the characters in a string in reverse alphabetical order.
+ *
+ * Uses a counting sort over the 256 byte values, so the cost is O(n).
  * 
  * @param str The input string to sort.
  * @return The string with characters sorted in reverse alphabetical order.
@@ -1758,11 +1960,8 @@ std::string GiString::sort_desc(const std::string& str) {
         throw std::invalid_argument("Input string is empty (GiString::sort_desc)");
     }
 
-    // Create a copy of the input string
-    std::string result = str;
-
-    // Sort the characters in reverse alphabetical order
-    std::sort(result.begin(), result.end(), std::greater<char>());
+    std::string result;
+    append_sorted_bytes(str, true, result);
     return result;
 }
 
@@ -2001,23 +2200,33 @@ bool GiString::is_valid_domain_part(const std::string& domainPart) {
  * @return The URL-encoded string.
  */
 std::string GiString::url_encode(const std::string& str) {
-    std::ostringstream escaped;
-    escaped.fill('0');
-    escaped << std::hex;
+    std::string result;
+    result.reserve(str.size());
+    url_encode(str, result);
+    return result;
+}
 
+/**
+ * @brief URL-encodes a string, appending the result to an output sink.
+ *
+ * @param str The input string to encode.
+ * @param out The sink the result is appended to.
+ */
+void GiString::url_encode(const std::string& str, Appender out) {
+    static const char digits[] = "0123456789abcdef";
+
+    out.reserve(str.size());
     for (char c : str) {
-        // Keep alphanumeric and special characters untouched
-        if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
-            escaped << c;
+        unsigned char uc = static_cast<unsigned char>(c);
+        if (std::isalnum(uc) || c == '-' || c == '_' || c == '.' || c == '~') {
+            out.push_back(c);
         } else if (c == ' ') {
-            escaped << '+';
+            out.push_back('+');
         } else {
-            // Encode other characters
-            escaped << '%' << std::setw(2) << static_cast<unsigned int>(static_cast<unsigned char>(c));
+            char encoded[3] = {'%', digits[uc >> 4], digits[uc & 0x0F]};
+            out.append(encoded, 3);
         }
     }
-
-    return escaped.str();
 }
 
 // Example usage:
@@ -2072,50 +2281,21 @@ std::string GiString::url_decode(const std::string& str) {
  * @return The Base64-encoded string.
  */
 std::string GiString::base64_encode(const std::string& str) {
-    // Base64 characters table
-    const std::string base64_chars =
-        "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-        "abcdefghijklmnopqrstuvwxyz"
-        "0123456789+/";
-
-    // Convert string to bytes
-    std::vector<unsigned char> bytes(str.begin(), str.end());
-
-    std::string encoded;
-    int i = 0;
-    unsigned char char_array_3[3];
-    unsigned char char_array_4[4];
-
-    for (auto& byte : bytes) {
-        char_array_3[i++] = byte;
-        if (i == 3) {
-            char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-            char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-            char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
-            char_array_4[3] = char_array_3[2] & 0x3f;
-
-            for (i = 0; i < 4; ++i)
-                encoded += base64_chars[char_array_4[i]];
-            i = 0;
-        }
-    }
-
-    if (i) {
-        for (int j = i; j < 3; ++j)
-            char_array_3[j] = '\0';
-
-        char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-        char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-        char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
-
-        for (int j = 0; j < i + 1; ++j)
-            encoded += base64_chars[char_array_4[j]];
-
-        while (i++ < 3)
-            encoded += '=';
-    }
+    std::string result;
+    result.reserve((str.size() + 2) / 3 * 4);
+    base64_encode(str, result);
+    return result;
+}
 
-    return encoded;
+/**
+ * @brief Encodes a string to Base64, appending the result to an output sink.
+ *
+ * @param str The input string to encode.
+ * @param out The sink the result is appended to.
+ */
+void GiString::base64_encode(const std::string& str, Appender out) {
+    out.reserve((str.size() + 2) / 3 * 4);
+    GiStringCore::base64_encode(str, out);
 }
 
 // Example usage:
@@ -2223,19 +2403,21 @@ std::string GiString::capitalize_each_word(const std::string& str) {
         throw std::invalid_argument("Input string is empty (GiString::capitalize_each_word)");
     }
     
-    std::string result = str;
+    std::string result;
+    result.reserve(str.size());
     bool capitalizeNext = true; // Flag to capitalize next character
     
-    // Iterate over each character in the string
-    for (size_t i = 0; i < result.length(); ++i) {
-        if (std::isspace(result[i])) {
+    // Iterate over each code point in the string
+    for (size_t i = 0; i < str.length();) {
+        if (std::isspace(static_cast<unsigned char>(str[i]))) {
             capitalizeNext = true; // Set flag to capitalize next character if it's a space
-        } else {
-            if (capitalizeNext) {
-                result[i] = std::toupper(result[i]); // Capitalize the character
-                capitalizeNext = false; // Reset the flag
-            }
+        } else if (capitalizeNext) {
+            i += append_case_mapped(str, i, GiUnicode::CaseMapping::title, result); // Capitalize the character
+            capitalizeNext = false; // Reset the flag
+            continue;
         }
+        result.push_back(str[i]);
+        ++i;
     }
     
     return result;
@@ -2247,6 +2429,7 @@ std::string GiString::capitalize_each_word(const std::string& str) {
 // std::string result = gString->capitalize_each_word(input);
 // std::cout << "Capitalized each word: " << result << std::endl;
 // Output: "Hello World"
+// std::cout << gString->capitalize_each_word("łódź i ćma") << std::endl;  // Output: "Łódź I Ćma"
 
 
 
@@ -2340,11 +2523,8 @@ std::string GiString::difference(const std::string& str1, const std::string& str
     // Find the minimum length between the two strings
     size_t minLen = std::min(str1.length(), str2.length());
     
-    // Find the position where the strings differ
-    size_t diffPos = 0;
-    while (diffPos < minLen && str1[diffPos] == str2[diffPos]) {
-        ++diffPos;
-    }
+    // Find the position where the strings differ, 16 bytes at a time
+    size_t diffPos = first_mismatch(str1.data(), str2.data(), minLen);
 
     // Construct the difference string
     std::string diff;
@@ -2413,35 +2593,69 @@ bool GiString::is_subsequence(const std::string& str, const std::string& sequenc
 // Output: "Is subsequence? Yes"
 
 
+/**
+ * @brief Calculates the Levenshtein (edit) distance between two strings.
+ *
+ * @param s1 The first string.
+ * @param s2 The second string.
+ * @return The minimum number of single-character insertions, deletions and substitutions.
+ */
 int GiString::levenshtein_distance(const std::string& s1, const std::string& s2) {
-    int len1 = s1.size();
-    int len2 = s2.size();
-    
-    std::vector<std::vector<int>> dp(len1 + 1, std::vector<int>(len2 + 1));
-    
-    for (int i = 0; i <= len1; ++i) {
-        dp[i][0] = i;
-    }
-    
-    for (int j = 0; j <= len2; ++j) {
-        dp[0][j] = j;
-    }
-    
-    for (int i = 1; i <= len1; ++i) {
-        for (int j = 1; j <= len2; ++j) {
-            int cost = (s1[i - 1] == s2[j - 1]) ? 0 : 1;
-            
-            dp[i][j] = std::min({
-                dp[i - 1][j] + 1,         // Usunięcie
-                dp[i][j - 1] + 1,         // Dodanie
-                dp[i - 1][j - 1] + cost   // Zamiana
-            });
+    return levenshtein_distance(s1, s2, std::pmr::get_default_resource());
+}
+
+namespace {
+    // Two-row Levenshtein DP; rows must hold 2 * (min(|s1|, |s2|) + 1) ints
+    int levenshtein_rows(std::string_view s1, std::string_view s2, int* rows) {
+        std::string_view longer = s1.size() >= s2.size() ? s1 : s2;
+        std::string_view shorter = s1.size() >= s2.size() ? s2 : s1;
+        int len = static_cast<int>(shorter.size());
+
+        int* previous = rows;
+        int* current = rows + len + 1;
+        for (int j = 0; j <= len; ++j) {
+            previous[j] = j;
+        }
+
+        for (size_t i = 1; i <= longer.size(); ++i) {
+            current[0] = static_cast<int>(i);
+            for (int j = 1; j <= len; ++j) {
+                int cost = (longer[i - 1] == shorter[j - 1]) ? 0 : 1;
+                current[j] = std::min({
+                    previous[j] + 1,         // Deletion
+                    current[j - 1] + 1,      // Insertion
+                    previous[j - 1] + cost   // Substitution
+                });
+            }
+            std::swap(previous, current);
         }
+
+        return previous[len];
     }
-    
-    return dp[len1][len2];
 }
 
+/**
+ * @brief Calculates the Levenshtein distance, allocating the DP rows from a memory resource.
+ *
+ * Only two rows of the DP table are kept, so the scratch space is O(min(|s1|, |s2|)).
+ *
+ * @param s1 The first string.
+ * @param s2 The second string.
+ * @param resource The memory resource used for the DP rows.
+ * @return The minimum number of single-character insertions, deletions and substitutions.
+ */
+int GiString::levenshtein_distance(const std::string& s1, const std::string& s2, std::pmr::memory_resource* resource) {
+    size_t len = std::min(s1.size(), s2.size());
+    std::pmr::vector<int> rows(2 * (len + 1), 0, resource);
+    return levenshtein_rows(s1, s2, rows.data());
+}
+
+// Example usage:
+// GiString::Arena arena;
+// int distance = gString.levenshtein_distance("kitten", "sitting", &arena);
+// std::cout << "Distance: " << distance << std::endl;
+// Output: "Distance: 3"
+
 
 
 
@@ -2634,16 +2848,9 @@ std::string GiString::random_string(size_t length) {
     // Define characters that can be used in the random string
     const std::string charset = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
 
-    // Initialize random number generator
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, charset.length() - 1);
-
     // Generate random string
-    std::string randomStr;
-    for (size_t i = 0; i < length; ++i) {
-        randomStr += charset[dis(gen)];
-    }
+    std::string randomStr(length, '\0');
+    GiRandom::local().fill(&randomStr[0], length, charset);
 
     return randomStr;
 }
@@ -2716,22 +2923,8 @@ std::string GiString::unquote(const std::string& str) {
  * @throws std::invalid_argument If the input string is empty or the list of sensitive characters is empty.
  */
 std::string GiString::mask_sensitive(const std::string& str, const std::string& sensitiveChars, char maskChar = '*') {
-    // Check if the input string is empty
-    if (str.empty()) {
-        throw std::invalid_argument("Input string is empty (GiString::mask_sensitive)");
-    }
-
-    // Check if the list of sensitive characters is empty
-    if (sensitiveChars.empty()) {
-        throw std::invalid_argument("List of sensitive characters is empty (GiString::mask_sensitive)");
-    }
-
-    // Mask sensitive characters in the string
     std::string maskedStr = str;
-    for (char c : sensitiveChars) {
-        std::replace(maskedStr.begin(), maskedStr.end(), c, maskChar);
-    }
-
+    inplace::mask_sensitive(maskedStr, sensitiveChars, maskChar);
     return maskedStr;
 }
 
@@ -2795,16 +2988,7 @@ size_t GiString::line_count(const std::string& str) {
         throw std::invalid_argument("Input string is empty (GiString::line_count)");
     }
 
-    std::stringstream ss(str);
-    size_t count = 0;
-    std::string line;
-
-    // Count the number of lines in the string
-    while (std::getline(ss, line)) {
-        ++count;
-    }
-
-    return count;
+    return static_cast<size_t>(TextStats(str.data(), str.size()).lines());
 }
 
 // Example usage:
@@ -2829,24 +3013,7 @@ char GiString::least_common_char(const std::string& str) {
         throw std::invalid_argument("Input string is empty (GiString::least_common_char)");
     }
 
-    std::unordered_map<char, int> charCount;
-
-    // Count occurrences of each character in the string
-    for (char c : str) {
-        ++charCount[c];
-    }
-
-    // Find the least common character
-    char leastCommon = str[0];
-    int minCount = charCount[str[0]];
-    for (const auto& pair : charCount) {
-        if (pair.second < minCount) {
-            minCount = pair.second;
-            leastCommon = pair.first;
-        }
-    }
-
-    return leastCommon;
+    return TextStats(str.data(), str.size()).least_common_char();
 }
 
 // Example usage:
@@ -2872,24 +3039,7 @@ char GiString::most_common_char(const std::string& str) {
         throw std::invalid_argument("Input string is empty (GiString::most_common_char)");
     }
 
-    std::unordered_map<char, int> charCount;
-
-    // Count occurrences of each character in the string
-    for (char c : str) {
-        ++charCount[c];
-    }
-
-    // Find the most common character
-    char mostCommon = str[0];
-    int maxCount = charCount[str[0]];
-    for (const auto& pair : charCount) {
-        if (pair.second > maxCount) {
-            maxCount = pair.second;
-            mostCommon = pair.first;
-        }
-    }
-
-    return mostCommon;
+    return TextStats(str.data(), str.size()).most_common_char();
 }
 
 // Example usage:
@@ -2990,6 +3140,180 @@ int GiString::roman_to_int(const std::string& s) {
 
 
 
+namespace {
+    // Byte class lookup for the whitespace engine, plus the explicit byte list used by the SIMD compares
+    struct WhitespaceClass {
+        bool table[256] = {};
+        unsigned char bytes[8] = {};
+        size_t count = 0;
+        bool vectorizable = true;
+
+        explicit WhitespaceClass(const std::string& set) {
+            for (char c : set) {
+                unsigned char b = static_cast<unsigned char>(c);
+                if (table[b]) {
+                    continue;
+                }
+                table[b] = true;
+                if (count < sizeof(bytes)) {
+                    bytes[count++] = b;
+                } else {
+                    vectorizable = false;
+                }
+            }
+        }
+    };
+
+    inline size_t count_trailing_zeros(uint64_t mask) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, mask);
+        return index;
+#else
+        return static_cast<size_t>(__builtin_ctzll(mask));
+#endif
+    }
+
+#if defined(__AVX2__)
+    // Bit i of the result is set when p[i] belongs to the class, for a 64-byte block
+    inline uint64_t classify_block(const unsigned char* p, const WhitespaceClass& cls) {
+        __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+        __m256i lo_hits = _mm256_setzero_si256();
+        __m256i hi_hits = _mm256_setzero_si256();
+        for (size_t k = 0; k < cls.count; ++k) {
+            __m256i needle = _mm256_set1_epi8(static_cast<char>(cls.bytes[k]));
+            lo_hits = _mm256_or_si256(lo_hits, _mm256_cmpeq_epi8(lo, needle));
+            hi_hits = _mm256_or_si256(hi_hits, _mm256_cmpeq_epi8(hi, needle));
+        }
+        return static_cast<uint32_t>(_mm256_movemask_epi8(lo_hits)) |
+               (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(hi_hits))) << 32);
+    }
+    const size_t whitespace_block = 64;
+#elif defined(__SSE2__)
+    inline uint64_t classify_block(const unsigned char* p, const WhitespaceClass& cls) {
+        __m128i lanes[4];
+        __m128i hits[4];
+        for (int l = 0; l < 4; ++l) {
+            lanes[l] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * l));
+            hits[l] = _mm_setzero_si128();
+        }
+        for (size_t k = 0; k < cls.count; ++k) {
+            __m128i needle = _mm_set1_epi8(static_cast<char>(cls.bytes[k]));
+            for (int l = 0; l < 4; ++l) {
+                hits[l] = _mm_or_si128(hits[l], _mm_cmpeq_epi8(lanes[l], needle));
+            }
+        }
+        uint64_t mask = 0;
+        for (int l = 0; l < 4; ++l) {
+            mask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(hits[l]))) << (16 * l);
+        }
+        return mask;
+    }
+    const size_t whitespace_block = 64;
+#else
+    inline uint64_t classify_block(const unsigned char* p, const WhitespaceClass& cls) {
+        uint64_t mask = 0;
+        for (size_t i = 0; i < 64; ++i) {
+            mask |= static_cast<uint64_t>(cls.table[p[i]]) << i;
+        }
+        return mask;
+    }
+    const size_t whitespace_block = 64;
+#endif
+
+    // Returns the first index >= i whose class equals want_whitespace, or size
+    size_t find_whitespace_edge(const unsigned char* p, size_t i, size_t size, const WhitespaceClass& cls, bool want_whitespace) {
+        if (cls.vectorizable) {
+            while (i + whitespace_block <= size) {
+                uint64_t mask = classify_block(p + i, cls);
+                if (!want_whitespace) {
+                    mask = ~mask;
+                }
+                if (mask != 0) {
+                    return i + count_trailing_zeros(mask);
+                }
+                i += whitespace_block;
+            }
+        }
+        while (i < size && cls.table[p[i]] != want_whitespace) {
+            ++i;
+        }
+        return i;
+    }
+}
+
+/**
+ * @brief Configurable whitespace cleanup shared by all whitespace-collapsing functions.
+ *
+ * Input is scanned in 64-byte blocks that are classified with SIMD compares (SSE2, or AVX2
+ * when available); runs of non-whitespace are copied with bulk appends and each whitespace
+ * run is handled according to the options. Unlike the legacy wrappers, an empty input is
+ * not an error.
+ *
+ * @param str The input string.
+ * @param options Which bytes count as whitespace and how runs are rewritten.
+ * @return The cleaned string.
+ */
+std::string GiString::clean_whitespace(const std::string& str, const WhitespaceOptions& options) {
+    std::string result;
+    result.reserve(str.size());
+    clean_whitespace(str.data(), str.size(), options, result);
+    return result;
+}
+
+/**
+ * @brief Configurable whitespace cleanup writing into a caller-owned buffer.
+ *
+ * @param data Pointer to the input bytes.
+ * @param size Number of input bytes.
+ * @param options Which bytes count as whitespace and how runs are rewritten.
+ * @param output The string the result is appended to.
+ */
+void GiString::clean_whitespace(const char* data, size_t size, const WhitespaceOptions& options, std::string& output) {
+    const WhitespaceClass cls(options.whitespace);
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+
+    size_t i = 0;
+    while (i < size) {
+        // Bulk-copy the run of non-whitespace bytes
+        size_t run_start = find_whitespace_edge(p, i, size, cls, true);
+        output.append(data + i, run_start - i);
+        if (run_start == size) {
+            break;
+        }
+
+        size_t run_end = find_whitespace_edge(p, run_start, size, cls, false);
+        i = run_end;
+
+        if (options.trim && (run_start == 0 || run_end == size)) {
+            continue;
+        }
+        if (!options.collapse) {
+            output.append(data + run_start, run_end - run_start);
+            continue;
+        }
+        if (options.keep_newlines) {
+            size_t newlines = static_cast<size_t>(std::count(data + run_start, data + run_end, '\n'));
+            if (newlines > 0) {
+                output.append(newlines, '\n');
+                continue;
+            }
+        }
+        output += options.replacement;
+    }
+}
+
+// Example usage:
+// GiString gs;
+// GiString::WhitespaceOptions options;
+// options.trim = true;
+// options.keep_newlines = true;
+// std::string result = gs.clean_whitespace("  Hello \t world \n\n  again  ", options);
+// std::cout << result << std::endl;
+// Output: "Hello world\n\nagain"
+
+
 /**
  * @brief Normalizes whitespace in a string by replacing sequences of whitespace characters with a single space.
  * 
@@ -3004,28 +3328,7 @@ std::string GiString::normalize_whitespace(const std::string& str) {
         throw std::invalid_argument("Input string is empty (GiString::normalize_whitespace)");
     }
 
-    std::string result;
-
-    // Flag to indicate if the previous character was a whitespace
-    bool prevIsWhitespace = false;
-
-    // Iterate over each character in the string
-    for (char c : str) {
-        // If the current character is a whitespace and the previous character was not a whitespace,
-        // add a space to the result string
-        if (std::isspace(c)) {
-            if (!prevIsWhitespace) {
-                result += ' ';
-                prevIsWhitespace = true;
-            }
-        } else {
-            // If the current character is not a whitespace, add it to the result string
-            result += c;
-            prevIsWhitespace = false;
-        }
-    }
-
-    return result;
+    return clean_whitespace(str, WhitespaceOptions());
 }
 
 // Example usage:
@@ -3080,20 +3383,62 @@ std::string GiString::remove_punctuation(const std::string& str) {
  * @throws std::invalid_argument If the input string is empty.
  */
 std::string GiString::to_hex(const std::string& str) {
-    // Check if the input string is empty
-    if (str.empty()) {
-        throw std::invalid_argument("Input string is empty (GiString::to_hex)");
-    }
+    std::string result;
+    result.reserve(str.size() * 2);
+    to_hex(str, result);
+    return result;
+}
 
-    std::stringstream ss;
+namespace {
+    // to_hex's historical format: at least two digits per byte, with bytes above 0x7F
+    // sign-extended to a full unsigned int where char is signed
+    template <typename Out>
+    void append_legacy_hex(std::string_view str, Out& out) {
+        static const char digits[] = "0123456789abcdef";
+        for (char c : str) {
+            unsigned int value = static_cast<unsigned int>(static_cast<int>(c));
+            char encoded[2 * sizeof(unsigned int)];
+            size_t length = 0;
+            do {
+                encoded[length++] = digits[value & 0x0F];
+                value >>= 4;
+            } while (value != 0);
+            if (length == 1) {
+                encoded[length++] = '0';
+            }
+            while (length > 0) {
+                out.push_back(encoded[--length]);
+            }
+        }
+    }
 
-    // Convert each character of the input string to hexadecimal representation
-    for (char c : str) {
-        // Convert the character to hexadecimal and append it to the stringstream
-        ss << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(c);
+    size_t legacy_hex_length(std::string_view str) {
+        size_t length = 0;
+        for (char c : str) {
+            length += static_cast<int>(c) < 0 ? 2 * sizeof(unsigned int) : 2;
+        }
+        return length;
     }
+}
 
-    return ss.str();
+/**
+ * @brief Converts a string to hexadecimal, appending the result to an output sink.
+ *
+ * Bytes are formatted exactly as by to_hex(const std::string&), including the
+ * sign-extended form of bytes above 0x7F on platforms where char is signed.
+ *
+ * @param str The input string to convert.
+ * @param out The sink the result is appended to.
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::to_hex(const std::string& str, Appender out) {
+    if (str.empty()) {
+        throw std::invalid_argument("Input string is empty (GiString::to_hex)");
+    }
+
+    out.reserve(str.size() * 2);
+    append_legacy_hex(str, out);
 }
 
 // Example usage:
@@ -3278,22 +3623,8 @@ bool GiString::bracket_check(const std::string& str) {
  * @throws std::invalid_argument If the input string is empty.
  */
 std::string GiString::squeeze(const std::string& str) {
-    // Check if the input string is empty
-    if (str.empty()) {
-        throw std::invalid_argument("Input string is empty (GiString::squeeze)");
-    }
-
-    std::string result;
-
-    // Iterate over each character in the string
-    for (size_t i = 0; i < str.length(); ++i) {
-        // If the current character is different from the next character (or it's the last character),
-        // add it to the result string
-        if (str[i] != str[i + 1] || i == str.length() - 1) {
-            result += str[i];
-        }
-    }
-
+    std::string result = str;
+    inplace::squeeze(result);
     return result;
 }
 
@@ -3350,13 +3681,234 @@ std::string GiString::expand_tabs(const std::string& str, size_t tabWidth = 4) {
 // std::cout << "Expanded string: " << result << std::endl;
 // Output: "hello   world       !"
 
+/**
+ * @brief Creates a streaming reflow engine.
+ *
+ * @param width The maximum display width of each line, in terminal columns.
+ * @param mode Greedy fills lines left to right; Justify pads inner gaps so full lines reach the width.
+ * @param sink Callback receiving the reflowed output in pieces.
+ * @param overflow What to do with a word wider than the line: keep it on its own line, break it, or throw.
+ *
+ * @throws std::invalid_argument If the width is 0 or the sink is empty.
+ */
+GiString::Reflow::Reflow(size_t width, Mode mode, Sink sink, Overflow overflow)
+    : width_(width), mode_(mode), overflow_(overflow), sink_(std::move(sink)) {
+    if (width_ == 0) {
+        throw std::invalid_argument("Width must be greater than 0 (GiString::Reflow)");
+    }
+    if (!sink_) {
+        throw std::invalid_argument("Sink must be callable (GiString::Reflow)");
+    }
+    line_.reserve(width_ + 1);
+}
+
+/**
+ * @brief Consumes the next chunk of text.
+ *
+ * Chunks may split words and UTF-8 sequences anywhere; the partial word is carried over
+ * in a reused buffer. Two or more consecutive newlines start a new paragraph.
+ *
+ * @param data Pointer to the chunk bytes.
+ * @param size Number of bytes in the chunk.
+ *
+ * @throws std::invalid_argument If the overflow policy is Throw and a word is wider than the line.
+ */
+void GiString::Reflow::feed(const char* data, size_t size) {
+    size_t i = 0;
+    while (i < size) {
+        char c = data[i];
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f') {
+            if (!word_.empty()) {
+                end_word();
+            }
+            if (c == '\n') {
+                ++newlines_;
+            }
+            ++i;
+            continue;
+        }
+
+        // A paragraph break is only meaningful between two pieces of text
+        if (newlines_ >= 2 && (!line_.empty() || emitted_)) {
+            paragraph_pending_ = true;
+        }
+        newlines_ = 0;
+
+        // Copy the whole run of word bytes at once
+        size_t run = i;
+        while (run < size && data[run] != ' ' && data[run] != '\t' && data[run] != '\n' &&
+               data[run] != '\r' && data[run] != '\v' && data[run] != '\f') {
+            ++run;
+        }
+        word_.append(data + i, run - i);
+        i = run;
+    }
+}
+
+/**
+ * @brief Consumes the next chunk of text.
+ *
+ * @param chunk The chunk to consume.
+ */
+void GiString::Reflow::feed(const std::string& chunk) {
+    feed(chunk.data(), chunk.size());
+}
+
+/**
+ * @brief Consumes a whole input stream in fixed-size chunks.
+ *
+ * @param in The stream to read from until EOF.
+ * @param chunk_size Number of bytes read per step.
+ *
+ * @throws std::invalid_argument If chunk_size is 0.
+ */
+void GiString::Reflow::feed(std::istream& in, size_t chunk_size) {
+    if (chunk_size == 0) {
+        throw std::invalid_argument("Chunk size must be greater than 0 (GiString::Reflow::feed)");
+    }
+
+    std::vector<char> buffer(chunk_size);
+    while (in) {
+        in.read(buffer.data(), static_cast<std::streamsize>(chunk_size));
+        std::streamsize got = in.gcount();
+        if (got <= 0) {
+            break;
+        }
+        feed(buffer.data(), static_cast<size_t>(got));
+    }
+}
+
+/**
+ * @brief Flushes the pending word and the last line. The engine can be reused afterwards.
+ */
+void GiString::Reflow::finish() {
+    if (!word_.empty()) {
+        end_word();
+    }
+    flush_line(true);
+    newlines_ = 0;
+    paragraph_pending_ = false;
+    emitted_ = false;
+}
+
+void GiString::Reflow::end_word() {
+    if (paragraph_pending_) {
+        flush_line(true);
+        sink_("\n", 1);
+        paragraph_pending_ = false;
+    }
+
+    size_t width = GiUnicode::display_width(word_.data(), word_.size());
+    if (width > width_ && overflow_ != Overflow::Allow) {
+        if (overflow_ == Overflow::Throw) {
+            throw std::invalid_argument("Word length exceeds maximum length (GiString::Reflow)");
+        }
+        break_word();
+    } else {
+        place_word(word_.data(), word_.size(), width);
+    }
+    word_.clear();
+}
+
+void GiString::Reflow::place_word(const char* data, size_t size, size_t width) {
+    if (!line_.empty() && line_width_ + 1 + width > width_) {
+        flush_line(false);
+    }
+    if (!line_.empty()) {
+        gaps_.push_back(line_.size());
+        line_ += ' ';
+        ++line_width_;
+    }
+    line_.append(data, size);
+    line_width_ += width;
+}
+
+void GiString::Reflow::break_word() {
+    // Fill what is left of the current line first, then continue on full lines
+    size_t room = line_.empty() ? width_ : (line_width_ + 1 < width_ ? width_ - line_width_ - 1 : 0);
+    if (room == 0) {
+        flush_line(false);
+        room = width_;
+    }
+
+    size_t start = 0;
+    size_t piece_width = 0;
+    size_t i = 0;
+    while (i < word_.size()) {
+        size_t length;
+        char32_t cp = GiUnicode::decode_utf8(word_.data() + i, word_.size() - i, length);
+        size_t cp_width = GiUnicode::codepoint_width(cp);
+        if (piece_width + cp_width > room && i > start) {
+            place_word(word_.data() + start, i - start, piece_width);
+            flush_line(false);
+            start = i;
+            piece_width = 0;
+            room = width_;
+        }
+        piece_width += cp_width;
+        i += length;
+    }
+    if (i > start) {
+        place_word(word_.data() + start, i - start, piece_width);
+    }
+}
+
+void GiString::Reflow::flush_line(bool last) {
+    static const char spaces[] = "                                ";
+    const size_t spaces_size = sizeof(spaces) - 1;
+
+    if (line_.empty()) {
+        return;
+    }
+    if (emitted_) {
+        sink_("\n", 1);
+    }
+
+    if (mode_ == Mode::Justify && !last && !gaps_.empty() && line_width_ < width_) {
+        size_t extra = width_ - line_width_;
+        size_t per_gap = extra / gaps_.size();
+        size_t remainder = extra % gaps_.size();
+        size_t pos = 0;
+
+        for (size_t g = 0; g < gaps_.size(); ++g) {
+            // Write the text up to and including the single separating space, then the padding
+            sink_(line_.data() + pos, gaps_[g] + 1 - pos);
+            size_t pad = per_gap + (g < remainder ? 1 : 0);
+            while (pad > 0) {
+                size_t n = std::min(pad, spaces_size);
+                sink_(spaces, n);
+                pad -= n;
+            }
+            pos = gaps_[g] + 1;
+        }
+        sink_(line_.data() + pos, line_.size() - pos);
+    } else {
+        sink_(line_.data(), line_.size());
+    }
+
+    emitted_ = true;
+    line_.clear();
+    gaps_.clear();
+    line_width_ = 0;
+}
+
+// Example usage:
+// std::ifstream report("report.txt");
+// GiString::Reflow reflow(72, GiString::Reflow::Mode::Justify,
+//                         [](const char* data, size_t size) { std::cout.write(data, size); });
+// reflow.feed(report);
+// reflow.finish();
+
 /**
  * @brief Breaks the text into lines with a specified maximum length.
- * 
+ *
+ * Runs of whitespace are collapsed, widths are measured in display columns, and words
+ * longer than a line are broken across lines.
+ *
  * @param text The input text to be wrapped.
  * @param max_length The maximum length of each line.
  * @return The wrapped text with lines of maximum length.
- * 
+ *
  * @throws std::invalid_argument If the maximum length is less than or equal to 0.
  */
 std::string GiString::wrap_text(const std::string& text, size_t max_length) {
@@ -3364,37 +3916,16 @@ std::string GiString::wrap_text(const std::string& text, size_t max_length) {
     if (max_length <= 0) {
         throw std::invalid_argument("Maximum length must be greater than 0 (GiString::wrap_text)");
     }
-    
+
     std::string wrapped_text;
-    size_t length = text.length();
-    size_t start = 0;
-    
-    while (start < length) {
-        // Find the end index of the current line
-        size_t end = std::min(start + max_length, length);
-        
-        // Find the last space within the maximum length
-        while (end > start && !std::isspace(text[end - 1])) {
-            --end;
-        }
-        
-        // Append the current line to the wrapped text
-        wrapped_text += text.substr(start, end - start);
-        
-        // Add a newline character if not at the end of the text
-        if (end < length) {
-            wrapped_text += '\n';
-        }
-        
-        // Move to the next line
-        start = end;
-        
-        // Skip leading spaces in the next line
-        while (start < length && std::isspace(text[start])) {
-            ++start;
-        }
-    }
-    
+    wrapped_text.reserve(text.size() + text.size() / max_length + 1);
+
+    Reflow reflow(max_length, Reflow::Mode::Greedy,
+                  [&wrapped_text](const char* data, size_t size) { wrapped_text.append(data, size); },
+                  Reflow::Overflow::Break);
+    reflow.feed(text);
+    reflow.finish();
+
     return wrapped_text;
 }
 
@@ -3409,11 +3940,13 @@ std::string GiString::wrap_text(const std::string& text, size_t max_length) {
 
 /**
  * @brief Justifies the text to both left and right sides by adding appropriate spaces between words.
- * 
+ *
+ * The last line of each paragraph is left-aligned.
+ *
  * @param text The input text to be justified.
  * @param max_length The maximum length of each line.
  * @return The justified text with evenly spaced words.
- * 
+ *
  * @throws std::invalid_argument If the maximum length is less than or equal to 0.
  * @throws std::invalid_argument If any word in the text exceeds the maximum length.
  */
@@ -3423,54 +3956,14 @@ std::string GiString::text_justify(const std::string& text, size_t max_length) {
         throw std::invalid_argument("Maximum length must be greater than 0 (GiString::text_justify)");
     }
 
-    std::vector<std::string> words;
-    std::istringstream iss(text);
-    std::string word;
-
-    // Split the text into words
-    while (iss >> word) {
-        if (word.length() > max_length) {
-            throw std::invalid_argument("Word length exceeds maximum length (GiString::text_justify)");
-        }
-        words.push_back(word);
-    }
-
     std::string justified_text;
-    size_t line_length = 0;
-    size_t num_words = words.size();
-
-    for (size_t i = 0; i < num_words; ++i) {
-        // Add word to the line if it fits
-        if (line_length + words[i].length() <= max_length) {
-            justified_text += words[i];
-            line_length += words[i].length();
-
-            // Add space if not the last word in the line
-            if (i < num_words - 1) {
-                justified_text += ' ';
-                ++line_length;
-            }
-        } else {
-            // Calculate the number of spaces to add for justification
-            size_t num_spaces = max_length - line_length;
-            size_t space_between_words = num_words > 1 ? num_spaces / (num_words - 1) : 0;
-            size_t extra_spaces = num_spaces % (num_words - 1);
-
-            // Add spaces between words
-            for (size_t j = 0; j < num_words - 1; ++j) {
-                justified_text += words[j];
-                justified_text.append(space_between_words + (j < extra_spaces), ' ');
-            }
-
-            // Add the last word without space
-            justified_text += words[num_words - 1];
+    justified_text.reserve(text.size() + text.size() / 4);
 
-            // Reset line length for the next line
-            line_length = 0;
-            justified_text += '\n';
-            num_words = 0;
-        }
-    }
+    Reflow reflow(max_length, Reflow::Mode::Justify,
+                  [&justified_text](const char* data, size_t size) { justified_text.append(data, size); },
+                  Reflow::Overflow::Throw);
+    reflow.feed(text);
+    reflow.finish();
 
     return justified_text;
 }
@@ -3905,25 +4398,13 @@ std::vector<std::string> GiString::double_metaphone(const std::string& str) {
  * @brief Encodes or decodes a string using the ROT13 cipher.
  * 
  * @param str The input string to encode or decode.
- * @param encode True to encode the string, false to decode it.
+ * @param encode True to encode the string, false to decode it; both give the same result.
  * @return The encoded or decoded string.
  */
-std::string GiString::rot13(const std::string& str, bool encode) {
-    std::string result;
-    for (char ch : str) {
-        // Encode uppercase letters
-        if (std::isupper(ch)) {
-            result += (encode ? ((ch - 'A' + 13) % 26 + 'A') : ((ch - 'A' + 13) % 26 + 'A'));
-        }
-        // Encode lowercase letters
-        else if (std::islower(ch)) {
-            result += (encode ? ((ch - 'a' + 13) % 26 + 'a') : ((ch - 'a' + 13) % 26 + 'a'));
-        }
-        // Leave non-alphabetic characters unchanged
-        else {
-            result += ch;
-        }
-    }
+std::string GiString::rot13(const std::string& str, [[maybe_unused]] bool encode) {
+    // ROT13 is its own inverse, so encode and decode are the same operation
+    std::string result = str;
+    inplace::rot13(result);
     return result;
 }
 
@@ -3991,13 +4472,8 @@ std::string GiString::caesar_cipher(const std::string& str, int shift, bool enco
  * @return The encoded or decoded string.
  */
 std::string GiString::xor_cipher(const std::string& str, const std::string& key) {
-    std::string result;
-    // Get the length of the key
-    size_t keyLength = key.length();
-    // Encode or decode each character in the string using XOR with the corresponding key character
-    for (size_t i = 0; i < str.length(); ++i) {
-        result += str[i] ^ key[i % keyLength];
-    }
+    std::string result = str;
+    inplace::xor_cipher(result, key);
     return result;
 }
 
@@ -4162,8 +4638,8 @@ std::string GiString::unquote_wrap(const std::string& str) {
  * @return The string with extra spaces removed.
  */
 std::string GiString::remove_extra_spaces(const std::string& str) {
-    // Use a regular expression to replace multiple consecutive spaces with a single space
-    return std::regex_replace(str, std::regex("\\s+"), " ");
+    // Replace runs of whitespace with a single space
+    return clean_whitespace(str, WhitespaceOptions());
 }
 
 // Example usage:
@@ -4411,20 +4887,23 @@ std::string GiString::transpose(const std::string& text) {
 
 /**
  * @brief Checks if two strings are anagrams.
+ *
+ * Compares byte histograms instead of sorting, so the cost is O(n).
  * 
  * @param str1 The first input string.
  * @param str2 The second input string.
  * @return True if the strings are anagrams, false otherwise.
  */
 bool GiString::anagram_check(const std::string& str1, const std::string& str2) {
-    // Sort both strings
-    std::string sorted_str1 = str1;
-    std::string sorted_str2 = str2;
-    std::sort(sorted_str1.begin(), sorted_str1.end());
-    std::sort(sorted_str2.begin(), sorted_str2.end());
+    if (str1.size() != str2.size()) {
+        return false;
+    }
 
-    // Compare the sorted strings
-    return sorted_str1 == sorted_str2;
+    size_t counts1[256] = {};
+    size_t counts2[256] = {};
+    byte_histogram(str1.data(), str1.size(), counts1);
+    byte_histogram(str2.data(), str2.size(), counts2);
+    return std::memcmp(counts1, counts2, sizeof(counts1)) == 0;
 }
 
 // Example usage:
@@ -4589,16 +5068,7 @@ std::string GiString::insert_every_n(const std::string& str, const std::string&
  * @throws std::invalid_argument If the input string is empty.
  */
 std::string GiString::substring_after(const std::string& str, const std::string& separator) {
-    if (str.empty()) {
-        throw std::invalid_argument("substring_after: Input string is empty");
-    }
-
-    size_t pos = str.find(separator);
-    if (pos == std::string::npos) {
-        return ""; // Separator not found
-    }
-
-    return str.substr(pos + separator.length());
+    return std::string(views::substring_after(str, separator));
 }
 
 // Example usage:
@@ -4619,16 +5089,7 @@ std::string GiString::substring_after(const std::string& str, const std::string&
  * @throws std::invalid_argument If the input string is empty.
  */
 std::string GiString::substring_before(const std::string& str, const std::string& separator) {
-    if (str.empty()) {
-        throw std::invalid_argument("substring_before: Input string is empty.");
-    }
-
-    size_t pos = str.find(separator);
-    if (pos == std::string::npos) {
-        return str; // Separator not found, return the original string
-    }
-
-    return str.substr(0, pos);
+    return std::string(views::substring_before(str, separator));
 }
 
 // Example usage:
@@ -4648,18 +5109,7 @@ std::string GiString::substring_before(const std::string& str, const std::string
  * @throws std::invalid_argument If the input string is empty or if the delimiters are not found in the input string.
  */
 std::string GiString::substring_between(const std::string& str, const std::string& startDelim, const std::string& endDelim) {
-    size_t startPos = str.find(startDelim);
-    if (startPos == std::string::npos) {
-        throw std::invalid_argument("substring_between: Start delimiter not found in the input string.");
-    }
-
-    startPos += startDelim.length();
-    size_t endPos = str.find(endDelim, startPos);
-    if (endPos == std::string::npos) {
-        throw std::invalid_argument("substring_between: End delimiter not found in the input string.");
-    }
-
-    return str.substr(startPos, endPos - startPos);
+    return std::string(views::substring_between(str, startDelim, endDelim));
 }
 
 // Example usage:
@@ -4751,13 +5201,8 @@ int GiString::nth_occurrence(const std::string& str, const std::string& target,
  * @param str The input string to remove the last character from.
  * @return The modified string after removing the last character, or an empty string if the input string is empty.
  */
-std::string GiString::chop(std::string str) {
-    if (str.empty()) {
-        throw std::invalid_argument("GiString::chop: Input string is empty");
-    }
-
-    str.pop_back();
-    return str;
+std::string GiString::chop(const std::string& str) {
+    return std::string(views::chop(str));
 }
 
 // Example usage:
@@ -4776,16 +5221,8 @@ std::string GiString::chop(std::string str) {
  * @return The string with the ensured prefix.
  * @throws std::invalid_argument If the input string is empty.
  */
-std::string GiString::ensure_prefix(std::string str, const std::string& prefix) {
-    if (str.empty()) {
-        throw std::invalid_argument("ensure_prefix: Input string is empty");
-    }
-
-    if (str.substr(0, prefix.length()) != prefix) {
-        str = prefix + str;
-    }
-
-    return str;
+std::string GiString::ensure_prefix(const std::string& str, const std::string& prefix) {
+    return views::ensure_prefix(str, prefix);
 }
 
 // Example usage:
@@ -4807,16 +5244,8 @@ std::string GiString::ensure_prefix(std::string str, const std::string& prefix)
  * @return The string with the ensured suffix.
  * @throws std::invalid_argument If the input string is empty.
  */
-std::string GiString::ensure_suffix(std::string str, const std::string& suffix) {
-    if (str.empty()) {
-        throw std::invalid_argument("ensure_suffix: Input string is empty.");
-    }
-
-    if (str.size() < suffix.size() || str.substr(str.size() - suffix.size()) != suffix) {
-        str += suffix;
-    }
-
-    return str;
+std::string GiString::ensure_suffix(const std::string& str, const std::string& suffix) {
+    return views::ensure_suffix(str, suffix);
 }
 
 // Example usage:
@@ -4842,15 +5271,7 @@ std::string GiString::ensure_suffix(std::string str, const std::string& suffix)
  * @throws std::invalid_argument If the input string is empty.
  */
 std::string GiString::remove_last(std::string str, const std::string& ch) {
-    if (str.empty()) {
-        throw std::invalid_argument("remove_last: Input string is empty.");
-    }
-
-    size_t found = str.rfind(ch);
-    if (found != std::string::npos) {
-        str.erase(found, ch.length());
-    }
-
+    inplace::remove_last(str, ch);
     return str;
 }
 
@@ -4875,13 +5296,7 @@ bool GiString::is_sorted(const std::string& str) {
         throw std::invalid_argument("is_sorted: Input string is empty.");
     }
 
-    for (size_t i = 0; i < str.length() - 1; ++i) {
-        if (str[i] > str[i + 1]) {
-            return false;
-        }
-    }
-
-    return true;
+    return chars_sorted(str.data(), str.size());
 }
 
 // Example usage:
@@ -4896,6 +5311,8 @@ bool GiString::is_sorted(const std::string& str) {
 /**
  * @brief Removes duplicate characters from a string, leaving only unique occurrences.
  *
+ * Seen bytes are tracked in a 256-bit set; the first occurrence of each is kept.
+ *
  * @param str The input string from which duplicates will be removed.
  * @return A string with only unique characters.
  * @throws std::invalid_argument If the input string is empty.
@@ -4905,13 +5322,8 @@ std::string GiString::unique(std::string str) {
         throw std::invalid_argument("GiString::unique: Error - input string is empty");
     }
 
-    std::string result = "";
-    for (char c : str) {
-        if (result.find(c) == std::string::npos) {
-            result += c;
-        }
-    }
-
+    std::string result;
+    append_first_occurrences(str, result);
     return result;
 }
 
@@ -4932,19 +5344,8 @@ std::string GiString::unique(std::string str) {
  * @throws std::invalid_argument If the input string is empty.
  */
 std::vector<std::string> GiString::split_lines(const std::string& str) {
-    if (str.empty()) {
-        throw std::invalid_argument("split_lines: Input string is empty.");
-    }
-
-    std::vector<std::string> lines;
-    std::istringstream iss(str);
-    std::string line;
-
-    while (std::getline(iss, line)) {
-        lines.push_back(line);
-    }
-
-    return lines;
+    std::vector<std::string_view> parts = views::split_lines(str);
+    return std::vector<std::string>(parts.begin(), parts.end());
 }
 
 // Example usage:
@@ -4969,15 +5370,9 @@ std::vector<std::string> GiString::split_lines(const std::string& str) {
  * and the second part contains characters starting from the index.
  * @throws std::invalid_argument If the index is out of range.
  */
-std::pair<std::string, std::string> GiString::split_at(std::string str,size_t index) {
-    if (index < 0 || index >= str.length()) {
-        throw std::invalid_argument("Index out of range: split_at");
-    }
-
-    std::string firstPart = str.substr(0, index);
-    std::string secondPart = str.substr(index);
-
-    return std::make_pair(firstPart, secondPart);
+std::pair<std::string, std::string> GiString::split_at(const std::string& str, size_t index) {
+    auto parts = views::split_at(str, index);
+    return std::make_pair(std::string(parts.first), std::string(parts.second));
 }
 
 // Example usage:
@@ -4997,24 +5392,8 @@ std::pair<std::string, std::string> GiString::split_at(std::string str,size_t in
  * @throws std::invalid_argument If the input string is empty.
  */
 std::vector<std::string> GiString::partition(const std::string& str, const std::string& separator) {
-    if (str.empty()) {
-        throw std::invalid_argument("GiString::partition: Input string is empty.");
-    }
-
-    std::vector<std::string> result;
-    size_t separatorPos = str.find(separator);
-
-    if (separatorPos == std::string::npos) {
-        result.push_back(str); // Separator not found, return the whole string
-        result.push_back("");  // Empty separator part
-        result.push_back("");  // Empty part after separator
-    } else {
-        result.push_back(str.substr(0, separatorPos));                 // Before separator
-        result.push_back(str.substr(separatorPos, separator.length())); // Separator
-        result.push_back(str.substr(separatorPos + separator.length())); // After separator
-    }
-
-    return result;
+    std::array<std::string_view, 3> parts = views::partition(str, separator);
+    return {std::string(parts[0]), std::string(parts[1]), std::string(parts[2])};
 }
 
 // Example usage:
@@ -5041,20 +5420,8 @@ std::vector<std::string> GiString::partition(const std::string& str, const std::
  */
 
 std::tuple<std::string, std::string, std::string> GiString::rpartition(const std::string& str, const std::string& delimiter) {
-    if (str.empty()) {
-        throw std::invalid_argument("GiString::rpartition: Error - Input string is empty.");
-    }
-
-    size_t delimiterPos = str.rfind(delimiter);
-    if (delimiterPos == std::string::npos) {
-        return std::make_tuple(str, "", "");
-    }
-
-    std::string part1 = str.substr(0, delimiterPos);
-    std::string part2 = delimiter;
-    std::string part3 = str.substr(delimiterPos + delimiter.length());
-
-    return std::make_tuple(part1, part2, part3);
+    auto parts = views::rpartition(str, delimiter);
+    return std::make_tuple(std::string(std::get<0>(parts)), std::string(std::get<1>(parts)), std::string(std::get<2>(parts)));
 }
 
 // Example usage:
@@ -5335,8 +5702,11 @@ std::string GiString::normalize_path(const std::string& path) {
 /**
  * @brief Shortens a string to a specified length, adding "..." at the end if it's shortened.
  *
+ * Length is measured in terminal columns and the string is only cut between grapheme
+ * clusters, so multi-byte characters and emoji sequences are never split.
+ *
  * @param str The input string to be shortened.
- * @param length The desired length of the shortened string.
+ * @param length The desired display width of the shortened string.
  * @return The shortened string with "..." added at the end if it's shortened.
  * @throws std::invalid_argument If the input string is empty or the length is less than 3.
  */
@@ -5348,10 +5718,11 @@ std::string GiString::ellipsis(const std::string& str, size_t length) {
         throw std::invalid_argument("ellipsis: Length should be at least 3!");
     }
 
-    if (str.length() <= length) {
+    if (GiUnicode::display_width(str) <= length) {
         return str;
     } else {
-        return str.substr(0, length - 3) + "...";
+        size_t width;
+        return str.substr(0, GiUnicode::fit_width(str.data(), str.size(), length - 3, width)) + "...";
     }
 }
 
@@ -5360,6 +5731,7 @@ std::string GiString::ellipsis(const std::string& str, size_t length) {
 // std::string input = "This is a long sentence that needs to be shortened.";
 // std::string result = giString.ellipsis(input, 20);
 // std::cout << "Shortened string: " << result << std::endl;
+// std::cout << giString.ellipsis("日本語のテキスト", 9) << std::endl;  // Output: "日本語..."
 
 
 
@@ -5496,6 +5868,8 @@ std::string GiString::decrement_number_suffix(const std::string& str, int decrem
 /**
  * @brief Changes the first letter of each word in a string to uppercase.
  *
+ * Words are separated by whitespace or '-'; non-ASCII letters are mapped to titlecase.
+ *
  * @param str The input string to convert to title case.
  * @return A new string with the first letter of each word capitalized.
  * @throws std::invalid_argument If the input string is empty.
@@ -5505,16 +5879,23 @@ std::string GiString::to_title_case(const std::string& str) {
         throw std::invalid_argument("to_title_case: Input string is empty.");
     }
 
-    std::string result = str;
+    std::string result;
+    result.reserve(str.size());
     bool make_upper = true;
 
-    for (char& c : result) {
-        if (make_upper && std::isalpha(c)) {
-            c = std::toupper(c);
+    for (size_t i = 0; i < str.size();) {
+        size_t length;
+        char32_t cp = GiUnicode::decode_utf8(str.data() + i, str.size() - i, length);
+        if (make_upper && is_cased_letter(cp)) {
+            i += append_case_mapped(str, i, GiUnicode::CaseMapping::title, result);
             make_upper = false;
-        } else if (std::isspace(c) || c == '-') {
+            continue;
+        }
+        if (std::isspace(static_cast<unsigned char>(str[i])) || str[i] == '-') {
             make_upper = true;
         }
+        result.append(str, i, length);
+        i += length;
     }
 
     return result;
@@ -5624,8 +6005,9 @@ std::string GiString::insert_random(const std::string& str) {
     }
 
     // Generate a random character and position
-    char random_char = 'A' + rand() % 26; // Generating a random uppercase letter for simplicity
-    int random_pos = rand() % (str.length() + 1); // Random position between 0 and str.length()
+    GiRandom& rng = GiRandom::local();
+    char random_char = static_cast<char>('A' + rng.bounded(26)); // Generating a random uppercase letter for simplicity
+    size_t random_pos = rng.bounded(str.length() + 1); // Random position between 0 and str.length()
 
     // Insert the random character at the random position
     std::string result = str;
@@ -5654,19 +6036,8 @@ std::string GiString::insert_random(const std::string& str) {
  * @throws std::invalid_argument If the start index is out of range or the length is invalid.
  */
 std::string GiString::anonymize(const std::string& str, size_t start, size_t length, char mask) {
-    if (start >= str.length() || length == 0 || start + length > str.length()) {
-        throw std::invalid_argument("Invalid start index or length for anonymization. GiString::anonymize");
-    }
-
     std::string anonymized = str;
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<int> dis(33, 126); // ASCII range for random character generation
-
-    for (size_t i = start; i < start + length; ++i) {
-        anonymized[i] = mask; // Replace with mask character
-    }
-
+    inplace::anonymize(anonymized, start, length, mask);
     return anonymized;
 }
 
@@ -5692,18 +6063,8 @@ std::string GiString::anonymize(const std::string& str, size_t start, size_t len
  * @throws std::invalid_argument If the input string is empty.
  */
 std::string GiString::mask_characters(const std::string& input, char mask, const std::vector<int>& positions) {
-    if (input.empty()) {
-        throw std::invalid_argument("GiString::mask_characters: Input string is empty.");
-    }
-
     std::string result = input;
-
-    for (int pos : positions) {
-        if (pos >= 0 && pos < static_cast<int>(result.size())) {
-            result[pos] = mask;
-        }
-    }
-
+    inplace::mask_characters(result, mask, positions);
     return result;
 }
 
@@ -5774,22 +6135,10 @@ std::string GiString::squish_spaces(const std::string& input) {
         throw std::invalid_argument("squish_spaces: Input string is empty.");
     }
 
-    std::string squishedString;
-    bool spaceFound = false;
-
-    for (char c : input) {
-        if (c == ' ') {
-            if (!spaceFound) {
-                squishedString += c;
-            }
-            spaceFound = true;
-        } else {
-            squishedString += c;
-            spaceFound = false;
-        }
-    }
-
-    return squishedString;
+    // Only the space character is collapsed; tabs and newlines are kept as they are
+    WhitespaceOptions options;
+    options.whitespace = " ";
+    return clean_whitespace(input, options);
 }
 
 // Example usage:
@@ -6245,20 +6594,7 @@ double GiString::lexical_density(const std::string& text) {
         throw std::invalid_argument("lexical_density: Input text is empty.");
     }
 
-    std::unordered_set<std::string> uniqueWords;
-    std::istringstream iss(text);
-    std::string word;
-
-    while (iss >> word) {
-        // Remove any punctuation marks from the word
-        word.erase(std::remove_if(word.begin(), word.end(), ::ispunct), word.end());
-        uniqueWords.insert(word);
-    }
-
-    double totalWords = std::count_if(text.begin(), text.end(), ::isspace) + 1;
-    double uniqueCount = static_cast<double>(uniqueWords.size());
-
-    return uniqueCount / totalWords;
+    return TextStats(text.data(), text.size(), true).lexical_density();
 }
 
 // Example usage:
@@ -6470,11 +6806,8 @@ std::string GiString::generate_password(int length, bool includeUppercase, bool
         allowedChars += specialChars;
     }
 
-    std::string password = "";
-    for (int i = 0; i < length; i++) {
-        int randomIndex = rand() % allowedChars.size();
-        password += allowedChars[randomIndex];
-    }
+    std::string password(length, '\0');
+    GiRandom::local().fill(&password[0], password.size(), allowedChars);
 
     return password;
 }
@@ -6500,14 +6833,7 @@ int GiString::count_vowels(const std::string& input) {
         throw std::invalid_argument("count_vowels: Error - Input string is empty.");
     }
 
-    int vowelCount = 0;
-    for (char c : input) {
-        if (std::tolower(c) == 'a' || std::tolower(c) == 'e' || std::tolower(c) == 'i' || std::tolower(c) == 'o' || std::tolower(c) == 'u') {
-            vowelCount++;
-        }
-    }
-
-    return vowelCount;
+    return static_cast<int>(TextStats(input.data(), input.size()).vowels());
 }
 
 // Example usage:
@@ -6532,16 +6858,7 @@ int GiString::count_consonants(std::string str) {
         throw std::invalid_argument("count_consonants: Error - Input string is empty");
     }
 
-    int consonantCount = 0;
-    std::string consonants = "bcdfghjklmnpqrstvwxyzBCDFGHJKLMNPQRSTVWXYZ";
-
-    for (char const &c : str) {
-        if (consonants.find(c) != std::string::npos) {
-            consonantCount++;
-        }
-    }
-
-    return consonantCount;
+    return static_cast<int>(TextStats(str.data(), str.size()).consonants());
 }
 
 // Example usage:
@@ -7066,22 +7383,7 @@ std::string GiString::compress_whitespace(const std::string& input) {
         throw std::invalid_argument("compress_whitespace: Input string is empty");
     }
 
-    std::string result;
-    bool isSpace = false;
-
-    for (char c : input) {
-        if (std::isspace(c)) {
-            if (!isSpace) {
-                result.push_back(' ');
-                isSpace = true;
-            }
-        } else {
-            result.push_back(c);
-            isSpace = false;
-        }
-    }
-
-    return result;
+    return clean_whitespace(input, WhitespaceOptions());
 }
 
 // Example usage:
@@ -7101,29 +7403,17 @@ std::string GiString::compress_whitespace(const std::string& input) {
  * @param str The input string to convert to camelCase.
  * @return The converted camelCase string.
  * @throws std::invalid_argument If the input string is empty.
+ *
+ * @note Words are split by GiStringCore::for_each_word, so acronyms and digits keep their
+ * words: "HTTPServer" gives "httpServer" (it used to give "httpserver"). Leading and
+ * trailing separators are kept: "_private" stays "_private" (it used to give "Private").
  */
 std::string GiString::to_camel_case(const std::string& str) {
     if (str.empty()) {
         throw std::invalid_argument("to_camel_case: Input string is empty.");
     }
 
-    std::string camelCaseStr;
-    bool makeUpper = false;
-
-    for (char c : str) {
-        if (std::isalnum(c)) {
-            if (makeUpper) {
-                camelCaseStr += std::toupper(c);
-                makeUpper = false;
-            } else {
-                camelCaseStr += std::tolower(c);
-            }
-        } else {
-            makeUpper = true;
-        }
-    }
-
-    return camelCaseStr;
+    return convert_case_style(str, CaseStyle::camel);
 }
 
 // Example usage:
@@ -7139,7 +7429,7 @@ std::string GiString::to_camel_case(const std::string& str) {
  * @brief Converts a camelCase string to a space-separated format.
  *
  * @param str The input string in camelCase format.
- * @return The converted string with spaces separating words.
+ * @return The lowercase words of the input separated by single spaces.
  * @throws std::invalid_argument If the input string is empty.
  */
 std::string GiString::from_camel_case(const std::string& str) {
@@ -7147,17 +7437,7 @@ std::string GiString::from_camel_case(const std::string& str) {
         throw std::invalid_argument("from_camel_case: Input string is empty.");
     }
 
-    std::string result;
-    for (char c : str) {
-        if (std::isupper(c)) {
-            result.push_back(' ');  // Add space before uppercase letters
-            result.push_back(std::tolower(c));
-        } else {
-            result.push_back(c);
-        }
-    }
-
-    return result;
+    return convert_case_style(str, CaseStyle::words);
 }
 
 // Example usage:
@@ -7174,25 +7454,18 @@ std::string GiString::from_camel_case(const std::string& str) {
  * @param str The input string to convert to snake_case.
  * @return The input string converted to snake_case.
  * @throws std::invalid_argument If the input string is empty.
+ *
+ * @note Words are split by GiStringCore::for_each_word, so spaces and other separators
+ * also become underscores: "hello world" gives "hello_world" (it used to be returned
+ * unchanged). Plural acronyms stay whole: "userIDs" gives "user_ids". Leading and trailing
+ * separators are kept as they are: "__init__" stays "__init__".
  */
 std::string GiString::to_snake_case(const std::string& str) {
     if (str.empty()) {
         throw std::invalid_argument("to_snake_case: Input string is empty.");
     }
 
-    std::string snakeCaseString;
-    for (size_t i = 0; i < str.length(); ++i) {
-        if (isupper(str[i])) {
-            if (i != 0 && islower(str[i - 1])) {
-                snakeCaseString.push_back('_');
-            }
-            snakeCaseString.push_back(tolower(str[i]));
-        } else {
-            snakeCaseString.push_back(str[i]);
-        }
-    }
-
-    return snakeCaseString;
+    return convert_case_style(str, CaseStyle::snake);
 }
 
 // Example usage:
@@ -7209,7 +7482,7 @@ std::string GiString::to_snake_case(const std::string& str) {
  * @brief Converts a snake_case string to a space-separated format.
  *
  * @param snakeCaseStr The input string in snake_case format.
- * @return The converted string with spaces.
+ * @return The lowercase words of the input separated by single spaces.
  * @throws std::invalid_argument If the input string is empty.
  */
 std::string GiString::from_snake_case(const std::string& snakeCaseStr) {
@@ -7217,17 +7490,7 @@ std::string GiString::from_snake_case(const std::string& snakeCaseStr) {
         throw std::invalid_argument("from_snake_case: Input string is empty.");
     }
 
-    std::string spaceSeparatedStr;
-    for (char c : snakeCaseStr) {
-        if (isupper(c)) {
-            spaceSeparatedStr.push_back(' ');  // Add a space before uppercase letters
-            spaceSeparatedStr.push_back(tolower(c));
-        } else {
-            spaceSeparatedStr.push_back(c);
-        }
-    }
-
-    return spaceSeparatedStr;
+    return convert_case_style(snakeCaseStr, CaseStyle::words);
 }
 
 // Example usage:
@@ -7244,25 +7507,18 @@ std::string GiString::from_snake_case(const std::string& snakeCaseStr) {
  * @param str The input string to convert to kebab-case.
  * @return The input string converted to kebab-case format.
  * @throws std::invalid_argument If the input string is empty.
+ *
+ * @note Words are split by GiStringCore::for_each_word, so spaces and other separators
+ * become hyphens: "hello world" gives "hello-world" (it used to give "helloworld").
+ * Leading and trailing separators are kept: "_private" gives "_private" (it used to give
+ * "private").
  */
 std::string GiString::to_kebab_case(const std::string& str) {
     if (str.empty()) {
         throw std::invalid_argument("to_kebab_case: Input string is empty.");
     }
 
-    std::string kebabCaseStr;
-    for (char c : str) {
-        if (std::isupper(c)) {
-            if (!kebabCaseStr.empty() && kebabCaseStr.back() != '-') {
-                kebabCaseStr.push_back('-');
-            }
-            kebabCaseStr.push_back(std::tolower(c));
-        } else if (std::isalnum(c)) {
-            kebabCaseStr.push_back(c);
-        }
-    }
-
-    return kebabCaseStr;
+    return convert_case_style(str, CaseStyle::kebab);
 }
 
 // Example usage:
@@ -7288,16 +7544,7 @@ std::string GiString::from_kebab_case(const std::string& kebabCaseStr) {
         throw std::invalid_argument("from_kebab_case: Input string is empty.");
     }
 
-    std::string result;
-    for (char c : kebabCaseStr) {
-        if (c == '-') {
-            result.push_back(' '); // Replace hyphen with space
-        } else {
-            result.push_back(c);
-        }
-    }
-
-    return result;
+    return convert_case_style(kebabCaseStr, CaseStyle::words);
 }
 
 // Example usage:
@@ -7317,29 +7564,17 @@ std::string GiString::from_kebab_case(const std::string& kebabCaseStr) {
  * @param str The input string to convert to PascalCase.
  * @return std::string The input string converted to PascalCase.
  * @throws std::invalid_argument If the input string is empty.
+ *
+ * @note Digits are kept as part of the word they follow: "Version 2 api" gives
+ * "Version2Api" (they used to be dropped, giving "VersionApi"). Leading and trailing
+ * separators are kept: "_private" gives "_Private" (it used to give "Private").
  */
 std::string GiString::to_pascal_case(const std::string& str) {
     if (str.empty()) {
         throw std::invalid_argument("to_pascal_case: Input string is empty.");
     }
 
-    std::string pascalCaseStr;
-    bool capitalizeNext = true;
-
-    for (char c : str) {
-        if (std::isalpha(c)) {
-            if (capitalizeNext) {
-                pascalCaseStr += std::toupper(c);
-                capitalizeNext = false;
-            } else {
-                pascalCaseStr += std::tolower(c);
-            }
-        } else if (std::isspace(c) || c == '_' || c == '-') {
-            capitalizeNext = true;
-        }
-    }
-
-    return pascalCaseStr;
+    return convert_case_style(str, CaseStyle::pascal);
 }
 
 // Example usage:
@@ -7362,15 +7597,7 @@ std::string GiString::from_pascal_case(const std::string& str) {
         throw std::invalid_argument("from_pascal_case: Input string is empty");
     }
 
-    std::string convertedStr;
-    for (size_t i = 0; i < str.size(); ++i) {
-        if (isupper(str[i]) && i > 0) {
-            convertedStr.push_back(' '); // Add space before uppercase letters (except the first)
-        }
-        convertedStr.push_back(tolower(str[i])); // Convert uppercase to lowercase
-    }
-
-    return convertedStr;
+    return convert_case_style(str, CaseStyle::words);
 }
 
 // Example usage:
@@ -7378,6 +7605,77 @@ std::string GiString::from_pascal_case(const std::string& str) {
 // std::string result = GiString::from_pascal_case(input);
 // std::cout << "Converted string: " << result << std::endl;
 
+namespace {
+    const std::pair<const char*, GiString::CaseStyle> case_style_names[] = {
+        {"camel", GiString::CaseStyle::camel},
+        {"pascal", GiString::CaseStyle::pascal},
+        {"snake", GiString::CaseStyle::snake},
+        {"screaming_snake", GiString::CaseStyle::screaming_snake},
+        {"kebab", GiString::CaseStyle::kebab},
+        {"words", GiString::CaseStyle::words},
+    };
+}
+
+/**
+ * @brief Rewrites an identifier or phrase in another naming convention.
+ *
+ * The input may be in any convention (camelCase, PascalCase, snake_case, SCREAMING_SNAKE,
+ * kebab-case, plain words or a mix); it is split into words once by
+ * GiStringCore::for_each_word, which keeps acronyms ("HTTPServer") and trailing digits
+ * ("utf8") together, and the result is written into a single allocation. Separators that
+ * open or close the input ("_private", "__init__") are copied unchanged.
+ *
+ * @param str The identifier to convert.
+ * @param style The target convention.
+ * @return The converted identifier.
+ * @throws std::invalid_argument If the input string is empty.
+ */
+std::string GiString::convert_case_style(const std::string& str, CaseStyle style) {
+    std::string result;
+    convert_case_style(str, style, result);
+    return result;
+}
+
+/**
+ * @brief Rewrites an identifier in another naming convention, appending the result to an output sink.
+ *
+ * @param str The identifier to convert.
+ * @param style The target convention.
+ * @param out The sink the result is appended to.
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::convert_case_style(const std::string& str, CaseStyle style, Appender out) {
+    if (str.empty()) {
+        throw std::invalid_argument("Input string is empty (GiString::convert_case_style)");
+    }
+    out.reserve(GiStringCore::case_style_length(str, style));
+    GiStringCore::to_case_style(str, style, out);
+}
+
+/**
+ * @brief Looks up a CaseStyle by its enumerator name ("camel", "snake", ...).
+ *
+ * @param name The style name.
+ * @param style Receives the style when the name is known.
+ * @return True if name names a style.
+ */
+bool GiString::parse_case_style(const std::string& name, CaseStyle& style) {
+    for (const auto& entry : case_style_names) {
+        if (name == entry.first) {
+            style = entry.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Example usage:
+// GiString gs;
+// std::cout << gs.convert_case_style("parseHTTPResponse", GiString::CaseStyle::snake) << std::endl;
+// Output: "parse_http_response"
+// std::cout << gs.convert_case_style("user_account_id", GiString::CaseStyle::pascal) << std::endl;
+// Output: "UserAccountId"
+
 
 
 
@@ -7394,11 +7692,12 @@ std::string GiString::randomize_case(const std::string& str) {
     }
 
     std::string result = str;
+    GiRandom& rng = GiRandom::local();
     for (char& c : result) {
         // Check if the character is a letter
         if (std::isalpha(c)) {
             // Generate a random number (0 or 1) to decide whether to change case
-            int changeCase = std::rand() % 2;
+            int changeCase = rng.coin();
             if (changeCase == 0) {
                 if (std::islower(c)) {
                     c = std::toupper(c); // Change to uppercase
@@ -7424,6 +7723,9 @@ std::string GiString::randomize_case(const std::string& str) {
 /**
  * @brief Singularizes words in plural form to singular form.
  *
+ * Uses GiString::Inflector, so irregular ("people") and uncountable ("news") words are
+ * handled; create an Inflector with a cache to convert many repeated words.
+ *
  * @param pluralWord The word in plural form to singularize.
  * @return std::string The singular form of the input word.
  * @throws std::invalid_argument If the input word is empty.
@@ -7433,29 +7735,7 @@ std::string GiString::singularize(const std::string& pluralWord) {
         throw std::invalid_argument("GiString::singularize: Input word is empty.");
     }
 
-    // Basic English singularization rules
-    std::string singularWord;
-    if (pluralWord.size() > 3 && pluralWord.substr(pluralWord.size() - 3) == "ies" && 
-        !isVowel(pluralWord[pluralWord.size() - 4])) {
-        // If the word ends in ies and the preceding character is not a vowel, change ies to y
-        singularWord = pluralWord.substr(0, pluralWord.size() - 3) + "y";
-    } else if (pluralWord.size() > 2 && pluralWord.substr(pluralWord.size() - 2) == "es" && 
-               (pluralWord[pluralWord.size() - 3] == 's' || pluralWord[pluralWord.size() - 3] == 'x' || 
-                pluralWord[pluralWord.size() - 3] == 'z' || 
-                (pluralWord.size() > 4 && 
-                 ((pluralWord.substr(pluralWord.size() - 4, 2) == "ch") || 
-                  (pluralWord.substr(pluralWord.size() - 4, 2) == "sh"))))) {
-        // If the word ends in es and the preceding character is s, x, z, ch, or sh, remove the es
-        singularWord = pluralWord.substr(0, pluralWord.size() - 2);
-    } else if (pluralWord.back() == 's') {
-        // If the word ends in s, just remove the s
-        singularWord = pluralWord.substr(0, pluralWord.size() - 1);
-    } else {
-        // If none of the above conditions are met, return the word as is
-        singularWord = pluralWord;
-    }
-
-    return singularWord;
+    return Inflector().singularize(pluralWord);
 }
 
 // Example usage:
@@ -7470,7 +7750,8 @@ std::string GiString::singularize(const std::string& pluralWord) {
 /**
  * @brief Converts words in singular form to plural form.
  *
- * This function takes a word in singular form and converts it to its plural form by applying basic English pluralization rules.
+ * This function takes a word in singular form and converts it to its plural form by applying English pluralization rules,
+ * including irregular and uncountable words (see GiString::Inflector).
  *
  * @param word The word in singular form to be pluralized.
  * @return The pluralized form of the input word.
@@ -7481,22 +7762,7 @@ std::string GiString::pluralize(const std::string& word) {
         throw std::invalid_argument("GiString::pluralize: Input word is empty.");
     }
 
-    // Basic English pluralization rules
-    std::string pluralizedWord;
-    if (word.back() == 's' || word.back() == 'x' || word.back() == 'z' || 
-        (word.size() > 1 && ((word.substr(word.size() - 2) == "ch") || (word.substr(word.size() - 2) == "sh")))) {
-        // If the word ends in s, x, z, ch, sh, add 'es' at the end
-        pluralizedWord = word + "es";
-    } else if (word.back() == 'y' && 
-               (word.size() == 1 || (word.size() > 1 && !isVowel(word[word.size() - 2])))) {
-        // If the word ends in y and y is not preceded by a vowel, change y to ies
-        pluralizedWord = word.substr(0, word.size() - 1) + "ies";
-    } else {
-        // In other cases, just add 's' at the end
-        pluralizedWord = word + "s";
-    }
-
-    return pluralizedWord;
+    return Inflector().pluralize(word);
 }
 
 bool GiString::isVowel(char c) {
@@ -7551,34 +7817,41 @@ std::string GiString::html_to_text(const std::string& htmlContent) {
  * @throws std::invalid_argument If the input string is empty.
  */
 std::string GiString::xml_escape(const std::string& input) {
+    std::string result;
+    result.reserve(input.size());
+    xml_escape(input, result);
+    return result;
+}
+
+/**
+ * @brief Escapes XML special characters, appending the result to an output sink.
+ *
+ * @param input The input string to escape.
+ * @param out The sink the result is appended to.
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::xml_escape(const std::string& input, Appender out) {
     if (input.empty()) {
         throw std::invalid_argument("xml_escape: Input string is empty.");
     }
 
-    std::string escapedString;
-    for (char c : input) {
-        switch (c) {
-            case '<':
-                escapedString += "&lt;";
-                break;
-            case '>':
-                escapedString += "&gt;";
-                break;
-            case '&':
-                escapedString += "&amp;";
-                break;
-            case '\'':
-                escapedString += "&apos;";
-                break;
-            case '\"':
-                escapedString += "&quot;";
-                break;
-            default:
-                escapedString += c;
+    out.reserve(input.size());
+    size_t start = 0;
+    for (size_t i = 0; i < input.size(); ++i) {
+        const char* entity;
+        switch (input[i]) {
+            case '<': entity = "&lt;"; break;
+            case '>': entity = "&gt;"; break;
+            case '&': entity = "&amp;"; break;
+            case '\'': entity = "&apos;"; break;
+            case '\"': entity = "&quot;"; break;
+            default: continue;
         }
+        out.append(input.data() + start, i - start);
+        out.append(entity, std::strlen(entity));
+        start = i + 1;
     }
-
-    return escapedString;
+    out.append(input.data() + start, input.size() - start);
 }
 
 // Example usage:
@@ -7912,22 +8185,8 @@ std::string GiString::unswap_pairs(const std::string& str) {
  * @throws std::invalid_argument If the input string or mask is empty.
  */
 std::string GiString::apply_mask(const std::string& str, const std::string& mask) {
-    if (str.empty() || mask.empty()) {
-        throw std::invalid_argument("apply_mask: Input string or mask is empty.");
-    }
-
-    std::string maskedStr;
-    size_t maskIndex = 0;
-
-    for (char c : str) {
-        if (std::isalnum(c)) { // Check if the character is alphanumeric
-            maskedStr += (maskIndex < mask.length() && mask[maskIndex] == '1') ? '*' : c;
-            maskIndex = (maskIndex + 1) % mask.length();
-        } else {
-            maskedStr += c; // Keep non-alphanumeric characters as they are
-        }
-    }
-
+    std::string maskedStr = str;
+    inplace::apply_mask(maskedStr, mask);
     return maskedStr;
 }
 
@@ -8028,10 +8287,7 @@ std::string GiString::random_extract(const std::string& input, size_t length) {
     }
 
     // Generate a random starting index for the substring
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<size_t> dist(0, input.length() - length);
-    size_t start_index = dist(gen);
+    size_t start_index = GiRandom::local().bounded(input.length() - length + 1);
 
     return input.substr(start_index, length);
 }
@@ -8043,6 +8299,36 @@ std::string GiString::random_extract(const std::string& input, size_t length) {
 // std::string result = giString.random_extract(input, length);
 // std::cout << "Randomly extracted substring: " << result << std::endl;
 
+namespace
+{
+    // Shared by both auto_indent overloads
+    template <typename String>
+    void auto_indent_into(const std::string& str, String& autoIndentedStr) {
+        int indentationLevel = 0;
+        bool isNewLine = true;
+
+        autoIndentedStr.reserve(str.size());
+        for (char c : str) {
+            if (isNewLine) {
+                for (int i = 0; i < indentationLevel; ++i) {
+                    autoIndentedStr += "    "; // Adding 4 spaces for each level of indentation
+                }
+                isNewLine = false;
+            }
+
+            autoIndentedStr += c;
+
+            if (c == '{') {
+                ++indentationLevel;
+            } else if (c == '}') {
+                --indentationLevel;
+            } else if (c == '\n') {
+                isNewLine = true;
+            }
+        }
+    }
+}
+
 /**
  * @brief Automatically adds indentation to a string based on its structure.
  *
@@ -8057,28 +8343,25 @@ std::string GiString::auto_indent(const std::string& str) {
     }
 
     std::string autoIndentedStr;
-    int indentationLevel = 0;
-    bool isNewLine = true;
-
-    for (char c : str) {
-        if (isNewLine) {
-            for (int i = 0; i < indentationLevel; ++i) {
-                autoIndentedStr += "    "; // Adding 4 spaces for each level of indentation
-            }
-            isNewLine = false;
-        }
-        
-        autoIndentedStr += c;
+    auto_indent_into(str, autoIndentedStr);
+    return autoIndentedStr;
+}
 
-        if (c == '{') {
-            ++indentationLevel;
-        } else if (c == '}') {
-            --indentationLevel;
-        } else if (c == '\n') {
-            isNewLine = true;
-        }
+/**
+ * @brief Auto-indents a string, allocating the result from a memory resource.
+ *
+ * @param str The input string to be auto-indented.
+ * @param resource The memory resource used for the result.
+ * @return The auto-indented string.
+ * @throws std::invalid_argument If the input string is empty.
+ */
+std::pmr::string GiString::auto_indent(const std::string& str, std::pmr::memory_resource* resource) {
+    if (str.empty()) {
+        throw std::invalid_argument("auto_indent: Error caused by empty input string");
     }
 
+    std::pmr::string autoIndentedStr(resource);
+    auto_indent_into(str, autoIndentedStr);
     return autoIndentedStr;
 }
 
@@ -8193,7 +8476,9 @@ std::string GiString::to_base(const std::string& number, int base) {
  * @brief Normalize the casing of a string according to the specified style (e.g., all uppercase, all lowercase).
  *
  * @param input The input string to normalize.
- * @param style The desired casing style ("lower" for all lowercase, "upper" for all uppercase).
+ * @param style The desired casing style: "lower" for all lowercase, "upper" for all uppercase,
+ *              or an identifier style ("camel", "pascal", "snake", "screaming_snake",
+ *              "kebab", "words") as produced by convert_case_style().
  * @return The input string with casing normalized according to the specified style.
  * @throws std::invalid_argument If the input string is empty or if an invalid style is provided.
  */
@@ -8217,7 +8502,11 @@ std::string GiString::normalize_casing(const std::string& input, const std::stri
             }
         }
     } else {
-        throw std::invalid_argument("normalize_casing: Invalid style provided!");
+        CaseStyle identifier_style;
+        if (!parse_case_style(style, identifier_style)) {
+            throw std::invalid_argument("normalize_casing: Invalid style provided!");
+        }
+        return convert_case_style(input, identifier_style);
     }
 
     return result;
@@ -8230,6 +8519,7 @@ std::string GiString::normalize_casing(const std::string& input, const std::stri
 // std::string result_upper = strObj.normalize_casing(input, "upper");
 // std::cout << "Normalized to lowercase: " << result_lower << std::endl;
 // std::cout << "Normalized to uppercase: " << result_upper << std::endl;
+// std::cout << strObj.normalize_casing("userAccountID", "kebab") << std::endl;  // Output: "user-account-id"
 
 // Function to remove diacritics from text, e.g., converting "é" to "e".
 /**
@@ -8278,22 +8568,31 @@ std::string GiString::diacritic_remove(const std::string& text) {
  * @throws std::invalid_argument If the input string is empty.
  */
 std::string GiString::quote_for_shell(const std::string& input) {
+    std::string result;
+    result.reserve(input.size());
+    quote_for_shell(input, result);
+    return result;
+}
+
+/**
+ * @brief Escapes shell special characters, appending the result to an output sink.
+ *
+ * @param input The input string to escape.
+ * @param out The sink the result is appended to.
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::quote_for_shell(const std::string& input, Appender out) {
     if (input.empty()) {
         throw std::invalid_argument("quote_for_shell: Input string is empty.");
     }
 
-    // List of characters that need to be escaped for shell safety
-    const std::string specialChars = "\\`$\"";
-
-    std::string result;
+    out.reserve(input.size());
     for (char c : input) {
-        if (specialChars.find(c) != std::string::npos) {
-            result.push_back('\\');  // Add escape character
+        if (c == '\\' || c == '`' || c == '$' || c == '\"') {
+            out.push_back('\\');
         }
-        result.push_back(c);
+        out.push_back(c);
     }
-
-    return result;
 }
 
 // Example usage:
@@ -8343,21 +8642,26 @@ std::string GiString::dequote_for_shell(const std::string& input) {
  * @throws std::invalid_argument If the input string is empty.
  */
 std::string GiString::escape_regex(const std::string& input) {
+    std::string result;
+    result.reserve(input.size());
+    escape_regex(input, result);
+    return result;
+}
+
+/**
+ * @brief Escapes regular expression metacharacters, appending the result to an output sink.
+ *
+ * @param input The input string to escape.
+ * @param out The sink the result is appended to.
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::escape_regex(const std::string& input, Appender out) {
     if (input.empty()) {
         throw std::invalid_argument("escape_regex: Input string is empty");
     }
 
-    std::string escapedString;
-    for (char c : input) {
-        if (c == '.' || c == '^' || c == '$' || c == '|' || c == '?' || c == '*' ||
-            c == '+' || c == '(' || c == ')' || c == '[' || c == ']' || c == '{' ||
-            c == '}' || c == '\\' || c == '/') {
-            escapedString += '\\'; // add backslash before special characters
-        }
-        escapedString += c;
-    }
-
-    return escapedString;
+    out.reserve(input.size());
+    GiStringCore::escape_regex(input, out);
 }
 
 // Example usage:
@@ -8523,6 +8827,8 @@ std::vector<std::string> GiString::extract_currency(const std::string& input) {
  * @brief Calculates the similarity between two strings using the Jaccard index.
  *
  * The Jaccard index is a measure of how similar two sets are. It is defined as the size of the intersection divided by the size of the union of the two sets.
+ * Here the sets are the distinct characters of each string, held in 256-bit bitsets. For
+ * finer metrics (Jaro-Winkler, q-gram cosine, normalized Levenshtein) see GiSimilarity.
  *
  * @param str1 The first input string.
  * @param str2 The second input string.
@@ -8534,27 +8840,8 @@ double GiString::string_similarity(const std::string& str1, const std::string& s
         throw std::invalid_argument("GiString::string_similarity: Input strings cannot be empty.");
     }
 
-    std::unordered_set<char> set1(str1.begin(), str1.end());
-    std::unordered_set<char> set2(str2.begin(), str2.end());
-
-    std::unordered_set<char> intersection;
-    std::unordered_set<char> union_set;
-
-    // Calculate intersection and union of the two sets
-    for (const char& c : set1) {
-        if (set2.find(c) != set2.end()) {
-            intersection.insert(c);
-        }
-        union_set.insert(c);
-    }
-
-    for (const char& c : set2) {
-        union_set.insert(c);
-    }
-
-    double jaccard_index = static_cast<double>(intersection.size()) / static_cast<double>(union_set.size());
-    return jaccard_index;
-}
+    return GiSimilarity::char_jaccard(str1, str2);
+}
 
 // Example usage:
 // GiString giString;
@@ -8686,9 +8973,10 @@ std::string GiString::random_case(const std::string& input) {
     }
 
     std::string result = input;
+    GiRandom& rng = GiRandom::local();
     for (char& c : result) {
         if (std::isalpha(c)) {
-            if (std::rand() % 2 == 0) {
+            if (rng.coin()) {
                 if (std::islower(c)) {
                     c = std::toupper(c);
                 } else {
@@ -10196,26 +10484,10 @@ std::string GiString::adjust_whitespace(const std::string& input) {
         throw std::invalid_argument("adjust_whitespace: Input string is empty.");
     }
 
-    std::string result;
-    bool is_space = false;
-
-    for (char c : input) {
-        if (std::isspace(c)) {
-            if (!is_space) {
-                result.push_back(' '); // Replace consecutive spaces with a single space
-                is_space = true;
-            }
-        } else {
-            result.push_back(c);
-            is_space = false;
-        }
-    }
-
-    // Remove leading and trailing spaces
-    result.erase(result.find_last_not_of(" ") + 1);
-    result.erase(0, result.find_first_not_of(" "));
-
-    return result;
+    // Collapse runs to a single space and remove leading and trailing spaces
+    WhitespaceOptions options;
+    options.trim = true;
+    return clean_whitespace(input, options);
 }
 
 // Example usage:
@@ -10280,20 +10552,8 @@ std::string GiString::generate_identifier(const std::string& data) {
  * @throws std::invalid_argument If the input string or substring is empty.
  */
 
-int GiString::count_substring(std::string str, const std::string& substring) {
-    if (str.empty() || substring.empty()) {
-        throw std::invalid_argument("count_substring: Input string or substring is empty.");
-    }
-
-    int count = 0;
-    size_t pos = 0;
-    
-    while ((pos = str.find(substring, pos)) != std::string::npos) {
-        ++count;
-        pos += substring.length();
-    }
-
-    return count;
+int GiString::count_substring(const std::string& str, const std::string& substring) {
+    return views::count_substring(str, substring);
 }
 
 // Example usage:
@@ -10341,6 +10601,9 @@ std::string GiString::replace_substring(std::string str, const std::string& oldS
 /**
  * @brief Calculates the visible length of a string, ignoring any invisible characters (e.g., ANSI codes).
  *
+ * The text between escape codes is measured in terminal columns: wide characters count
+ * twice, while combining marks and control characters do not count.
+ *
  * @param str The input string for which the visible length needs to be calculated.
  * @return The visible length of the string after ignoring invisible characters.
  * @throws std::invalid_argument If the input string is empty.
@@ -10350,20 +10613,21 @@ int GiString::visible_length(const std::string& str) {
         throw std::invalid_argument("GiString::visible_length: Error - Input string is empty.");
     }
 
-    int visibleLength = 0;
-    bool inVisibleChar = false;
+    size_t visibleLength = 0;
+    size_t start = 0;
 
-    for (char c : str) {
-        if (c == '\033') { // Check for ANSI escape code
-            inVisibleChar = true;
-        } else if (inVisibleChar && c == 'm') {
-            inVisibleChar = false;
-        } else if (!inVisibleChar) {
-            visibleLength++;
+    while (start < str.size()) {
+        size_t escape = str.find('\033', start); // Check for ANSI escape code
+        size_t end = escape == std::string::npos ? str.size() : escape;
+        visibleLength += GiUnicode::display_width(str.data() + start, end - start);
+        if (escape == std::string::npos) {
+            break;
         }
+        size_t terminator = str.find('m', escape + 1);
+        start = terminator == std::string::npos ? str.size() : terminator + 1;
     }
 
-    return visibleLength;
+    return static_cast<int>(visibleLength);
 }
 
 // Example usage:
@@ -10371,6 +10635,7 @@ int GiString::visible_length(const std::string& str) {
 // std::string input = "Hello\033[1;31mWorld\033[0m";
 // int length = giString.visible_length(input);
 // std::cout << "Visible length of the string: " << length << std::endl;
+// std::cout << giString.visible_length("\033[1m中文\033[0m ok") << std::endl;  // Output: "7"
 
 
 
@@ -10425,28 +10690,19 @@ std::string GiString::to_spongebob_mocking(const std::string& input) {
  * @param str The string to insert into the list.
  * @return The updated sorted list with the new string inserted while preserving the order.
  * @throws std::invalid_argument If the input list is empty.
+ *
+ * @note Each call still copies the list; keep large lists that change often in a
+ * GiString::SortedStringSet, which inserts in O(log n).
  */
 std::vector<std::string> GiString::insert_ordered(std::vector<std::string> strList, const std::string& str) {
     if (strList.empty()) {
         throw std::invalid_argument("insert_ordered: Input list is empty.");
     }
 
-    std::vector<std::string> result;
-    bool strInserted = false;
-
-    for (const std::string& s : strList) {
-        if (!strInserted && str < s) {
-            result.push_back(str);
-            strInserted = true;
-        }
-        result.push_back(s);
-    }
-
-    if (!strInserted) {
-        result.push_back(str);
-    }
-
-    return result;
+    // Binary search for the slot after any equal strings; the list is taken by value, so
+    // the only other cost is shifting the tail
+    strList.insert(std::upper_bound(strList.begin(), strList.end(), str), str);
+    return strList;
 }
 
 // Example usage:
@@ -10466,27 +10722,24 @@ std::vector<std::string> GiString::insert_ordered(std::vector<std::string> strLi
  * @param strToRemove The string to be removed from the list.
  * @return The updated sorted list after removing the specified string.
  * @throws std::invalid_argument If the sortedList is empty or if strToRemove is not found in the list.
+ *
+ * @note The string is located by binary search. Each call still copies the list; keep
+ * large lists that change often in a GiString::SortedStringSet.
  */
 std::vector<std::string> GiString::remove_ordered(const std::vector<std::string>& sortedList, const std::string& strToRemove) {
     if (sortedList.empty()) {
         throw std::invalid_argument("remove_ordered: Error - sortedList is empty");
     }
 
-    std::vector<std::string> updatedList;
-    bool removed = false;
-
-    for (const std::string& str : sortedList) {
-        if (str == strToRemove && !removed) {
-            removed = true;
-        } else {
-            updatedList.push_back(str);
-        }
-    }
-
-    if (!removed) {
+    auto found = std::lower_bound(sortedList.begin(), sortedList.end(), strToRemove);
+    if (found == sortedList.end() || *found != strToRemove) {
         throw std::invalid_argument("remove_ordered: Error - strToRemove not found in the sortedList");
     }
 
+    std::vector<std::string> updatedList;
+    updatedList.reserve(sortedList.size() - 1);
+    updatedList.insert(updatedList.end(), sortedList.begin(), found);
+    updatedList.insert(updatedList.end(), found + 1, sortedList.end());
     return updatedList;
 }
 
@@ -10621,8 +10874,10 @@ std::string GiString::case_insensitive_replace(const std::string& str, const std
 /**
  * @brief Truncates a string to a specified length, adding "..." at the end if truncated.
  *
+ * Length is measured in terminal columns; the cut falls between grapheme clusters.
+ *
  * @param str The input string to truncate.
- * @param length The maximum length of the truncated string.
+ * @param length The maximum display width kept before the "...".
  * @return The truncated string with "..." added at the end if truncated.
  * @throws std::invalid_argument If the input string is empty.
  */
@@ -10632,11 +10887,12 @@ std::string GiString::truncate_with_ellipsis(const std::string& str, size_t leng
         throw std::invalid_argument("GiString::truncate_with_ellipsis: Error - Input string is empty");
     }
 
-    if (str.length() <= length) {
+    if (GiUnicode::display_width(str) <= length) {
         return str;
     }
 
-    return str.substr(0, length) + "...";
+    size_t width;
+    return str.substr(0, GiUnicode::fit_width(str.data(), str.size(), length, width)) + "...";
 }
 
 // Example usage:
@@ -10659,23 +10915,7 @@ std::string GiString::truncate_with_ellipsis(const std::string& str, size_t leng
  * @throws std::invalid_argument If the input string is empty or if the field index is out of range.
  */
 std::string GiString::extract_field(const std::string& input, char delimiter, int fieldIndex) {
-    if (input.empty()) {
-        throw std::invalid_argument("GiString::extract_field: Input string is empty.");
-    }
-
-    // Split the input string based on the delimiter
-    std::stringstream ss(input);
-    std::string token;
-    std::vector<std::string> tokens;
-    while (std::getline(ss, token, delimiter)) {
-        tokens.push_back(token);
-    }
-
-    if ((size_t)fieldIndex < 0 || (size_t)fieldIndex >= tokens.size()) {
-        throw std::invalid_argument("GiString::extract_field: Field index is out of range.");
-    }
-
-    return tokens[fieldIndex];
+    return std::string(views::extract_field(input, delimiter, fieldIndex));
 }
 
 // Example usage:
@@ -10841,6 +11081,8 @@ std::string GiString::implode(const std::vector<char>& characters) {
 /**
  * @brief Removes duplicate characters in a string, keeping only the first occurrence of each character.
  *
+ * Seen bytes are tracked in a 256-bit set, so the cost is O(n).
+ *
  * @param str The input string from which duplicates will be removed.
  * @return std::string The string with duplicates removed.
  * @throws std::invalid_argument If the input string is empty.
@@ -10851,15 +11093,7 @@ std::string GiString::remove_duplicates(const std::string& str) {
     }
 
     std::string result;
-    std::unordered_set<char> seen;
-
-    for (char c : str) {
-        if (seen.find(c) == seen.end()) {
-            result += c;
-            seen.insert(c);
-        }
-    }
-
+    append_first_occurrences(str, result);
     return result;
 }
 
@@ -10977,9 +11211,12 @@ std::vector<std::string> GiString::generate_ngrams(const std::string& input, int
         throw std::invalid_argument("generate_ngrams: n should be greater than 0.");
     }
 
+    // An input shorter than n yields no n-grams
+    NGramRange range(input, static_cast<size_t>(n));
     std::vector<std::string> ngrams;
-    for (size_t i = 0; i < input.size() - n + 1; ++i) {
-        ngrams.push_back(input.substr(i, n));
+    ngrams.reserve(range.size());
+    for (std::string_view gram : range) {
+        ngrams.emplace_back(gram);
     }
 
     return ngrams;
@@ -10995,6 +11232,386 @@ std::vector<std::string> GiString::generate_ngrams(const std::string& input, int
 // }
 // Output: "hel ell llo lo w wo wor orl rld "
 
+namespace {
+    // splitmix64 finalizer; spreads the weak low bits of the polynomial rolling hash
+    inline uint64_t mix64(uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xBF58476D1CE4E5B9ULL;
+        x ^= x >> 27;
+        x *= 0x94D049BB133111EBULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    inline bool is_ngram_separator(char c) {
+        return std::isspace(static_cast<unsigned char>(c)) != 0;
+    }
+
+    inline size_t skip_ngram_separators(std::string_view text, size_t pos) {
+        while (pos < text.size() && is_ngram_separator(text[pos])) {
+            ++pos;
+        }
+        return pos;
+    }
+
+    inline size_t skip_ngram_word(std::string_view text, size_t pos) {
+        while (pos < text.size() && !is_ngram_separator(text[pos])) {
+            ++pos;
+        }
+        return pos;
+    }
+
+    const uint64_t ngram_hash_base = 0x100000001B3ULL;
+
+    // Calls visit(fingerprint) for every n-gram, updating a Rabin-Karp hash in O(1) per step
+    template <typename Visit>
+    void for_each_ngram_fingerprint(std::string_view text, size_t n, bool words, Visit visit) {
+        if (n == 0) {
+            return;
+        }
+
+        uint64_t power = 1;
+        for (size_t i = 1; i < n; ++i) {
+            power *= ngram_hash_base;
+        }
+
+        uint64_t hash = 0;
+        if (!words) {
+            if (n > text.size()) {
+                return;
+            }
+            // Bytes are offset by one so that runs of NUL bytes still change the hash
+            for (size_t i = 0; i < n; ++i) {
+                hash = hash * ngram_hash_base + static_cast<unsigned char>(text[i]) + 1;
+            }
+            visit(mix64(hash));
+            for (size_t i = n; i < text.size(); ++i) {
+                hash -= (static_cast<unsigned char>(text[i - n]) + 1ULL) * power;
+                hash = hash * ngram_hash_base + static_cast<unsigned char>(text[i]) + 1;
+                visit(mix64(hash));
+            }
+            return;
+        }
+
+        // Word n-grams roll over per-word FNV-1a hashes kept in a ring of the last n words
+        std::vector<uint64_t> window(n);
+        size_t count = 0;
+        size_t pos = skip_ngram_separators(text, 0);
+        while (pos < text.size()) {
+            size_t end = skip_ngram_word(text, pos);
+            uint64_t word_hash = 0xCBF29CE484222325ULL;
+            for (size_t i = pos; i < end; ++i) {
+                word_hash = (word_hash ^ static_cast<unsigned char>(text[i])) * ngram_hash_base;
+            }
+
+            if (count >= n) {
+                hash -= window[count % n] * power;
+            }
+            hash = hash * ngram_hash_base + word_hash;
+            window[count % n] = word_hash;
+            ++count;
+            if (count >= n) {
+                visit(mix64(hash));
+            }
+            pos = skip_ngram_separators(text, end);
+        }
+    }
+}
+
+/**
+ * @brief Creates a range of n-grams over text without copying it.
+ *
+ * @param text The text to split; it must outlive the range and its iterators.
+ * @param n The number of characters (bytes) or words per n-gram.
+ * @param unit Whether n counts characters or whitespace-separated words.
+ *
+ * @throws std::invalid_argument If n is 0.
+ */
+GiString::NGramRange::NGramRange(std::string_view text, size_t n, Unit unit) : text_(text), n_(n), unit_(unit) {
+    if (n_ == 0) {
+        throw std::invalid_argument("n should be greater than 0 (GiString::NGramRange)");
+    }
+}
+
+GiString::NGramRange::iterator::iterator(std::string_view text, size_t n, Unit unit, size_t first, size_t last)
+    : text_(text), n_(n), unit_(unit), first_(first), last_(last) {
+}
+
+std::string_view GiString::NGramRange::iterator::operator*() const {
+    if (unit_ == Unit::Chars) {
+        return text_.substr(first_, n_);
+    }
+    return text_.substr(first_, last_ - first_);
+}
+
+GiString::NGramRange::iterator& GiString::NGramRange::iterator::operator++() {
+    if (unit_ == Unit::Chars) {
+        ++first_;
+        if (first_ + n_ > text_.size()) {
+            first_ = std::string_view::npos;
+        }
+        return *this;
+    }
+
+    // Drop the first word and pull in the next one after the current last word
+    size_t next = skip_ngram_separators(text_, last_);
+    if (next == text_.size()) {
+        first_ = std::string_view::npos;
+        return *this;
+    }
+    first_ = skip_ngram_separators(text_, skip_ngram_word(text_, first_));
+    last_ = skip_ngram_word(text_, next);
+    return *this;
+}
+
+GiString::NGramRange::iterator GiString::NGramRange::iterator::operator++(int) {
+    iterator previous = *this;
+    ++(*this);
+    return previous;
+}
+
+GiString::NGramRange::iterator GiString::NGramRange::begin() const {
+    if (unit_ == Unit::Chars) {
+        return n_ <= text_.size() ? iterator(text_, n_, unit_, 0, 0) : end();
+    }
+
+    size_t first = skip_ngram_separators(text_, 0);
+    size_t last = first;
+    for (size_t k = 0; k < n_; ++k) {
+        size_t start = skip_ngram_separators(text_, last);
+        if (start == text_.size()) {
+            return end();
+        }
+        last = skip_ngram_word(text_, start);
+    }
+    return iterator(text_, n_, unit_, first, last);
+}
+
+GiString::NGramRange::iterator GiString::NGramRange::end() const {
+    return iterator(text_, n_, unit_, std::string_view::npos, 0);
+}
+
+bool GiString::NGramRange::empty() const {
+    return begin() == end();
+}
+
+/**
+ * @brief Counts the n-grams in the range.
+ *
+ * @return The number of n-grams; 0 when the text is shorter than n units.
+ */
+size_t GiString::NGramRange::size() const {
+    if (unit_ == Unit::Chars) {
+        return n_ <= text_.size() ? text_.size() - n_ + 1 : 0;
+    }
+
+    size_t words = 0;
+    size_t pos = skip_ngram_separators(text_, 0);
+    while (pos < text_.size()) {
+        ++words;
+        pos = skip_ngram_separators(text_, skip_ngram_word(text_, pos));
+    }
+    return words >= n_ ? words - n_ + 1 : 0;
+}
+
+// Example usage:
+// GiString gs;
+// for (std::string_view gram : gs.word_ngrams("the quick brown fox", 2)) {
+//     std::cout << "[" << gram << "] ";
+// }
+// Output: "[the quick] [quick brown] [brown fox] "
+
+/**
+ * @brief Returns a zero-copy range of character n-grams.
+ *
+ * @param text The text to split; it must outlive the range.
+ * @param n The number of bytes per n-gram.
+ * @return The n-gram range.
+ *
+ * @throws std::invalid_argument If n is 0.
+ */
+GiString::NGramRange GiString::ngrams(std::string_view text, size_t n) {
+    return NGramRange(text, n, NGramRange::Unit::Chars);
+}
+
+/**
+ * @brief Returns a zero-copy range of word n-grams.
+ *
+ * @param text The text to split; it must outlive the range.
+ * @param n The number of whitespace-separated words per n-gram.
+ * @return The n-gram range.
+ *
+ * @throws std::invalid_argument If n is 0.
+ */
+GiString::NGramRange GiString::word_ngrams(std::string_view text, size_t n) {
+    return NGramRange(text, n, NGramRange::Unit::Words);
+}
+
+/**
+ * @brief Computes a 64-bit rolling-hash fingerprint for every n-gram.
+ *
+ * @param text The input text.
+ * @param n The n-gram size.
+ * @param words Whether n counts words instead of characters.
+ * @return One fingerprint per n-gram, in order.
+ *
+ * @throws std::invalid_argument If n is 0.
+ */
+std::vector<uint64_t> GiString::ngram_fingerprints(std::string_view text, size_t n, bool words) {
+    NGramRange range(text, n, words ? NGramRange::Unit::Words : NGramRange::Unit::Chars);
+
+    std::vector<uint64_t> fingerprints;
+    if (!words) {
+        fingerprints.reserve(range.size());
+    }
+    for_each_ngram_fingerprint(text, n, words, [&fingerprints](uint64_t fp) { fingerprints.push_back(fp); });
+    return fingerprints;
+}
+
+/**
+ * @brief Computes a 64-bit SimHash of the text's n-gram fingerprints.
+ *
+ * Similar texts produce fingerprints with a small Hamming distance (see simhash_distance).
+ *
+ * @param text The input text.
+ * @param n The n-gram size.
+ * @param words Whether n counts words instead of characters.
+ * @return The SimHash fingerprint.
+ *
+ * @throws std::invalid_argument If n is 0.
+ */
+uint64_t GiString::simhash(std::string_view text, size_t n, bool words) {
+    if (n == 0) {
+        throw std::invalid_argument("n should be greater than 0 (GiString::simhash)");
+    }
+
+    int64_t weights[64] = {};
+    for_each_ngram_fingerprint(text, n, words, [&weights](uint64_t fp) {
+        for (int bit = 0; bit < 64; ++bit) {
+            weights[bit] += ((fp >> bit) & 1) ? 1 : -1;
+        }
+    });
+
+    uint64_t result = 0;
+    for (int bit = 0; bit < 64; ++bit) {
+        if (weights[bit] > 0) {
+            result |= 1ULL << bit;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Returns the Hamming distance between two SimHash fingerprints.
+ *
+ * @param a The first fingerprint.
+ * @param b The second fingerprint.
+ * @return The number of differing bits (0 - 64).
+ */
+int GiString::simhash_distance(uint64_t a, uint64_t b) {
+    return static_cast<int>(std::bitset<64>(a ^ b).count());
+}
+
+// Example usage:
+// GiString gs;
+// uint64_t a = gs.simhash("the quick brown fox jumps over the lazy dog", 3);
+// uint64_t b = gs.simhash("the quick brown fox jumped over the lazy dog", 3);
+// std::cout << "Hamming distance: " << gs.simhash_distance(a, b) << std::endl;
+
+/**
+ * @brief Creates a MinHash signature builder.
+ *
+ * Builders created with the same num_hashes and seed produce comparable signatures.
+ *
+ * @param num_hashes Number of hash permutations (signature length).
+ * @param seed Seed deriving the permutations.
+ *
+ * @throws std::invalid_argument If num_hashes is 0.
+ */
+GiString::MinHash::MinHash(size_t num_hashes, uint64_t seed) {
+    if (num_hashes == 0) {
+        throw std::invalid_argument("Number of hashes must be greater than 0 (GiString::MinHash)");
+    }
+
+    multipliers_.resize(num_hashes);
+    increments_.resize(num_hashes);
+    for (size_t i = 0; i < num_hashes; ++i) {
+        multipliers_[i] = mix64(seed + (i + 1) * 0x9E3779B97F4A7C15ULL) | 1;
+        increments_[i] = mix64(seed ^ ((i + 1) * 0xD6E8FEB86659FD93ULL));
+    }
+}
+
+/**
+ * @brief Builds the MinHash signature of the text's n-grams.
+ *
+ * @param text The input text.
+ * @param n The n-gram size.
+ * @param unit Whether n counts characters or words.
+ * @return The signature; all slots stay at UINT64_MAX when the text has no n-grams.
+ *
+ * @throws std::invalid_argument If n is 0.
+ */
+std::vector<uint64_t> GiString::MinHash::signature(std::string_view text, size_t n, NGramRange::Unit unit) const {
+    if (n == 0) {
+        throw std::invalid_argument("n should be greater than 0 (GiString::MinHash::signature)");
+    }
+
+    std::vector<uint64_t> result = empty_signature();
+    for_each_ngram_fingerprint(text, n, unit == NGramRange::Unit::Words,
+                               [this, &result](uint64_t fp) { update(result, fp); });
+    return result;
+}
+
+/**
+ * @brief Returns a signature with every slot at UINT64_MAX, ready for update().
+ */
+std::vector<uint64_t> GiString::MinHash::empty_signature() const {
+    return std::vector<uint64_t>(multipliers_.size(), UINT64_MAX);
+}
+
+/**
+ * @brief Adds one fingerprint to a signature, e.g. when streaming features from several sources.
+ *
+ * @param signature The signature to update; must have been created by this builder.
+ * @param fingerprint The feature fingerprint.
+ */
+void GiString::MinHash::update(std::vector<uint64_t>& signature, uint64_t fingerprint) const {
+    for (size_t i = 0; i < multipliers_.size(); ++i) {
+        uint64_t value = mix64(fingerprint * multipliers_[i] + increments_[i]);
+        if (value < signature[i]) {
+            signature[i] = value;
+        }
+    }
+}
+
+/**
+ * @brief Estimates the Jaccard similarity of the n-gram sets behind two signatures.
+ *
+ * @param a The first signature.
+ * @param b The second signature.
+ * @return The fraction of equal slots (0.0 - 1.0).
+ *
+ * @throws std::invalid_argument If the signatures differ in length from this builder.
+ */
+double GiString::MinHash::similarity(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b) const {
+    if (a.size() != multipliers_.size() || b.size() != multipliers_.size()) {
+        throw std::invalid_argument("Signature length does not match (GiString::MinHash::similarity)");
+    }
+
+    size_t equal = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        equal += a[i] == b[i];
+    }
+    return static_cast<double>(equal) / static_cast<double>(a.size());
+}
+
+// Example usage:
+// GiString::MinHash minhash(128);
+// auto a = minhash.signature("the quick brown fox jumps over the lazy dog", 2, GiString::NGramRange::Unit::Words);
+// auto b = minhash.signature("the quick brown fox jumped over the lazy dog", 2, GiString::NGramRange::Unit::Words);
+// std::cout << "Estimated Jaccard similarity: " << minhash.similarity(a, b) << std::endl;
+
+
 
 
 
@@ -11096,15 +11713,8 @@ void GiString::random_fill(std::string& str, const std::string& charSet, int len
         throw std::invalid_argument("random_fill: Input string or character set cannot be empty.");
     }
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, charSet.size() - 1);
-
-    str.clear();
-    str.reserve(length);
-    for (int i = 0; i < length; ++i) {
-        str.push_back(charSet[dis(gen)]);
-    }
+    str.assign(std::max(length, 0), '\0');
+    GiRandom::local().fill(&str[0], str.size(), charSet);
 }
 
 // Example usage:
@@ -11316,30 +11926,7 @@ int GiString::calculate_reading_time(const std::string& text) {
 
     // Assuming an average reading speed of 200 words per minute
     // and an average word length of 5 characters
-    const int words_per_minute = 200;
-    const int average_word_length = 5;
-    
-    int total_words = 0;
-    int total_characters = 0;
-
-    // Counting words and characters in the text
-    bool in_word = false;
-    for (char c : text) {
-        if (std::isalpha(c)) {
-            total_characters++;
-            if (!in_word) {
-                in_word = true;
-                total_words++;
-            }
-        } else {
-            in_word = false;
-        }
-    }   
-
-    // Calculating the estimated reading time
-    int total_time = total_words * average_word_length / words_per_minute;
-    
-    return total_time;
+    return TextStats(text.data(), text.size()).reading_time();
 }
 
 // Example usage:
@@ -11351,3 +11938,4642 @@ int GiString::calculate_reading_time(const std::string& text) {
 
 
 
+
+
+
+/**
+ * @brief Appends a lowercase stage (GiString::lower restricted to ASCII; other bytes pass through).
+ *
+ * @return Reference to this pipeline for chaining.
+ */
+GiString::Pipeline& GiString::Pipeline::lower() {
+    return add_table("lower", [](unsigned char c) { return static_cast<int16_t>(std::tolower(c)); });
+}
+
+/**
+ * @brief Appends an uppercase stage (GiString::upper restricted to ASCII; other bytes pass through).
+ *
+ * @return Reference to this pipeline for chaining.
+ */
+GiString::Pipeline& GiString::Pipeline::upper() {
+    return add_table("upper", [](unsigned char c) { return static_cast<int16_t>(std::toupper(c)); });
+}
+
+/**
+ * @brief Appends a stage swapping the case of ASCII letters (same mapping as GiString::swapcase).
+ *
+ * @return Reference to this pipeline for chaining.
+ */
+GiString::Pipeline& GiString::Pipeline::swapcase() {
+    return add_table("swapcase", [](unsigned char c) {
+        if (std::islower(c)) {
+            return static_cast<int16_t>(std::toupper(c));
+        }
+        return static_cast<int16_t>(std::tolower(c));
+    });
+}
+
+/**
+ * @brief Appends a stage dropping punctuation (same rule as GiString::remove_punctuation).
+ *
+ * @return Reference to this pipeline for chaining.
+ */
+GiString::Pipeline& GiString::Pipeline::remove_punctuation() {
+    return add_table("remove_punctuation", [](unsigned char c) {
+        return std::ispunct(c) ? static_cast<int16_t>(-1) : static_cast<int16_t>(c);
+    });
+}
+
+/**
+ * @brief Appends a stage dropping every byte contained in charSet.
+ *
+ * @param charSet The bytes to remove.
+ * @return Reference to this pipeline for chaining.
+ */
+GiString::Pipeline& GiString::Pipeline::remove_chars(const std::string& charSet) {
+    std::bitset<256> set;
+    for (char c : charSet) {
+        set.set(static_cast<unsigned char>(c));
+    }
+    return add_table("remove_chars", [&set](unsigned char c) {
+        return set.test(c) ? static_cast<int16_t>(-1) : static_cast<int16_t>(c);
+    });
+}
+
+/**
+ * @brief Appends a stage keeping only the bytes contained in charSet.
+ *
+ * @param charSet The bytes to keep.
+ * @return Reference to this pipeline for chaining.
+ */
+GiString::Pipeline& GiString::Pipeline::keep_chars(const std::string& charSet) {
+    std::bitset<256> set;
+    for (char c : charSet) {
+        set.set(static_cast<unsigned char>(c));
+    }
+    return add_table("keep_chars", [&set](unsigned char c) {
+        return set.test(c) ? static_cast<int16_t>(c) : static_cast<int16_t>(-1);
+    });
+}
+
+/**
+ * @brief Appends a stage replacing every occurrence of one byte with another.
+ *
+ * @param from The byte to replace.
+ * @param to The replacement byte.
+ * @return Reference to this pipeline for chaining.
+ */
+GiString::Pipeline& GiString::Pipeline::replace_char(char from, char to) {
+    unsigned char source = static_cast<unsigned char>(from);
+    unsigned char target = static_cast<unsigned char>(to);
+    return add_table("replace_char", [source, target](unsigned char c) {
+        return static_cast<int16_t>(c == source ? target : c);
+    });
+}
+
+/**
+ * @brief Appends a custom per-byte mapping stage.
+ *
+ * The function is evaluated once per byte value when the stage is added, so it must be pure.
+ *
+ * @param func The mapping function.
+ * @param name The stage name shown in profile reports.
+ * @return Reference to this pipeline for chaining.
+ */
+GiString::Pipeline& GiString::Pipeline::map(std::function<char(char)> func, const std::string& name) {
+    return add_table(name, [&func](unsigned char c) {
+        return static_cast<int16_t>(static_cast<unsigned char>(func(static_cast<char>(c))));
+    });
+}
+
+/**
+ * @brief Appends a custom per-byte filter stage keeping bytes for which the predicate is true.
+ *
+ * The predicate is evaluated once per byte value when the stage is added, so it must be pure.
+ *
+ * @param predicate The filter predicate.
+ * @param name The stage name shown in profile reports.
+ * @return Reference to this pipeline for chaining.
+ */
+GiString::Pipeline& GiString::Pipeline::filter(std::function<bool(char)> predicate, const std::string& name) {
+    return add_table(name, [&predicate](unsigned char c) {
+        return predicate(static_cast<char>(c)) ? static_cast<int16_t>(c) : static_cast<int16_t>(-1);
+    });
+}
+
+/**
+ * @brief Appends a stage collapsing whitespace runs into one space (same rule as GiString::normalize_whitespace).
+ *
+ * @return Reference to this pipeline for chaining.
+ */
+GiString::Pipeline& GiString::Pipeline::normalize_whitespace() {
+    return add_stateful(Kind::CollapseWhitespace, "normalize_whitespace", false, false);
+}
+
+/**
+ * @brief Appends a stage removing leading and trailing whitespace.
+ *
+ * @return Reference to this pipeline for chaining.
+ */
+GiString::Pipeline& GiString::Pipeline::trim() {
+    return add_stateful(Kind::Trim, "trim", true, true);
+}
+
+/**
+ * @brief Appends a stage removing leading whitespace.
+ *
+ * @return Reference to this pipeline for chaining.
+ */
+GiString::Pipeline& GiString::Pipeline::trim_left() {
+    return add_stateful(Kind::Trim, "trim_left", true, false);
+}
+
+/**
+ * @brief Appends a stage removing trailing whitespace.
+ *
+ * Trailing whitespace is held back until the next non-whitespace byte arrives, so only the
+ * current whitespace run is buffered.
+ *
+ * @return Reference to this pipeline for chaining.
+ */
+GiString::Pipeline& GiString::Pipeline::trim_right() {
+    return add_stateful(Kind::Trim, "trim_right", false, true);
+}
+
+/**
+ * @brief Enables or disables per-stage profiling.
+ *
+ * While profiling, stages are not fused: each one runs over the whole chunk in turn so its
+ * time and byte counts can be measured separately.
+ *
+ * @param enabled Whether profiling is enabled.
+ * @return Reference to this pipeline for chaining.
+ */
+GiString::Pipeline& GiString::Pipeline::profile(bool enabled) {
+    profiling_ = enabled;
+    compiled_ = false;
+    return *this;
+}
+
+/**
+ * @brief Runs the pipeline over a string.
+ *
+ * Unlike the single GiString functions, an empty input is not an error and yields an empty result.
+ *
+ * @param input The input string.
+ * @return The transformed string.
+ */
+std::string GiString::Pipeline::run(const std::string& input) {
+    std::string output;
+    output.reserve(input.size());
+    run(input.data(), input.size(), output);
+    return output;
+}
+
+/**
+ * @brief Runs the pipeline over a buffer, appending the result to output.
+ *
+ * @param data Pointer to the input bytes.
+ * @param size Number of input bytes.
+ * @param output The string the result is appended to; its capacity is reused.
+ */
+void GiString::Pipeline::run(const char* data, size_t size, std::string& output) {
+    compile();
+    reset();
+    process(data, size, output);
+    reset();
+}
+
+/**
+ * @brief Runs the pipeline over a stream, delivering the output chunk by chunk.
+ *
+ * @param in The stream to read until EOF.
+ * @param sink Callback receiving each non-empty output chunk.
+ * @param chunk_size Number of bytes read per step.
+ *
+ * @throws std::invalid_argument If chunk_size is 0.
+ */
+void GiString::Pipeline::run(std::istream& in, const Sink& sink, size_t chunk_size) {
+    if (chunk_size == 0) {
+        throw std::invalid_argument("Chunk size must be greater than 0 (GiString::Pipeline::run)");
+    }
+
+    compile();
+    reset();
+
+    std::vector<char> buffer(chunk_size);
+    std::string output;
+    output.reserve(chunk_size);
+    while (in) {
+        in.read(buffer.data(), static_cast<std::streamsize>(chunk_size));
+        std::streamsize got = in.gcount();
+        if (got <= 0) {
+            break;
+        }
+        output.clear();
+        process(buffer.data(), static_cast<size_t>(got), output);
+        if (!output.empty()) {
+            sink(output.data(), output.size());
+        }
+    }
+
+    reset();
+}
+
+/**
+ * @brief Returns the accumulated per-stage costs of all runs since profiling was enabled.
+ *
+ * @return One entry per stage, in pipeline order. Empty when profiling is disabled.
+ */
+const std::vector<GiString::Pipeline::StageProfile>& GiString::Pipeline::profile_report() const {
+    return report_;
+}
+
+GiString::Pipeline& GiString::Pipeline::add_table(const std::string& name, const std::function<int16_t(unsigned char)>& entry) {
+    Stage stage{Kind::Table, name, {}, false, false};
+    for (int c = 0; c < 256; ++c) {
+        stage.table[c] = entry(static_cast<unsigned char>(c));
+    }
+    stages_.push_back(stage);
+    compiled_ = false;
+    return *this;
+}
+
+GiString::Pipeline& GiString::Pipeline::add_stateful(Kind kind, const std::string& name, bool left, bool right) {
+    stages_.push_back(Stage{kind, name, {}, left, right});
+    compiled_ = false;
+    return *this;
+}
+
+void GiString::Pipeline::compile() {
+    if (compiled_) {
+        return;
+    }
+
+    ops_.clear();
+    report_.clear();
+    for (const Stage& stage : stages_) {
+        // Compose consecutive lookup tables into one: drop if either drops, otherwise chain the mappings
+        if (!profiling_ && stage.kind == Kind::Table && !ops_.empty() && ops_.back().kind == Kind::Table) {
+            std::array<int16_t, 256>& fused = ops_.back().table;
+            for (int16_t& entry : fused) {
+                if (entry >= 0) {
+                    entry = stage.table[entry];
+                }
+            }
+            continue;
+        }
+
+        ops_.push_back(Op{stage.kind, stage.table, stage.trim_left, stage.trim_right, false, std::string()});
+        if (profiling_) {
+            StageProfile entry;
+            entry.name = stage.name;
+            report_.push_back(entry);
+        }
+    }
+    compiled_ = true;
+}
+
+void GiString::Pipeline::reset() {
+    for (Op& op : ops_) {
+        op.state = false;
+        op.pending.clear();
+    }
+}
+
+void GiString::Pipeline::push(size_t first, size_t last, unsigned char c, std::string& out) {
+    for (size_t k = first; k < last; ++k) {
+        Op& op = ops_[k];
+        switch (op.kind) {
+        case Kind::Table: {
+            int16_t mapped = op.table[c];
+            if (mapped < 0) {
+                return;
+            }
+            c = static_cast<unsigned char>(mapped);
+            break;
+        }
+        case Kind::CollapseWhitespace:
+            if (std::isspace(c)) {
+                if (op.state) {
+                    return;
+                }
+                op.state = true;
+                c = ' ';
+            } else {
+                op.state = false;
+            }
+            break;
+        case Kind::Trim:
+            if (std::isspace(c)) {
+                if (op.trim_left && !op.state) {
+                    return;
+                }
+                if (op.trim_right) {
+                    op.pending += static_cast<char>(c);
+                    return;
+                }
+            } else {
+                op.state = true;
+                if (!op.pending.empty()) {
+                    // The held-back whitespace turned out to be inner whitespace
+                    for (char held : op.pending) {
+                        push(k + 1, last, static_cast<unsigned char>(held), out);
+                    }
+                    op.pending.clear();
+                }
+            }
+            break;
+        }
+    }
+    out += static_cast<char>(c);
+}
+
+void GiString::Pipeline::process(const char* data, size_t size, std::string& out) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+
+    if (!profiling_) {
+        if (ops_.empty()) {
+            out.append(data, size);
+            return;
+        }
+        if (ops_.size() == 1 && ops_[0].kind == Kind::Table) {
+            const std::array<int16_t, 256>& table = ops_[0].table;
+            for (size_t i = 0; i < size; ++i) {
+                int16_t mapped = table[bytes[i]];
+                if (mapped >= 0) {
+                    out += static_cast<char>(mapped);
+                }
+            }
+            return;
+        }
+        for (size_t i = 0; i < size; ++i) {
+            push(0, ops_.size(), bytes[i], out);
+        }
+        return;
+    }
+
+    // Profiling: run each stage over the whole chunk so it can be timed on its own
+    const char* input = data;
+    size_t input_size = size;
+    for (size_t k = 0; k < ops_.size(); ++k) {
+        std::string& next = scratch_[k % 2];
+        next.clear();
+
+        auto begin = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < input_size; ++i) {
+            push(k, k + 1, static_cast<unsigned char>(input[i]), next);
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        report_[k].bytes_in += input_size;
+        report_[k].bytes_out += next.size();
+        report_[k].time += std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin);
+        input = next.data();
+        input_size = next.size();
+    }
+    out.append(input, input_size);
+}
+
+// Example usage:
+// GiString::Pipeline pipeline;
+// pipeline.remove_punctuation().normalize_whitespace().lower().trim();
+// std::string result = pipeline.run("  Hello,   World!  ");
+// std::cout << result << std::endl;
+// Output: "hello world"
+//
+// std::ifstream in("records.txt");
+// pipeline.profile().run(in, [](const char* data, size_t size) { std::cout.write(data, size); });
+// for (const auto& stage : pipeline.profile_report()) {
+//     std::cout << stage.name << ": " << stage.time.count() << " ns" << std::endl;
+// }
+
+
+
+namespace {
+    enum : uint8_t {
+        stats_word = 1,       // Non-whitespace byte
+        stats_alpha = 2,      // Alphabetic byte
+        stats_terminator = 4  // Sentence terminator ('.', '!', '?')
+    };
+
+    const int stats_field_bits = 21;
+    const uint64_t stats_field_mask = (1ULL << stats_field_bits) - 1;
+    const size_t stats_block_size = 1 << 20; // Keeps each packed edge counter below 2^21
+    const uint64_t stats_hash_base = 0x100000001B3ULL;
+
+    struct StatsTables {
+        uint8_t classes[256];
+        bool punctuation[256];
+        uint64_t rising[8]; // One packed counter field per class bit
+    };
+
+    const StatsTables& stats_tables() {
+        static const StatsTables tables = [] {
+            StatsTables t{};
+            for (int b = 0; b < 256; ++b) {
+                uint8_t cls = 0;
+                if (!std::isspace(b)) {
+                    cls |= stats_word;
+                }
+                if (std::isalpha(b)) {
+                    cls |= stats_alpha;
+                }
+                if (b == '.' || b == '!' || b == '?') {
+                    cls |= stats_terminator;
+                }
+                t.classes[b] = cls;
+                t.punctuation[b] = std::ispunct(b) != 0;
+            }
+            for (int m = 0; m < 8; ++m) {
+                t.rising[m] = ((m & stats_word) ? 1ULL : 0) |
+                              ((m & stats_alpha) ? 1ULL << stats_field_bits : 0) |
+                              ((m & stats_terminator) ? 1ULL << (2 * stats_field_bits) : 0);
+            }
+            return t;
+        }();
+        return tables;
+    }
+
+    uint64_t stats_power(uint64_t exponent) {
+        uint64_t result = 1;
+        uint64_t base = stats_hash_base;
+        while (exponent > 0) {
+            if (exponent & 1) {
+                result *= base;
+            }
+            base *= base;
+            exponent >>= 1;
+        }
+        return result;
+    }
+}
+
+/**
+ * @brief Gathers statistics for one chunk of text.
+ *
+ * The histogram is counted into four interleaved tables fed from 64-bit loads, which avoids
+ * the store-to-load stalls of a single table when the same byte repeats; run edges for
+ * words, alphabetic words and sentence terminators are counted in the same loop.
+ *
+ * @param data Pointer to the chunk bytes.
+ * @param size Number of bytes.
+ * @param vocabulary Whether to also collect distinct words (needed for lexical_density).
+ */
+GiString::TextStats::TextStats(const char* data, size_t size, bool vocabulary) : vocabulary_(vocabulary) {
+    if (size == 0) {
+        return;
+    }
+
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    bytes_ = size;
+    first_byte_ = bytes[0];
+    last_byte_ = bytes[size - 1];
+    first_class_ = stats_tables().classes[first_byte_];
+    last_class_ = stats_tables().classes[last_byte_];
+
+    if (vocabulary_) {
+        scan<true>(bytes, size);
+    } else {
+        scan<false>(bytes, size);
+    }
+}
+
+template <bool Vocabulary>
+void GiString::TextStats::scan(const unsigned char* data, size_t size) {
+    const StatsTables& tables = stats_tables();
+    uint32_t counts[4][256];
+    uint8_t previous = 0;
+    WordPiece current;
+
+    auto track = [&](unsigned char b, uint64_t& edges) {
+        uint8_t cls = tables.classes[b];
+        edges += tables.rising[cls & ~previous];
+        previous = cls;
+        if (Vocabulary) {
+            if (cls & stats_word) {
+                ++current.raw;
+                if (!tables.punctuation[b]) {
+                    current.hash = current.hash * stats_hash_base + b + 1;
+                    ++current.length;
+                }
+            } else if (!split_) {
+                // Bytes before the first whitespace may continue a word from the previous chunk
+                head_ = current;
+                split_ = true;
+                current = WordPiece();
+            } else if (current.raw > 0) {
+                words_seen_.insert(current.hash);
+                current = WordPiece();
+            }
+        }
+    };
+
+    for (size_t pos = 0; pos < size; pos += stats_block_size) {
+        const unsigned char* p = data + pos;
+        size_t block = std::min(size - pos, stats_block_size);
+        std::memset(counts, 0, sizeof(counts));
+        uint64_t edges = 0;
+
+        size_t i = 0;
+        for (; i + 8 <= block; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, p + i, sizeof(word));
+            ++counts[0][word & 0xFF];
+            ++counts[1][(word >> 8) & 0xFF];
+            ++counts[2][(word >> 16) & 0xFF];
+            ++counts[3][(word >> 24) & 0xFF];
+            ++counts[0][(word >> 32) & 0xFF];
+            ++counts[1][(word >> 40) & 0xFF];
+            ++counts[2][(word >> 48) & 0xFF];
+            ++counts[3][word >> 56];
+            for (size_t k = 0; k < 8; ++k) {
+                track(p[i + k], edges);
+            }
+        }
+        for (; i < block; ++i) {
+            ++counts[0][p[i]];
+            track(p[i], edges);
+        }
+
+        for (int b = 0; b < 256; ++b) {
+            histogram_[b] += static_cast<uint64_t>(counts[0][b]) + counts[1][b] + counts[2][b] + counts[3][b];
+        }
+        words_ += edges & stats_field_mask;
+        alpha_words_ += (edges >> stats_field_bits) & stats_field_mask;
+        sentences_ += (edges >> (2 * stats_field_bits)) & stats_field_mask;
+    }
+
+    if (Vocabulary) {
+        if (split_) {
+            tail_ = current;
+        } else {
+            head_ = current;
+        }
+    }
+}
+
+GiString::TextStats::WordPiece GiString::TextStats::concat(const WordPiece& left, const WordPiece& right) {
+    WordPiece joined;
+    joined.hash = left.hash * stats_power(right.length) + right.hash;
+    joined.length = left.length + right.length;
+    joined.raw = left.raw + right.raw;
+    return joined;
+}
+
+/**
+ * @brief Appends the statistics of the chunk that directly follows this one.
+ *
+ * Runs crossing the boundary are counted once. Distinct words are kept only if both sides
+ * collected them; empty chunks carry no information and are absorbed.
+ *
+ * @param next Statistics of the following chunk.
+ */
+void GiString::TextStats::merge(const TextStats& next) {
+    if (next.bytes_ == 0) {
+        return;
+    }
+    if (bytes_ == 0) {
+        *this = next;
+        return;
+    }
+
+    for (int b = 0; b < 256; ++b) {
+        histogram_[b] += next.histogram_[b];
+    }
+    uint8_t joined = last_class_ & next.first_class_;
+    words_ += next.words_ - ((joined & stats_word) ? 1 : 0);
+    alpha_words_ += next.alpha_words_ - ((joined & stats_alpha) ? 1 : 0);
+    sentences_ += next.sentences_ - ((joined & stats_terminator) ? 1 : 0);
+    bytes_ += next.bytes_;
+    last_class_ = next.last_class_;
+    last_byte_ = next.last_byte_;
+
+    if (!vocabulary_ || !next.vocabulary_) {
+        vocabulary_ = false;
+        words_seen_.clear();
+        return;
+    }
+
+    words_seen_.insert(next.words_seen_.begin(), next.words_seen_.end());
+    if (!split_) {
+        head_ = concat(head_, next.head_);
+        if (next.split_) {
+            split_ = true;
+            tail_ = next.tail_;
+        }
+    } else if (!next.split_) {
+        tail_ = concat(tail_, next.head_);
+    } else {
+        WordPiece middle = concat(tail_, next.head_);
+        if (middle.raw > 0) {
+            words_seen_.insert(middle.hash);
+        }
+        tail_ = next.tail_;
+    }
+}
+
+/**
+ * @brief Returns the 256-bin byte histogram.
+ */
+const std::array<uint64_t, 256>& GiString::TextStats::histogram() const {
+    return histogram_;
+}
+
+/**
+ * @brief Returns the number of occurrences of one byte.
+ */
+uint64_t GiString::TextStats::count(unsigned char c) const {
+    return histogram_[c];
+}
+
+/**
+ * @brief Returns the total number of bytes.
+ */
+uint64_t GiString::TextStats::bytes() const {
+    return bytes_;
+}
+
+/**
+ * @brief Returns the number of whitespace-separated words.
+ */
+uint64_t GiString::TextStats::words() const {
+    return words_;
+}
+
+/**
+ * @brief Returns the number of runs of alphabetic characters (the words counted by calculate_reading_time).
+ */
+uint64_t GiString::TextStats::alpha_words() const {
+    return alpha_words_;
+}
+
+/**
+ * @brief Returns the number of sentences, counted as runs of '.', '!' or '?'.
+ */
+uint64_t GiString::TextStats::sentences() const {
+    return sentences_;
+}
+
+/**
+ * @brief Returns the number of lines, counted the same way as std::getline.
+ */
+uint64_t GiString::TextStats::lines() const {
+    if (bytes_ == 0) {
+        return 0;
+    }
+    return histogram_['\n'] + (last_byte_ != '\n' ? 1 : 0);
+}
+
+/**
+ * @brief Returns the number of ASCII letters.
+ */
+uint64_t GiString::TextStats::letters() const {
+    uint64_t total = 0;
+    for (int b = 0; b < 256; ++b) {
+        if (std::isalpha(b)) {
+            total += histogram_[b];
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Returns the number of vowels (a, e, i, o, u in either case).
+ */
+uint64_t GiString::TextStats::vowels() const {
+    uint64_t total = 0;
+    for (char v : std::string("aeiouAEIOU")) {
+        total += histogram_[static_cast<unsigned char>(v)];
+    }
+    return total;
+}
+
+/**
+ * @brief Returns the number of ASCII consonants.
+ */
+uint64_t GiString::TextStats::consonants() const {
+    return letters() - vowels();
+}
+
+/**
+ * @brief Returns the number of decimal digits.
+ */
+uint64_t GiString::TextStats::digits() const {
+    uint64_t total = 0;
+    for (int b = '0'; b <= '9'; ++b) {
+        total += histogram_[b];
+    }
+    return total;
+}
+
+/**
+ * @brief Returns the number of whitespace bytes.
+ */
+uint64_t GiString::TextStats::whitespace() const {
+    uint64_t total = 0;
+    for (int b = 0; b < 256; ++b) {
+        if (std::isspace(b)) {
+            total += histogram_[b];
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Returns the number of punctuation bytes.
+ */
+uint64_t GiString::TextStats::punctuation() const {
+    uint64_t total = 0;
+    for (int b = 0; b < 256; ++b) {
+        if (std::ispunct(b)) {
+            total += histogram_[b];
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Returns the most frequent byte; ties go to the first byte of the text, then to the lowest value.
+ *
+ * @throws std::logic_error If no text was counted.
+ */
+char GiString::TextStats::most_common_char() const {
+    if (bytes_ == 0) {
+        throw std::logic_error("No text was counted (GiString::TextStats::most_common_char)");
+    }
+
+    int best = first_byte_;
+    for (int b = 0; b < 256; ++b) {
+        if (histogram_[b] > histogram_[best]) {
+            best = b;
+        }
+    }
+    return static_cast<char>(best);
+}
+
+/**
+ * @brief Returns the least frequent byte present; ties go to the first byte of the text, then to the lowest value.
+ *
+ * @throws std::logic_error If no text was counted.
+ */
+char GiString::TextStats::least_common_char() const {
+    if (bytes_ == 0) {
+        throw std::logic_error("No text was counted (GiString::TextStats::least_common_char)");
+    }
+
+    int best = first_byte_;
+    for (int b = 0; b < 256; ++b) {
+        if (histogram_[b] > 0 && histogram_[b] < histogram_[best]) {
+            best = b;
+        }
+    }
+    return static_cast<char>(best);
+}
+
+/**
+ * @brief Returns the estimated reading time in minutes (200 words per minute, 5 characters per word).
+ */
+int GiString::TextStats::reading_time() const {
+    const uint64_t words_per_minute = 200;
+    const uint64_t average_word_length = 5;
+    return static_cast<int>(alpha_words_ * average_word_length / words_per_minute);
+}
+
+/**
+ * @brief Returns the ratio of distinct words (punctuation removed) to whitespace-delimited slots.
+ *
+ * @throws std::logic_error If the statistics were gathered without vocabulary collection.
+ */
+double GiString::TextStats::lexical_density() const {
+    if (!vocabulary_) {
+        throw std::logic_error("Vocabulary was not collected (GiString::TextStats::lexical_density)");
+    }
+
+    // The pieces at both ends are complete words once no further chunk follows
+    size_t unique = words_seen_.size();
+    bool head_counted = false;
+    if (head_.raw > 0 && words_seen_.count(head_.hash) == 0) {
+        ++unique;
+        head_counted = true;
+    }
+    if (split_ && tail_.raw > 0 && words_seen_.count(tail_.hash) == 0 &&
+        !(head_counted && tail_.hash == head_.hash)) {
+        ++unique;
+    }
+
+    return static_cast<double>(unique) / static_cast<double>(whitespace() + 1);
+}
+
+/**
+ * @brief Computes text statistics in a single pass.
+ *
+ * @param text The input text.
+ * @param vocabulary Whether to also collect distinct words (needed for lexical_density).
+ * @return The statistics.
+ */
+GiString::TextStats GiString::text_stats(const std::string& text, bool vocabulary) {
+    return TextStats(text.data(), text.size(), vocabulary);
+}
+
+/**
+ * @brief Computes text statistics over a stream, one chunk at a time.
+ *
+ * @param in The stream to read until EOF.
+ * @param vocabulary Whether to also collect distinct words.
+ * @param chunk_size Number of bytes read per step.
+ * @return The merged statistics.
+ *
+ * @throws std::invalid_argument If chunk_size is 0.
+ */
+GiString::TextStats GiString::text_stats(std::istream& in, bool vocabulary, size_t chunk_size) {
+    if (chunk_size == 0) {
+        throw std::invalid_argument("Chunk size must be greater than 0 (GiString::text_stats)");
+    }
+
+    TextStats total(nullptr, 0, vocabulary);
+    std::vector<char> buffer(chunk_size);
+    while (in) {
+        in.read(buffer.data(), static_cast<std::streamsize>(chunk_size));
+        std::streamsize got = in.gcount();
+        if (got <= 0) {
+            break;
+        }
+        total.merge(TextStats(buffer.data(), static_cast<size_t>(got), vocabulary));
+    }
+    return total;
+}
+
+/**
+ * @brief Computes text statistics by splitting the text across threads and merging the chunks in order.
+ *
+ * Inputs smaller than 1 MiB per thread fall back to the single-threaded pass.
+ *
+ * @param text The input text.
+ * @param threads Number of threads; 0 uses std::thread::hardware_concurrency().
+ * @param vocabulary Whether to also collect distinct words.
+ * @return The merged statistics.
+ */
+GiString::TextStats GiString::text_stats_parallel(const std::string& text, size_t threads, bool vocabulary) {
+    const size_t min_chunk = 1 << 20;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, std::max<size_t>(1, text.size() / min_chunk));
+    if (threads <= 1) {
+        return TextStats(text.data(), text.size(), vocabulary);
+    }
+
+    std::vector<TextStats> partial(threads);
+    std::vector<std::thread> workers;
+    size_t chunk = text.size() / threads;
+    for (size_t t = 0; t < threads; ++t) {
+        size_t begin = t * chunk;
+        size_t end = (t + 1 == threads) ? text.size() : begin + chunk;
+        workers.emplace_back([&text, &partial, t, begin, end, vocabulary] {
+            partial[t] = TextStats(text.data() + begin, end - begin, vocabulary);
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    TextStats total = partial[0];
+    for (size_t t = 1; t < threads; ++t) {
+        total.merge(partial[t]);
+    }
+    return total;
+}
+
+// Example usage:
+// GiString gs;
+// GiString::TextStats stats = gs.text_stats("Hello world. How are you?", true);
+// std::cout << stats.words() << " words, " << stats.sentences() << " sentences, "
+//           << stats.vowels() << " vowels, density " << stats.lexical_density() << std::endl;
+// Output: "5 words, 2 sentences, 8 vowels, density 1"
+
+
+
+namespace {
+    // Splits [0, size) into a few chunks per thread, each a multiple of align bytes
+    // (except the last) and at least 64 KiB
+    std::vector<size_t> chunk_bounds(size_t size, size_t threads, size_t align) {
+        size_t chunk = std::max<size_t>(64 * 1024, size / (threads * 4) + 1);
+        chunk = (chunk + align - 1) / align * align;
+        std::vector<size_t> bounds;
+        for (size_t begin = 0; begin < size; begin += chunk) {
+            bounds.push_back(begin);
+        }
+        bounds.push_back(size);
+        return bounds;
+    }
+
+    struct CharWriter
+    {
+        char* data;
+        void push_back(char c) { *data++ = c; }
+    };
+
+    // Upper or lower case conversion of chunks split at code point boundaries. ASCII chunks
+    // are converted straight into the result; the others are mapped into a buffer first,
+    // since their length can change.
+    std::string convert_case_parallel(const std::string& str, GiUnicode::CaseMapping mapping, GiExecutor& executor) {
+        std::vector<size_t> bounds = chunk_bounds(str.size(), executor.concurrency(), 1);
+        for (size_t k = 1; k + 1 < bounds.size(); ++k) {
+            // A UTF-8 sequence is at most four bytes, so the serial scan can not run past
+            // three continuation bytes
+            for (int step = 0; step < 3 && bounds[k] < str.size() && (static_cast<unsigned char>(str[bounds[k]]) & 0xC0) == 0x80; ++step) {
+                ++bounds[k];
+            }
+            bounds[k] = std::max(bounds[k], bounds[k - 1]);
+        }
+
+        size_t chunks = bounds.size() - 1;
+        std::vector<std::string> mapped(chunks);
+        std::vector<char> ascii(chunks, 0);
+        std::vector<size_t> offsets(bounds.size(), 0);
+        executor.parallel_for(0, chunks, 1, [&](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; ++k) {
+                const char* data = str.data() + bounds[k];
+                size_t size = bounds[k + 1] - bounds[k];
+                ascii[k] = GiUnicode::is_ascii(data, size);
+                if (!ascii[k]) {
+                    GiUnicode::convert_case(data, size, mapping, mapped[k]);
+                }
+                offsets[k + 1] = ascii[k] ? size : mapped[k].size();
+            }
+        });
+        for (size_t k = 1; k < offsets.size(); ++k) {
+            offsets[k] += offsets[k - 1];
+        }
+
+        std::string result(offsets.back(), '\0');
+        executor.parallel_for(0, chunks, 1, [&](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; ++k) {
+                if (!ascii[k]) {
+                    std::copy(mapped[k].begin(), mapped[k].end(), &result[0] + offsets[k]);
+                    continue;
+                }
+                CharWriter out{&result[0] + offsets[k]};
+                std::string_view chunk(str.data() + bounds[k], bounds[k + 1] - bounds[k]);
+                if (mapping == GiUnicode::CaseMapping::upper) {
+                    GiStringCore::upper(chunk, out);
+                } else {
+                    GiStringCore::lower(chunk, out);
+                }
+            }
+        });
+        return result;
+    }
+
+    // Leftmost non-overlapping matches of sub starting in [begin, end), scanning from begin
+    struct MatchChunk
+    {
+        std::vector<size_t> positions; // The first `limit` match positions
+        size_t count = 0;
+        size_t exit = 0;               // End of the last match, or begin if there is none
+    };
+
+    // Only matches starting before end are of interest, so the search never looks past
+    // end + |sub| - 1 bytes
+    std::string_view match_window(const std::string& str, size_t end, size_t sub_size) {
+        return std::string_view(str.data(), std::min(str.size(), end + sub_size - 1));
+    }
+
+    MatchChunk scan_matches(const std::string& str, const std::string& sub, size_t begin, size_t end, size_t limit) {
+        MatchChunk chunk;
+        chunk.exit = begin;
+        std::string_view window = match_window(str, end, sub.size());
+        for (size_t pos = window.find(sub, begin); pos != std::string_view::npos && pos < end; pos = window.find(sub, pos + sub.size())) {
+            if (chunk.positions.size() < limit) {
+                chunk.positions.push_back(pos);
+            }
+            ++chunk.count;
+            chunk.exit = pos + sub.size();
+        }
+        return chunk;
+    }
+
+    // Serial pass that corrects each chunk for a match carried over from the previous one:
+    // when the true scan enters a chunk after its start, it is rescanned until it lands on
+    // one of the chunk's own match positions, from where the two scans agree. Returns the
+    // entry point of every chunk plus the end of the input; with keep set, the positions
+    // of each chunk are trimmed to the final match list.
+    std::vector<size_t> stitch_matches(const std::string& str, const std::string& sub, const std::vector<size_t>& bounds,
+                                       std::vector<MatchChunk>& chunks, bool keep) {
+        std::vector<size_t> entries;
+        size_t entry = 0;
+        for (size_t k = 0; k < chunks.size(); ++k) {
+            MatchChunk& chunk = chunks[k];
+            size_t begin = std::max(bounds[k], entry);
+            entries.push_back(begin);
+            if (begin == bounds[k]) {
+                entry = chunk.exit;
+                continue;
+            }
+
+            std::string_view window = match_window(str, bounds[k + 1], sub.size());
+            std::vector<size_t> rescanned;
+            size_t count = 0;
+            size_t exit = begin;
+            bool synced = false;
+            for (size_t pos = window.find(sub, begin); pos != std::string_view::npos && pos < bounds[k + 1]; pos = window.find(sub, pos + sub.size())) {
+                auto it = std::lower_bound(chunk.positions.begin(), chunk.positions.end(), pos);
+                if (it != chunk.positions.end() && *it == pos) {
+                    size_t index = static_cast<size_t>(it - chunk.positions.begin());
+                    if (keep) {
+                        rescanned.insert(rescanned.end(), it, chunk.positions.end());
+                    }
+                    count += chunk.count - index;
+                    exit = chunk.exit;
+                    synced = true;
+                    break;
+                }
+                if (keep) {
+                    rescanned.push_back(pos);
+                }
+                ++count;
+                exit = pos + sub.size();
+            }
+            chunk.count = count;
+            chunk.exit = synced ? chunk.exit : exit;
+            if (keep) {
+                chunk.positions.swap(rescanned);
+            }
+            entry = chunk.exit;
+        }
+        entries.push_back(std::max(str.size(), entry));
+        return entries;
+    }
+}
+
+/**
+ * @brief Counts non-overlapping occurrences of a substring using several threads.
+ *
+ * The input is cut into chunks that are scanned in parallel; a serial pass then fixes up
+ * matches that straddle chunk boundaries, so the result always equals count().
+ *
+ * @param str The input string.
+ * @param sub The substring to count.
+ * @param threshold Inputs shorter than this many bytes are counted on the calling thread.
+ * @param executor The pool to run on.
+ * @return The number of non-overlapping occurrences.
+ *
+ * @throws std::invalid_argument If the input or substring is empty.
+ */
+size_t GiString::count_parallel(const std::string& str, const std::string& sub, size_t threshold, GiExecutor& executor) {
+    if (str.empty() || str.size() < threshold || executor.concurrency() == 1) {
+        return count(str, sub);
+    }
+    if (sub.empty()) {
+        throw std::invalid_argument("Substring is empty (GiString::count)");
+    }
+
+    // Only the first few positions of each chunk are needed to resynchronize after a
+    // straddling match; the rest are just counted
+    const size_t kept_positions = 64;
+    std::vector<size_t> bounds = chunk_bounds(str.size(), executor.concurrency(), 1);
+    std::vector<MatchChunk> chunks(bounds.size() - 1);
+    executor.parallel_for(0, chunks.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            chunks[k] = scan_matches(str, sub, bounds[k], bounds[k + 1], kept_positions);
+        }
+    });
+    stitch_matches(str, sub, bounds, chunks, false);
+
+    size_t total = 0;
+    for (const MatchChunk& chunk : chunks) {
+        total += chunk.count;
+    }
+    return total;
+}
+
+/**
+ * @brief Replaces all non-overlapping occurrences of a substring using several threads.
+ *
+ * Matches are found per chunk in parallel and stitched across chunk boundaries; each
+ * chunk's output size is then known, so all chunks write straight into one preallocated
+ * result. The output always equals replace().
+ *
+ * @param str The input string.
+ * @param old_sub The substring to be replaced.
+ * @param new_sub The replacement.
+ * @param threshold Inputs shorter than this many bytes are processed on the calling thread.
+ * @param executor The pool to run on.
+ * @return The string with replacements performed.
+ *
+ * @throws std::invalid_argument If the input string or old substring is empty.
+ */
+std::string GiString::replace_parallel(const std::string& str, const std::string& old_sub, const std::string& new_sub,
+                                       size_t threshold, GiExecutor& executor) {
+    if (str.empty() || str.size() < threshold || executor.concurrency() == 1) {
+        return replace(str, old_sub, new_sub);
+    }
+    if (old_sub.empty()) {
+        throw std::invalid_argument("Old substring is empty (GiString::replace)");
+    }
+
+    std::vector<size_t> bounds = chunk_bounds(str.size(), executor.concurrency(), 1);
+    std::vector<MatchChunk> chunks(bounds.size() - 1);
+    executor.parallel_for(0, chunks.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            chunks[k] = scan_matches(str, old_sub, bounds[k], bounds[k + 1], static_cast<size_t>(-1));
+        }
+    });
+    std::vector<size_t> entries = stitch_matches(str, old_sub, bounds, chunks, true);
+
+    // Chunk k produces the output for input [entries[k], entries[k + 1])
+    std::vector<size_t> offsets(chunks.size() + 1, 0);
+    for (size_t k = 0; k < chunks.size(); ++k) {
+        offsets[k + 1] = offsets[k] + (entries[k + 1] - entries[k]) - chunks[k].count * old_sub.size() + chunks[k].count * new_sub.size();
+    }
+
+    std::string result(offsets.back(), '\0');
+    executor.parallel_for(0, chunks.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            char* out = &result[0] + offsets[k];
+            size_t start = entries[k];
+            for (size_t pos : chunks[k].positions) {
+                out = std::copy(str.data() + start, str.data() + pos, out);
+                out = std::copy(new_sub.begin(), new_sub.end(), out);
+                start = pos + old_sub.size();
+            }
+            std::copy(str.data() + start, str.data() + entries[k + 1], out);
+        }
+    });
+    return result;
+}
+
+/**
+ * @brief Converts a string to uppercase using several threads.
+ *
+ * Chunks end on UTF-8 code point boundaries, so multi-byte characters are never split.
+ *
+ * @param str The input string.
+ * @param threshold Inputs shorter than this many bytes are converted on the calling thread.
+ * @param executor The pool to run on.
+ * @return The uppercase string, equal to upper().
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+std::string GiString::upper_parallel(const std::string& str, size_t threshold, GiExecutor& executor) {
+    if (str.empty() || str.size() < threshold || executor.concurrency() == 1) {
+        return upper(str);
+    }
+    return convert_case_parallel(str, GiUnicode::CaseMapping::upper, executor);
+}
+
+/**
+ * @brief Converts a string to lowercase using several threads.
+ *
+ * Chunks end on UTF-8 code point boundaries, so multi-byte characters are never split.
+ *
+ * @param str The input string.
+ * @param threshold Inputs shorter than this many bytes are converted on the calling thread.
+ * @param executor The pool to run on.
+ * @return The lowercase string, equal to lower().
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+std::string GiString::lower_parallel(const std::string& str, size_t threshold, GiExecutor& executor) {
+    if (str.empty() || str.size() < threshold || executor.concurrency() == 1) {
+        return lower(str);
+    }
+    return convert_case_parallel(str, GiUnicode::CaseMapping::lower, executor);
+}
+
+/**
+ * @brief Converts a string to hexadecimal using several threads.
+ *
+ * Each chunk's output length is measured in a first parallel pass, so the second pass
+ * writes every chunk directly into place.
+ *
+ * @param str The input string.
+ * @param threshold Inputs shorter than this many bytes are converted on the calling thread.
+ * @param executor The pool to run on.
+ * @return The hexadecimal string, equal to to_hex().
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+std::string GiString::to_hex_parallel(const std::string& str, size_t threshold, GiExecutor& executor) {
+    if (str.empty() || str.size() < threshold || executor.concurrency() == 1) {
+        return to_hex(str);
+    }
+
+    std::vector<size_t> bounds = chunk_bounds(str.size(), executor.concurrency(), 1);
+    std::vector<size_t> offsets(bounds.size(), 0);
+    executor.parallel_for(0, bounds.size() - 1, 1, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            offsets[k + 1] = legacy_hex_length(std::string_view(str).substr(bounds[k], bounds[k + 1] - bounds[k]));
+        }
+    });
+    for (size_t k = 1; k < offsets.size(); ++k) {
+        offsets[k] += offsets[k - 1];
+    }
+
+    std::string result(offsets.back(), '\0');
+    executor.parallel_for(0, bounds.size() - 1, 1, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            CharWriter out{&result[0] + offsets[k]};
+            append_legacy_hex(std::string_view(str).substr(bounds[k], bounds[k + 1] - bounds[k]), out);
+        }
+    });
+    return result;
+}
+
+/**
+ * @brief Encodes a string to Base64 using several threads.
+ *
+ * Chunks are multiples of three bytes, so each one maps to a fixed slice of the output.
+ *
+ * @param str The input string.
+ * @param threshold Inputs shorter than this many bytes are encoded on the calling thread.
+ * @param executor The pool to run on.
+ * @return The encoded string, equal to base64_encode().
+ */
+std::string GiString::base64_encode_parallel(const std::string& str, size_t threshold, GiExecutor& executor) {
+    if (str.empty() || str.size() < threshold || executor.concurrency() == 1) {
+        return base64_encode(str);
+    }
+
+    std::vector<size_t> bounds = chunk_bounds(str.size(), executor.concurrency(), 3);
+    std::string result((str.size() + 2) / 3 * 4, '\0');
+    executor.parallel_for(0, bounds.size() - 1, 1, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            CharWriter out{&result[0] + bounds[k] / 3 * 4};
+            GiStringCore::base64_encode(std::string_view(str).substr(bounds[k], bounds[k + 1] - bounds[k]), out);
+        }
+    });
+    return result;
+}
+
+/**
+ * @brief Finds the positions of all (possibly overlapping) occurrences of a pattern using several threads.
+ *
+ * Each chunk reports the matches that start inside it, reading up to |pattern| - 1 bytes
+ * past its end, and the per-chunk lists are concatenated in order.
+ *
+ * @param pattern The pattern to search for.
+ * @param text The text to search in.
+ * @param threshold Texts shorter than this many bytes are searched on the calling thread.
+ * @param executor The pool to run on.
+ * @return The positions, equal to find_all_patterns().
+ *
+ * @throws std::invalid_argument If the pattern is empty.
+ */
+std::vector<size_t> GiString::find_all_patterns_parallel(const std::string& pattern, const std::string& text,
+                                                         size_t threshold, GiExecutor& executor) {
+    if (text.empty() || text.size() < threshold || executor.concurrency() == 1) {
+        return find_all_patterns(pattern, text);
+    }
+    if (pattern.empty()) {
+        throw std::invalid_argument("find_all_patterns: Error - The pattern cannot be empty.");
+    }
+
+    std::vector<size_t> bounds = chunk_bounds(text.size(), executor.concurrency(), 1);
+    std::vector<std::vector<size_t>> found(bounds.size() - 1);
+    executor.parallel_for(0, found.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            std::string_view window = match_window(text, bounds[k + 1], pattern.size());
+            for (size_t pos = window.find(pattern, bounds[k]); pos != std::string_view::npos && pos < bounds[k + 1]; pos = window.find(pattern, pos + 1)) {
+                found[k].push_back(pos);
+            }
+        }
+    });
+
+    std::vector<size_t> positions;
+    for (const std::vector<size_t>& chunk : found) {
+        positions.insert(positions.end(), chunk.begin(), chunk.end());
+    }
+    return positions;
+}
+
+// Example usage:
+// GiString gs;
+// std::string log = read_file("access.log");                 // several gigabytes
+// size_t errors = gs.count_parallel(log, " 500 ");
+// std::string redacted = gs.replace_parallel(log, "password=", "password=***");
+// std::string small = gs.upper_parallel("short input");       // below the threshold: runs serially
+// std::cout << errors << " " << small << std::endl;
+
+
+
+namespace {
+    // Tokenizes like repeated std::getline: a trailing empty token is not produced
+    std::vector<std::string_view> split_view(std::string_view str, char delimiter) {
+        std::vector<std::string_view> tokens;
+        size_t start = 0;
+        while (start < str.size()) {
+            size_t pos = str.find(delimiter, start);
+            if (pos == std::string_view::npos) {
+                tokens.push_back(str.substr(start));
+                break;
+            }
+            tokens.push_back(str.substr(start, pos - start));
+            start = pos + 1;
+        }
+        return tokens;
+    }
+}
+
+/**
+ * @brief Returns a view of the range [start, end) of the input.
+ *
+ * @throws std::out_of_range If the indices are out of range.
+ * @throws std::invalid_argument If start is not less than end.
+ */
+std::string_view GiString::views::substring(std::string_view str, size_t start, size_t end) {
+    if (start >= str.length()) {
+        throw std::out_of_range("Start index out of range (GiString::substring)");
+    }
+    if (end > str.length()) {
+        throw std::out_of_range("End index out of range (GiString::substring)");
+    }
+    if (start >= end) {
+        throw std::invalid_argument("Start index must be less than end index (GiString::substring)");
+    }
+    return str.substr(start, end - start);
+}
+
+/**
+ * @brief Returns a view of the range [start, end) of the input; an empty range is allowed.
+ *
+ * @throws std::out_of_range If the indices are out of range.
+ * @throws std::invalid_argument If end is less than start.
+ */
+std::string_view GiString::views::slice(std::string_view str, size_t start, size_t end) {
+    if (start >= str.length()) {
+        throw std::out_of_range("Start index is out of range (GiString::slice)");
+    }
+    if (end > str.length()) {
+        throw std::out_of_range("End index is out of range (GiString::slice)");
+    }
+    if (end < start) {
+        throw std::invalid_argument("End index is less than the start index (GiString::slice)");
+    }
+    return str.substr(start, end - start);
+}
+
+/**
+ * @brief Returns a view of the part after the first separator, or an empty view if it is absent.
+ *
+ * @throws std::invalid_argument If the input is empty.
+ */
+std::string_view GiString::views::substring_after(std::string_view str, std::string_view separator) {
+    if (str.empty()) {
+        throw std::invalid_argument("substring_after: Input string is empty");
+    }
+    size_t pos = str.find(separator);
+    if (pos == std::string_view::npos) {
+        return std::string_view();
+    }
+    return str.substr(pos + separator.length());
+}
+
+/**
+ * @brief Returns a view of the part before the first separator, or the whole input if it is absent.
+ *
+ * @throws std::invalid_argument If the input is empty.
+ */
+std::string_view GiString::views::substring_before(std::string_view str, std::string_view separator) {
+    if (str.empty()) {
+        throw std::invalid_argument("substring_before: Input string is empty.");
+    }
+    size_t pos = str.find(separator);
+    if (pos == std::string_view::npos) {
+        return str;
+    }
+    return str.substr(0, pos);
+}
+
+/**
+ * @brief Returns a view of the text between the first startDelim and the following endDelim.
+ *
+ * @throws std::invalid_argument If either delimiter is not found.
+ */
+std::string_view GiString::views::substring_between(std::string_view str, std::string_view startDelim, std::string_view endDelim) {
+    size_t startPos = str.find(startDelim);
+    if (startPos == std::string_view::npos) {
+        throw std::invalid_argument("substring_between: Start delimiter not found in the input string.");
+    }
+    startPos += startDelim.length();
+    size_t endPos = str.find(endDelim, startPos);
+    if (endPos == std::string_view::npos) {
+        throw std::invalid_argument("substring_between: End delimiter not found in the input string.");
+    }
+    return str.substr(startPos, endPos - startPos);
+}
+
+/**
+ * @brief Splits the input around the first separator into {before, separator, after}.
+ *
+ * @throws std::invalid_argument If the input is empty.
+ */
+std::array<std::string_view, 3> GiString::views::partition(std::string_view str, std::string_view separator) {
+    if (str.empty()) {
+        throw std::invalid_argument("GiString::partition: Input string is empty.");
+    }
+    size_t pos = str.find(separator);
+    if (pos == std::string_view::npos) {
+        return {str, std::string_view(), std::string_view()};
+    }
+    return {str.substr(0, pos), str.substr(pos, separator.length()), str.substr(pos + separator.length())};
+}
+
+/**
+ * @brief Splits the input around the last delimiter into {before, delimiter, after}.
+ *
+ * @throws std::invalid_argument If the input is empty.
+ */
+std::tuple<std::string_view, std::string_view, std::string_view> GiString::views::rpartition(std::string_view str, std::string_view delimiter) {
+    if (str.empty()) {
+        throw std::invalid_argument("GiString::rpartition: Error - Input string is empty.");
+    }
+    size_t pos = str.rfind(delimiter);
+    if (pos == std::string_view::npos) {
+        return std::make_tuple(str, std::string_view(), std::string_view());
+    }
+    return std::make_tuple(str.substr(0, pos), str.substr(pos, delimiter.length()), str.substr(pos + delimiter.length()));
+}
+
+/**
+ * @brief Splits the input into the views before and from the index.
+ *
+ * @throws std::invalid_argument If the index is out of range.
+ */
+std::pair<std::string_view, std::string_view> GiString::views::split_at(std::string_view str, size_t index) {
+    if (index >= str.length()) {
+        throw std::invalid_argument("Index out of range: split_at");
+    }
+    return std::make_pair(str.substr(0, index), str.substr(index));
+}
+
+/**
+ * @brief Returns a view without the last character.
+ *
+ * @throws std::invalid_argument If the input is empty.
+ */
+std::string_view GiString::views::chop(std::string_view str) {
+    if (str.empty()) {
+        throw std::invalid_argument("GiString::chop: Input string is empty");
+    }
+    return str.substr(0, str.size() - 1);
+}
+
+/**
+ * @brief Returns a view without leading and trailing whitespace.
+ *
+ * @throws std::invalid_argument If the input is empty.
+ */
+std::string_view GiString::views::trim(std::string_view str) {
+    if (str.empty()) {
+        throw std::invalid_argument("Input string is empty");
+    }
+    return GiStringCore::trim(str);
+}
+
+/**
+ * @brief Returns a view without leading whitespace.
+ *
+ * @throws std::invalid_argument If the input is empty.
+ */
+std::string_view GiString::views::trim_left(std::string_view str) {
+    if (str.empty()) {
+        throw std::invalid_argument("Input string is empty");
+    }
+    return ltrim(str);
+}
+
+/**
+ * @brief Returns a view without trailing whitespace.
+ *
+ * @throws std::invalid_argument If the input is empty.
+ */
+std::string_view GiString::views::trim_right(std::string_view str) {
+    if (str.empty()) {
+        throw std::invalid_argument("Input string is empty");
+    }
+    return rtrim(str);
+}
+
+/**
+ * @brief Returns a view without leading whitespace; an empty input is allowed.
+ */
+std::string_view GiString::views::ltrim(std::string_view str) {
+    return GiStringCore::ltrim(str);
+}
+
+/**
+ * @brief Returns a view without trailing whitespace; an empty input is allowed.
+ */
+std::string_view GiString::views::rtrim(std::string_view str) {
+    return GiStringCore::rtrim(str);
+}
+
+/**
+ * @brief Splits the input on a delimiter into views, with the same tokens as GiString::split.
+ *
+ * @throws std::invalid_argument If the delimiter is '\0'.
+ */
+std::vector<std::string_view> GiString::views::split(std::string_view str, char delimiter) {
+    if (delimiter == '\0') {
+        throw std::invalid_argument("Delimiter cannot be empty (GiString::split)");
+    }
+    return split_view(str, delimiter);
+}
+
+/**
+ * @brief Splits the input into line views, with the same lines as GiString::split_lines.
+ *
+ * @throws std::invalid_argument If the input is empty.
+ */
+std::vector<std::string_view> GiString::views::split_lines(std::string_view str) {
+    if (str.empty()) {
+        throw std::invalid_argument("split_lines: Input string is empty.");
+    }
+    return split_view(str, '\n');
+}
+
+/**
+ * @brief Returns a view of the fieldIndex-th delimiter-separated field.
+ *
+ * @throws std::invalid_argument If the input is empty or the index is out of range.
+ */
+std::string_view GiString::views::extract_field(std::string_view input, char delimiter, int fieldIndex) {
+    if (input.empty()) {
+        throw std::invalid_argument("GiString::extract_field: Input string is empty.");
+    }
+    if (fieldIndex < 0) {
+        throw std::invalid_argument("GiString::extract_field: Field index is out of range.");
+    }
+
+    size_t start = 0;
+    for (int field = 0; start < input.size(); ++field) {
+        size_t pos = input.find(delimiter, start);
+        if (field == fieldIndex) {
+            return input.substr(start, pos == std::string_view::npos ? std::string_view::npos : pos - start);
+        }
+        if (pos == std::string_view::npos) {
+            break;
+        }
+        start = pos + 1;
+    }
+    throw std::invalid_argument("GiString::extract_field: Field index is out of range.");
+}
+
+/**
+ * @brief Counts non-overlapping occurrences of sub.
+ *
+ * @throws std::invalid_argument If the input or substring is empty.
+ */
+size_t GiString::views::count(std::string_view str, std::string_view sub) {
+    if (str.empty()) {
+        throw std::invalid_argument("Input string is empty (GiString::count)");
+    }
+    if (sub.empty()) {
+        throw std::invalid_argument("Substring is empty (GiString::count)");
+    }
+    return GiStringCore::count(str, sub);
+}
+
+/**
+ * @brief Counts non-overlapping occurrences of substring.
+ *
+ * @throws std::invalid_argument If the input or substring is empty.
+ */
+int GiString::views::count_substring(std::string_view str, std::string_view substring) {
+    if (str.empty() || substring.empty()) {
+        throw std::invalid_argument("count_substring: Input string or substring is empty.");
+    }
+    int total = 0;
+    size_t pos = 0;
+    while ((pos = str.find(substring, pos)) != std::string_view::npos) {
+        ++total;
+        pos += substring.length();
+    }
+    return total;
+}
+
+/**
+ * @brief Returns the position of the first occurrence of sub, or npos.
+ *
+ * @throws std::invalid_argument If the input or substring is empty.
+ */
+size_t GiString::views::find(std::string_view str, std::string_view sub) {
+    if (str.empty()) {
+        throw std::invalid_argument("Input string is empty (GiString::find)");
+    }
+    if (sub.empty()) {
+        throw std::invalid_argument("Substring is empty (GiString::find)");
+    }
+    return GiStringCore::find(str, sub);
+}
+
+/**
+ * @brief Returns the position of the last occurrence of sub, or npos.
+ *
+ * @throws std::invalid_argument If the input or substring is empty.
+ */
+size_t GiString::views::rfind(std::string_view str, std::string_view sub) {
+    if (str.empty()) {
+        throw std::invalid_argument("Input string is empty (GiString::rfind)");
+    }
+    if (sub.empty()) {
+        throw std::invalid_argument("Substring is empty (GiString::rfind)");
+    }
+    return GiStringCore::rfind(str, sub);
+}
+
+/**
+ * @brief Checks whether sub occurs in the input.
+ *
+ * @throws std::invalid_argument If the input or substring is empty.
+ */
+bool GiString::views::contains(std::string_view str, std::string_view sub) {
+    if (str.empty()) {
+        throw std::invalid_argument("Input string is empty (GiString::contains)");
+    }
+    if (sub.empty()) {
+        throw std::invalid_argument("Substring is empty (GiString::contains)");
+    }
+    return GiStringCore::contains(str, sub);
+}
+
+/**
+ * @brief Checks whether the input starts with prefix.
+ *
+ * @throws std::invalid_argument If the input or prefix is empty.
+ */
+bool GiString::views::startswith(std::string_view str, std::string_view prefix) {
+    if (str.empty()) {
+        throw std::invalid_argument("Input string is empty (GiString::startswith)");
+    }
+    if (prefix.empty()) {
+        throw std::invalid_argument("Prefix is empty (GiString::startswith)");
+    }
+    return GiStringCore::startswith(str, prefix);
+}
+
+/**
+ * @brief Checks whether the input ends with suffix.
+ *
+ * @throws std::invalid_argument If the input or suffix is empty.
+ */
+bool GiString::views::endswith(std::string_view str, std::string_view suffix) {
+    if (str.empty()) {
+        throw std::invalid_argument("Input string is empty (GiString::endswith)");
+    }
+    if (suffix.empty()) {
+        throw std::invalid_argument("Suffix is empty (GiString::endswith)");
+    }
+    return GiStringCore::endswith(str, suffix);
+}
+
+/**
+ * @brief Compares two views ignoring case, using full Unicode case folding ("STRASSE" equals "straße").
+ */
+bool GiString::views::equals_ignore_case(std::string_view str1, std::string_view str2) {
+    return GiUnicode::equals_ignore_case(str1.data(), str1.size(), str2.data(), str2.size());
+}
+
+/**
+ * @brief Checks whether every byte is ASCII.
+ *
+ * @throws std::invalid_argument If the input is empty.
+ */
+bool GiString::views::is_ascii(std::string_view str) {
+    if (str.empty()) {
+        throw std::invalid_argument("Input string is empty (GiString::is_ascii)");
+    }
+    return GiStringCore::is_ascii(str);
+}
+
+/**
+ * @brief Checks whether every byte is a decimal digit.
+ *
+ * @throws std::invalid_argument If the input is empty.
+ */
+bool GiString::views::is_numeric(std::string_view str) {
+    if (str.empty()) {
+        throw std::invalid_argument("Input string is empty (GiString::is_numeric)");
+    }
+    return GiStringCore::is_numeric(str);
+}
+
+/**
+ * @brief Checks whether every byte is a letter.
+ *
+ * @throws std::invalid_argument If the input is empty.
+ */
+bool GiString::views::is_alpha(std::string_view str) {
+    if (str.empty()) {
+        throw std::invalid_argument("Input string is empty (GiString::is_alpha)");
+    }
+    return GiStringCore::is_alpha(str);
+}
+
+/**
+ * @brief Checks whether every byte is a letter or digit.
+ *
+ * @throws std::invalid_argument If the input is empty.
+ */
+bool GiString::views::is_alphanumeric(std::string_view str) {
+    if (str.empty()) {
+        throw std::invalid_argument("Input string is empty (GiString::is_alphanumeric)");
+    }
+    return GiStringCore::is_alphanumeric(str);
+}
+
+/**
+ * @brief Returns a copy of the input with sub inserted at pos, built with a single allocation.
+ *
+ * @throws std::out_of_range If pos is past the end of the input.
+ */
+std::string GiString::views::insert(std::string_view str, size_t pos, std::string_view sub) {
+    if (pos > str.length()) {
+        throw std::out_of_range("Position is out of range (GiString::insert)");
+    }
+    std::string result;
+    result.reserve(str.size() + sub.size());
+    result.append(str.data(), pos).append(sub.data(), sub.size()).append(str.data() + pos, str.size() - pos);
+    return result;
+}
+
+/**
+ * @brief Returns a copy of the input with all non-ASCII bytes removed.
+ */
+std::string GiString::views::ascii_only(std::string_view str) {
+    std::string result;
+    result.reserve(str.size());
+    for (char c : str) {
+        if (static_cast<unsigned char>(c) <= 127) {
+            result += c;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Returns the input with prefix prepended unless it already starts with it.
+ *
+ * @throws std::invalid_argument If the input is empty.
+ */
+std::string GiString::views::ensure_prefix(std::string_view str, std::string_view prefix) {
+    if (str.empty()) {
+        throw std::invalid_argument("ensure_prefix: Input string is empty");
+    }
+    if (str.substr(0, prefix.length()) == prefix) {
+        return std::string(str);
+    }
+    std::string result;
+    result.reserve(prefix.size() + str.size());
+    result.append(prefix.data(), prefix.size()).append(str.data(), str.size());
+    return result;
+}
+
+/**
+ * @brief Returns the input with suffix appended unless it already ends with it.
+ *
+ * @throws std::invalid_argument If the input is empty.
+ */
+std::string GiString::views::ensure_suffix(std::string_view str, std::string_view suffix) {
+    if (str.empty()) {
+        throw std::invalid_argument("ensure_suffix: Input string is empty.");
+    }
+    if (str.size() >= suffix.size() && str.substr(str.size() - suffix.size()) == suffix) {
+        return std::string(str);
+    }
+    std::string result;
+    result.reserve(str.size() + suffix.size());
+    result.append(str.data(), str.size()).append(suffix.data(), suffix.size());
+    return result;
+}
+
+// Example usage:
+// std::string line = "GET /index.html HTTP/1.1";
+// auto [method, separator, rest] = GiString::views::partition(line, " ");
+// std::string_view path = GiString::views::substring_before(rest, " ");
+// std::cout << method << " -> " << path << std::endl;
+// Output: "GET -> /index.html"
+
+
+
+/**
+ * @brief Creates an arena that obtains blocks of at least block_size bytes from upstream.
+ *
+ * @param block_size The size of each block requested from upstream.
+ * @param upstream The resource blocks are allocated from.
+ *
+ * @throws std::invalid_argument If block_size is zero or upstream is null.
+ */
+GiString::Arena::Arena(size_t block_size, std::pmr::memory_resource* upstream)
+    : block_size_(block_size), upstream_(upstream) {
+    if (block_size == 0 || upstream == nullptr) {
+        throw std::invalid_argument("Block size must be positive and upstream must not be null (GiString::Arena)");
+    }
+}
+
+GiString::Arena::~Arena() {
+    while (head_) {
+        Block* next = head_->next;
+        upstream_->deallocate(head_, sizeof(Block) + head_->size, alignof(std::max_align_t));
+        head_ = next;
+    }
+}
+
+/**
+ * @brief Releases every allocation at once, keeping the blocks for reuse.
+ */
+void GiString::Arena::reset() {
+    current_ = head_;
+    offset_ = 0;
+    used_ = 0;
+}
+
+/**
+ * @brief Returns the number of bytes handed out since construction or the last reset().
+ */
+size_t GiString::Arena::bytes_used() const {
+    return used_;
+}
+
+/**
+ * @brief Returns the total size of the blocks the arena holds.
+ */
+size_t GiString::Arena::bytes_reserved() const {
+    size_t total = 0;
+    for (Block* block = head_; block; block = block->next) {
+        total += block->size;
+    }
+    return total;
+}
+
+void* GiString::Arena::carve(Block* block, size_t bytes, size_t alignment) {
+    uintptr_t base = reinterpret_cast<uintptr_t>(block + 1);
+    uintptr_t aligned = (base + offset_ + alignment - 1) & ~(uintptr_t(alignment) - 1);
+    if (aligned + bytes > base + block->size) {
+        return nullptr;
+    }
+    offset_ = aligned + bytes - base;
+    used_ += bytes;
+    return reinterpret_cast<void*>(aligned);
+}
+
+void* GiString::Arena::do_allocate(size_t bytes, size_t alignment) {
+    if (current_) {
+        if (void* p = carve(current_, bytes, alignment)) {
+            return p;
+        }
+        // Move on to a retained block if the next one is large enough
+        if (current_->next && current_->next->size >= bytes + alignment) {
+            current_ = current_->next;
+            offset_ = 0;
+            return carve(current_, bytes, alignment);
+        }
+    }
+
+    size_t size = std::max(block_size_, bytes + alignment);
+    Block* block = static_cast<Block*>(upstream_->allocate(sizeof(Block) + size, alignof(std::max_align_t)));
+    block->size = size;
+    if (current_) {
+        block->next = current_->next;
+        current_->next = block;
+    } else {
+        block->next = head_;
+        head_ = block;
+    }
+    current_ = block;
+    offset_ = 0;
+    return carve(current_, bytes, alignment);
+}
+
+// Example usage:
+// GiString gs;
+// GiString::Arena arena;
+// for (const Request& request : requests) {
+//     std::pmr::string name(&arena);
+//     gs.lower(request.name, name);
+//     std::pmr::vector<std::pmr::string> fields = gs.split(request.body, ',', &arena);
+//     int distance = gs.levenshtein_distance(request.name, request.expected, &arena);
+//     handle(name, fields, distance);
+//     arena.reset();
+// }
+
+
+
+/**
+ * @brief Creates an empty interner.
+ *
+ * @param page_size The size of the arena pages each shard copies string bytes into.
+ *
+ * @throws std::invalid_argument If page_size is zero.
+ */
+GiString::Interner::Interner(size_t page_size) {
+    if (page_size == 0) {
+        throw std::invalid_argument("Page size must be positive (GiString::Interner)");
+    }
+    for (std::atomic<Entry*>& chunk : chunks_) {
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+    for (std::unique_ptr<Shard>& shard : shards_) {
+        shard.reset(new Shard(page_size));
+        shard->tables.emplace_back(new Table(64));
+        shard->table.store(shard->tables.back().get(), std::memory_order_release);
+    }
+}
+
+GiString::Interner::~Interner() {
+    for (std::atomic<Entry*>& chunk : chunks_) {
+        delete[] chunk.load(std::memory_order_relaxed);
+    }
+}
+
+uint64_t GiString::Interner::hash(std::string_view str) {
+    // FNV-1a followed by a 64-bit finalizer so both halves of the hash are well mixed:
+    // the low bits pick the shard, the high bits the slot.
+    uint64_t h = GiStringCore::hash(str);
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+size_t GiString::Interner::chunk_of(id_type id, size_t& offset) {
+    // Chunk k holds first_chunk << k entries, so the table grows without moving entries
+    size_t index = id / first_chunk + 1;
+    size_t chunk = 0;
+    while (index >>= 1) {
+        ++chunk;
+    }
+    offset = id - first_chunk * ((size_t(1) << chunk) - 1);
+    return chunk;
+}
+
+const GiString::Interner::Entry& GiString::Interner::entry(id_type id) const {
+    size_t offset;
+    size_t chunk = chunk_of(id, offset);
+    return chunks_[chunk].load(std::memory_order_acquire)[offset];
+}
+
+GiString::Interner::id_type GiString::Interner::lookup(const Shard& shard, std::string_view str, uint64_t hash) const {
+    const Table* table = shard.table.load(std::memory_order_acquire);
+    uint64_t tag = hash >> 32;
+    for (size_t i = tag & table->mask;; i = (i + 1) & table->mask) {
+        uint64_t slot = table->slots[i].load(std::memory_order_acquire);
+        if (slot == 0) {
+            return npos;
+        }
+        if ((slot >> 32) == tag) {
+            id_type id = static_cast<id_type>(slot) - 1;
+            const Entry& e = entry(id);
+            if (std::string_view(e.data, e.size) == str) {
+                return id;
+            }
+        }
+    }
+}
+
+void GiString::Interner::grow_locked(Shard& shard) {
+    const Table* old_table = shard.table.load(std::memory_order_relaxed);
+    std::unique_ptr<Table> table(new Table((old_table->mask + 1) * 2));
+    for (size_t i = 0; i <= old_table->mask; ++i) {
+        uint64_t slot = old_table->slots[i].load(std::memory_order_relaxed);
+        if (slot == 0) {
+            continue;
+        }
+        size_t j = (slot >> 32) & table->mask;
+        while (table->slots[j].load(std::memory_order_relaxed) != 0) {
+            j = (j + 1) & table->mask;
+        }
+        table->slots[j].store(slot, std::memory_order_relaxed);
+    }
+    // Readers may still be probing the old table, so it is retired rather than freed
+    shard.table.store(table.get(), std::memory_order_release);
+    shard.tables.push_back(std::move(table));
+}
+
+GiString::Interner::id_type GiString::Interner::insert_locked(Shard& shard, std::string_view str, uint64_t hash) {
+    id_type existing = lookup(shard, str, hash);
+    if (existing != npos) {
+        return existing;
+    }
+
+    // Everything that can throw happens before the id is taken, so a failed insert never
+    // leaves an id that view() and size() count but whose entry was never written
+    if ((shard.count + 1) * 2 > shard.table.load(std::memory_order_relaxed)->mask + 1) {
+        grow_locked(shard);
+    }
+    char* data = static_cast<char*>(shard.arena.allocate(str.size() ? str.size() : 1, 1));
+    std::memcpy(data, str.data(), str.size());
+
+    id_type id = next_id_.load(std::memory_order_relaxed);
+    size_t offset;
+    Entry* entries;
+    do {
+        if (id == npos) {
+            throw std::length_error("Interner is full (GiString::Interner::intern)");
+        }
+        size_t chunk = chunk_of(id, offset);
+        entries = chunks_[chunk].load(std::memory_order_acquire);
+        if (!entries) {
+            // Shards fill chunks concurrently, so the first one to need a chunk publishes it
+            Entry* fresh = new Entry[first_chunk << chunk]();
+            if (chunks_[chunk].compare_exchange_strong(entries, fresh, std::memory_order_acq_rel)) {
+                entries = fresh;
+            } else {
+                delete[] fresh;
+            }
+        }
+        // Other shards take ids too; on contention retry with the id they left
+    } while (!next_id_.compare_exchange_weak(id, id + 1, std::memory_order_relaxed));
+    entries[offset] = Entry{data, str.size()};
+    // Every id below committed_ has its entry written. Shards take ids concurrently, so each
+    // publishes its id after the one before it; the steps in between cannot block or throw.
+    while (committed_.load(std::memory_order_acquire) != id) {
+        std::this_thread::yield();
+    }
+    committed_.store(id + 1, std::memory_order_release);
+
+    Table* table = shard.table.load(std::memory_order_relaxed);
+    uint64_t tag = hash >> 32;
+    size_t i = tag & table->mask;
+    while (table->slots[i].load(std::memory_order_relaxed) != 0) {
+        i = (i + 1) & table->mask;
+    }
+    table->slots[i].store((tag << 32) | (uint64_t(id) + 1), std::memory_order_release);
+    ++shard.count;
+    return id;
+}
+
+/**
+ * @brief Returns the id of str, adding it to the interner if it is not present yet.
+ *
+ * Strings already present are found without locking; a new string locks only its shard.
+ *
+ * @param str The string to intern.
+ * @return The id of str; equal strings always get equal ids.
+ *
+ * @throws std::length_error If all 2^32 - 1 ids are in use.
+ */
+GiString::Interner::id_type GiString::Interner::intern(std::string_view str) {
+    uint64_t h = hash(str);
+    Shard& shard = *shards_[h % shard_count];
+    id_type id = lookup(shard, str, h);
+    if (id != npos) {
+        return id;
+    }
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return insert_locked(shard, str, h);
+}
+
+/**
+ * @brief Returns the id of str without adding it.
+ *
+ * @param str The string to look up.
+ * @return The id of str, or Interner::npos if it has not been interned.
+ */
+GiString::Interner::id_type GiString::Interner::find(std::string_view str) const {
+    uint64_t h = hash(str);
+    return lookup(*shards_[h % shard_count], str, h);
+}
+
+/**
+ * @brief Returns the interned bytes of an id.
+ *
+ * The view stays valid for the lifetime of the interner. The id must have been returned by
+ * intern() or find() (on any thread, as long as it was handed over with proper synchronization).
+ *
+ * @param id An id obtained from this interner.
+ * @return The string the id stands for.
+ *
+ * @throws std::out_of_range If id has not been assigned.
+ */
+std::string_view GiString::Interner::view(id_type id) const {
+    if (id >= committed_.load(std::memory_order_acquire)) {
+        throw std::out_of_range("Unknown id (GiString::Interner::view)");
+    }
+    const Entry& e = entry(id);
+    return std::string_view(e.data, e.size);
+}
+
+/**
+ * @brief Returns the number of distinct strings interned so far.
+ */
+size_t GiString::Interner::size() const {
+    return committed_.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Returns the number of bytes of arena pages used for string data.
+ */
+size_t GiString::Interner::bytes_used() const {
+    size_t total = 0;
+    for (const std::unique_ptr<Shard>& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        total += shard->arena.bytes_used();
+    }
+    return total;
+}
+
+/**
+ * @brief Interns a batch of strings.
+ *
+ * Strings already present are resolved without locking; the remaining ones are grouped by
+ * shard so each shard is locked at most once per batch.
+ *
+ * @param strings Pointer to the strings to intern.
+ * @param count Number of strings.
+ * @param ids Receives the id of each string (count entries).
+ *
+ * @throws std::length_error If all 2^32 - 1 ids are in use.
+ */
+void GiString::Interner::intern_all(const std::string_view* strings, size_t count, id_type* ids) {
+    std::vector<uint64_t> hashes(count);
+    std::vector<size_t> pending[shard_count];
+    for (size_t i = 0; i < count; ++i) {
+        hashes[i] = hash(strings[i]);
+        ids[i] = lookup(*shards_[hashes[i] % shard_count], strings[i], hashes[i]);
+        if (ids[i] == npos) {
+            pending[hashes[i] % shard_count].push_back(i);
+        }
+    }
+    for (size_t s = 0; s < shard_count; ++s) {
+        if (pending[s].empty()) {
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(shards_[s]->mutex);
+        for (size_t i : pending[s]) {
+            ids[i] = insert_locked(*shards_[s], strings[i], hashes[i]);
+        }
+    }
+}
+
+/**
+ * @brief Interns a batch of strings, returning their ids in order.
+ *
+ * @param strings The strings to intern.
+ * @return The id of each string.
+ */
+std::vector<GiString::Interner::id_type> GiString::Interner::intern_all(const std::vector<std::string_view>& strings) {
+    std::vector<id_type> ids(strings.size());
+    intern_all(strings.data(), strings.size(), ids.data());
+    return ids;
+}
+
+/**
+ * @brief Interns a batch of strings, returning their ids in order.
+ *
+ * @param strings The strings to intern.
+ * @return The id of each string.
+ */
+std::vector<GiString::Interner::id_type> GiString::Interner::intern_all(const std::vector<std::string>& strings) {
+    std::vector<std::string_view> views(strings.begin(), strings.end());
+    return intern_all(views);
+}
+
+// Example usage:
+// GiString gs;
+// GiString::Interner fields;
+// std::vector<GiString::Interner::id_type> ids = fields.intern_all(gs.split("id,name,id,email", ','));
+// std::cout << ids[0] << ids[1] << ids[2] << ids[3] << " " << fields.view(ids[3]) << std::endl;
+// Output: "0102 email"
+
+
+
+/**
+ * @brief Returns a batch interface that runs GiString functions over vectors on an executor.
+ *
+ * @param executor The pool to run on; defaults to the shared, hardware-sized pool.
+ * @param grain Minimum number of strings handed to a thread at once.
+ * @return The batch interface; it refers to this GiString and to executor.
+ */
+GiString::Batch GiString::batch(GiExecutor& executor, size_t grain) {
+    return Batch(*this, executor, grain);
+}
+
+/**
+ * @brief Upper-cases every string (GiString::upper).
+ *
+ * @param input The strings to transform.
+ * @param output Receives the results; resized to input.size().
+ */
+void GiString::Batch::upper(const std::vector<std::string>& input, std::vector<std::string>& output) {
+    GiString* owner = owner_;
+    output.resize(input.size());
+    map(input.data(), input.size(), output.data(), [owner](const std::string& str, std::string& out) {
+        out.clear();
+        owner->upper(str, out);
+    });
+}
+
+/**
+ * @brief Lower-cases every string (GiString::lower).
+ *
+ * @param input The strings to transform.
+ * @param output Receives the results; resized to input.size().
+ */
+void GiString::Batch::lower(const std::vector<std::string>& input, std::vector<std::string>& output) {
+    GiString* owner = owner_;
+    output.resize(input.size());
+    map(input.data(), input.size(), output.data(), [owner](const std::string& str, std::string& out) {
+        out.clear();
+        owner->lower(str, out);
+    });
+}
+
+/**
+ * @brief Trims whitespace from both ends of every string (GiString::trim).
+ *
+ * @param input The strings to transform.
+ * @param output Receives the results; resized to input.size().
+ */
+void GiString::Batch::trim(const std::vector<std::string>& input, std::vector<std::string>& output) {
+    GiString* owner = owner_;
+    output.resize(input.size());
+    map(input.data(), input.size(), output.data(), [owner](const std::string& str, std::string& out) {
+        out.clear();
+        owner->trim(str, out);
+    });
+}
+
+/**
+ * @brief Capitalizes every string (GiString::capitalize).
+ *
+ * @param input The strings to transform.
+ * @param output Receives the results; resized to input.size().
+ */
+void GiString::Batch::capitalize(const std::vector<std::string>& input, std::vector<std::string>& output) {
+    GiString* owner = owner_;
+    output.resize(input.size());
+    map(input.data(), input.size(), output.data(), [owner](const std::string& str, std::string& out) {
+        out.clear();
+        owner->capitalize(str, out);
+    });
+}
+
+/**
+ * @brief Swaps the case of every string (GiString::swapcase).
+ *
+ * @param input The strings to transform.
+ * @param output Receives the results; resized to input.size().
+ */
+void GiString::Batch::swapcase(const std::vector<std::string>& input, std::vector<std::string>& output) {
+    GiString* owner = owner_;
+    output.resize(input.size());
+    map(input.data(), input.size(), output.data(), [owner](const std::string& str, std::string& out) {
+        out.clear();
+        owner->swapcase(str, out);
+    });
+}
+
+/**
+ * @brief Reverses every string (GiString::reverse).
+ *
+ * @param input The strings to transform.
+ * @param output Receives the results; resized to input.size().
+ */
+void GiString::Batch::reverse(const std::vector<std::string>& input, std::vector<std::string>& output) {
+    GiString* owner = owner_;
+    output.resize(input.size());
+    map(input.data(), input.size(), output.data(), [owner](const std::string& str, std::string& out) {
+        out = owner->reverse(str);
+    });
+}
+
+/**
+ * @brief XML-escapes every string (GiString::xml_escape).
+ *
+ * @param input The strings to transform.
+ * @param output Receives the results; resized to input.size().
+ */
+void GiString::Batch::xml_escape(const std::vector<std::string>& input, std::vector<std::string>& output) {
+    GiString* owner = owner_;
+    output.resize(input.size());
+    map(input.data(), input.size(), output.data(), [owner](const std::string& str, std::string& out) {
+        out.clear();
+        owner->xml_escape(str, out);
+    });
+}
+
+/**
+ * @brief URL-encodes every string (GiString::url_encode).
+ *
+ * @param input The strings to transform.
+ * @param output Receives the results; resized to input.size().
+ */
+void GiString::Batch::url_encode(const std::vector<std::string>& input, std::vector<std::string>& output) {
+    GiString* owner = owner_;
+    output.resize(input.size());
+    map(input.data(), input.size(), output.data(), [owner](const std::string& str, std::string& out) {
+        out.clear();
+        owner->url_encode(str, out);
+    });
+}
+
+/**
+ * @brief Base64-encodes every string (GiString::base64_encode).
+ *
+ * @param input The strings to transform.
+ * @param output Receives the results; resized to input.size().
+ */
+void GiString::Batch::base64_encode(const std::vector<std::string>& input, std::vector<std::string>& output) {
+    GiString* owner = owner_;
+    output.resize(input.size());
+    map(input.data(), input.size(), output.data(), [owner](const std::string& str, std::string& out) {
+        out.clear();
+        owner->base64_encode(str, out);
+    });
+}
+
+/**
+ * @brief Replaces every occurrence of old_sub with new_sub in every string (GiString::replace).
+ *
+ * @param input The strings to transform.
+ * @param old_sub The substring to replace.
+ * @param new_sub The replacement.
+ * @param output Receives the results; resized to input.size().
+ *
+ * @throws std::invalid_argument If old_sub is empty.
+ */
+void GiString::Batch::replace(const std::vector<std::string>& input, const std::string& old_sub, const std::string& new_sub, std::vector<std::string>& output) {
+    GiString* owner = owner_;
+    output.resize(input.size());
+    map(input.data(), input.size(), output.data(), [owner, &old_sub, &new_sub](const std::string& str, std::string& out) {
+        out.clear();
+        owner->replace(str, old_sub, new_sub, out);
+    });
+}
+
+/**
+ * @brief Rewrites every identifier in another naming convention (GiString::convert_case_style).
+ *
+ * Output strings are sized exactly and reuse their capacity, so rewriting the same batch
+ * again (e.g. the columns of every table in a schema) does not allocate.
+ *
+ * @param input The identifiers to convert.
+ * @param style The target convention.
+ * @param output Receives the results; resized to input.size().
+ */
+void GiString::Batch::convert_case_style(const std::vector<std::string>& input, CaseStyle style, std::vector<std::string>& output) {
+    GiString* owner = owner_;
+    output.resize(input.size());
+    map(input.data(), input.size(), output.data(), [owner, style](const std::string& str, std::string& out) {
+        out.clear();
+        owner->convert_case_style(str, style, out);
+    });
+}
+
+/**
+ * @brief Returns a new vector holding convert_case_style() of every identifier.
+ */
+std::vector<std::string> GiString::Batch::convert_case_style(const std::vector<std::string>& input, CaseStyle style) {
+    std::vector<std::string> output;
+    convert_case_style(input, style, output);
+    return output;
+}
+
+/**
+ * @brief Returns a new vector holding upper() of every string.
+ */
+std::vector<std::string> GiString::Batch::upper(const std::vector<std::string>& input) {
+    std::vector<std::string> output;
+    upper(input, output);
+    return output;
+}
+
+/**
+ * @brief Returns a new vector holding lower() of every string.
+ */
+std::vector<std::string> GiString::Batch::lower(const std::vector<std::string>& input) {
+    std::vector<std::string> output;
+    lower(input, output);
+    return output;
+}
+
+/**
+ * @brief Returns a new vector holding trim() of every string.
+ */
+std::vector<std::string> GiString::Batch::trim(const std::vector<std::string>& input) {
+    std::vector<std::string> output;
+    trim(input, output);
+    return output;
+}
+
+/**
+ * @brief Tests every string with GiString::is_numeric.
+ *
+ * @param input The strings to test.
+ * @return 1 for each string that matches, 0 otherwise.
+ */
+std::vector<char> GiString::Batch::is_numeric(const std::vector<std::string>& input) {
+    GiString* owner = owner_;
+    return map_all<char>(input, [owner](const std::string& str, char& out) { out = owner->is_numeric(str); });
+}
+
+/**
+ * @brief Tests every string with GiString::is_alpha.
+ *
+ * @param input The strings to test.
+ * @return 1 for each string that matches, 0 otherwise.
+ */
+std::vector<char> GiString::Batch::is_alpha(const std::vector<std::string>& input) {
+    GiString* owner = owner_;
+    return map_all<char>(input, [owner](const std::string& str, char& out) { out = owner->is_alpha(str); });
+}
+
+/**
+ * @brief Tests every string with GiString::is_alphanumeric.
+ *
+ * @param input The strings to test.
+ * @return 1 for each string that matches, 0 otherwise.
+ */
+std::vector<char> GiString::Batch::is_alphanumeric(const std::vector<std::string>& input) {
+    GiString* owner = owner_;
+    return map_all<char>(input, [owner](const std::string& str, char& out) { out = owner->is_alphanumeric(str); });
+}
+
+/**
+ * @brief Tests every string with GiString::is_ascii.
+ *
+ * @param input The strings to test.
+ * @return 1 for each string that matches, 0 otherwise.
+ */
+std::vector<char> GiString::Batch::is_ascii(const std::vector<std::string>& input) {
+    GiString* owner = owner_;
+    return map_all<char>(input, [owner](const std::string& str, char& out) { out = owner->is_ascii(str); });
+}
+
+/**
+ * @brief Tests every string with GiString::is_valid_email.
+ *
+ * @param input The strings to test.
+ * @return 1 for each string that matches, 0 otherwise.
+ */
+std::vector<char> GiString::Batch::is_valid_email(const std::vector<std::string>& input) {
+    GiString* owner = owner_;
+    return map_all<char>(input, [owner](const std::string& str, char& out) { out = owner->is_valid_email(str); });
+}
+
+/**
+ * @brief Tests every string with GiString::contains.
+ *
+ * @param input The strings to test.
+ * @param sub The argument passed to GiString::contains for every string.
+ * @return 1 for each string that matches, 0 otherwise.
+ */
+std::vector<char> GiString::Batch::contains(const std::vector<std::string>& input, const std::string& sub) {
+    GiString* owner = owner_;
+    return map_all<char>(input, [owner, &sub](const std::string& str, char& out) { out = owner->contains(str, sub); });
+}
+
+/**
+ * @brief Tests every string with GiString::startswith.
+ *
+ * @param input The strings to test.
+ * @param prefix The argument passed to GiString::startswith for every string.
+ * @return 1 for each string that matches, 0 otherwise.
+ */
+std::vector<char> GiString::Batch::startswith(const std::vector<std::string>& input, const std::string& prefix) {
+    GiString* owner = owner_;
+    return map_all<char>(input, [owner, &prefix](const std::string& str, char& out) { out = owner->startswith(str, prefix); });
+}
+
+/**
+ * @brief Tests every string with GiString::endswith.
+ *
+ * @param input The strings to test.
+ * @param suffix The argument passed to GiString::endswith for every string.
+ * @return 1 for each string that matches, 0 otherwise.
+ */
+std::vector<char> GiString::Batch::endswith(const std::vector<std::string>& input, const std::string& suffix) {
+    GiString* owner = owner_;
+    return map_all<char>(input, [owner, &suffix](const std::string& str, char& out) { out = owner->endswith(str, suffix); });
+}
+
+/**
+ * @brief Counts the occurrences of sub in every string (GiString::count).
+ *
+ * @param input The strings to search.
+ * @param sub The substring to count.
+ * @return The count for each string.
+ */
+std::vector<size_t> GiString::Batch::count(const std::vector<std::string>& input, const std::string& sub) {
+    GiString* owner = owner_;
+    return map_all<size_t>(input, [owner, &sub](const std::string& str, size_t& out) { out = owner->count(str, sub); });
+}
+
+/**
+ * @brief Computes the edit distance from every string to target (GiString::levenshtein_distance).
+ *
+ * @param input The strings to compare.
+ * @param target The string each input is compared with.
+ * @return The distance for each string.
+ */
+std::vector<int> GiString::Batch::levenshtein_distance(const std::vector<std::string>& input, const std::string& target) {
+    GiString* owner = owner_;
+    return map_all<int>(input, [owner, &target](const std::string& str, int& out) {
+        out = owner->levenshtein_distance(str, target);
+    });
+}
+
+// Example usage:
+// GiString gs;
+// std::vector<std::string> names = {" Alice ", "BOB", "carol "};
+// std::vector<std::string> clean;
+// gs.batch().trim(names, clean);
+// std::vector<std::string> keys = gs.batch().lower(clean);
+// std::vector<char> short_names = gs.batch().endswith(keys, "b");
+// std::cout << keys[0] << keys[1] << keys[2] << " " << int(short_names[1]) << std::endl;
+// Output: "alicebobcarol 1"
+
+/**
+ * @brief Groups the strings that are anagrams of each other.
+ *
+ * Every string's signature, its bytes in sorted order (as GiString::sort gives them), is
+ * computed in parallel with a counting sort; the signatures are then hashed into buckets.
+ * Strings are compared byte for byte, so case and spaces matter.
+ *
+ * @param input The strings to group.
+ * @return One group per distinct signature, in order of first appearance; each holds the
+ *         indices of its strings in input, in increasing order.
+ */
+std::vector<std::vector<size_t>> GiString::Batch::group_anagrams(const std::vector<std::string>& input) {
+    std::vector<std::string> signatures = map_all<std::string>(input, [](const std::string& str, std::string& signature) {
+        append_sorted_bytes(str, false, signature);
+    });
+
+    std::vector<std::vector<size_t>> groups;
+    std::unordered_map<std::string_view, size_t> buckets;
+    buckets.reserve(input.size());
+    for (size_t i = 0; i < input.size(); ++i) {
+        auto [bucket, inserted] = buckets.emplace(signatures[i], groups.size());
+        if (inserted) {
+            groups.emplace_back();
+        }
+        groups[bucket->second].push_back(i);
+    }
+    return groups;
+}
+
+// Example usage:
+// GiString gs;
+// std::vector<std::string> words = {"listen", "google", "silent", "enlist", "banana"};
+// for (const std::vector<size_t>& group : gs.batch().group_anagrams(words)) {
+//     for (size_t i : group) {
+//         std::cout << words[i] << " ";
+//     }
+//     std::cout << "| ";
+// }
+// Output: "listen silent enlist | google | banana | "
+
+
+
+/**
+ * @brief Creates an empty column.
+ */
+template <typename Offset>
+GiString::BasicStringColumn<Offset>::BasicStringColumn() : offsets_(1, 0) {}
+
+/**
+ * @brief Creates a column holding a copy of every string, with no nulls.
+ *
+ * @param strings The rows of the column.
+ *
+ * @throws std::length_error If the total size does not fit the offset type.
+ */
+template <typename Offset>
+GiString::BasicStringColumn<Offset>::BasicStringColumn(const std::vector<std::string>& strings) : BasicStringColumn() {
+    size_t bytes = 0;
+    for (const std::string& str : strings) {
+        bytes += str.size();
+    }
+    reserve(strings.size(), bytes);
+    for (const std::string& str : strings) {
+        push_back(str);
+    }
+}
+
+/**
+ * @brief Reserves room for rows more rows totalling bytes more bytes.
+ */
+template <typename Offset>
+void GiString::BasicStringColumn<Offset>::reserve(size_t rows, size_t bytes) {
+    offsets_.reserve(offsets_.size() + rows);
+    data_.reserve(data_.size() + bytes);
+}
+
+/**
+ * @brief Appends a row.
+ *
+ * @param str The row's bytes.
+ *
+ * @throws std::length_error If the column's bytes would no longer fit the offset type.
+ */
+template <typename Offset>
+void GiString::BasicStringColumn<Offset>::push_back(std::string_view str) {
+    if (str.size() > static_cast<Offset>(-1) - data_.size()) {
+        throw std::length_error("Column data exceeds the offset range (GiString::StringColumn::push_back)");
+    }
+    data_.insert(data_.end(), str.begin(), str.end());
+    offsets_.push_back(static_cast<Offset>(data_.size()));
+    if (!validity_.empty()) {
+        size_t row = size() - 1;
+        if (row % 8 == 0) {
+            validity_.push_back(0);
+        }
+        validity_[row / 8] |= static_cast<uint8_t>(1u << (row % 8));
+    }
+}
+
+/**
+ * @brief Appends a null row.
+ */
+template <typename Offset>
+void GiString::BasicStringColumn<Offset>::push_null() {
+    if (validity_.empty()) {
+        // First null: materialize the bitmap with every earlier row valid
+        validity_.assign((size() + 8) / 8, 0);
+        for (size_t row = 0; row < size(); ++row) {
+            validity_[row / 8] |= static_cast<uint8_t>(1u << (row % 8));
+        }
+    } else if (size() % 8 == 0) {
+        validity_.push_back(0);
+    }
+    offsets_.push_back(static_cast<Offset>(data_.size()));
+    ++null_count_;
+}
+
+/**
+ * @brief Removes every row, keeping the buffers' capacity.
+ */
+template <typename Offset>
+void GiString::BasicStringColumn<Offset>::clear() {
+    data_.clear();
+    offsets_.assign(1, 0);
+    validity_.clear();
+    null_count_ = 0;
+}
+
+/**
+ * @brief Returns the bytes of a row, with bounds checking.
+ *
+ * @throws std::out_of_range If row is not less than size().
+ */
+template <typename Offset>
+std::string_view GiString::BasicStringColumn<Offset>::at(size_t row) const {
+    if (row >= size()) {
+        throw std::out_of_range("Row index out of range (GiString::StringColumn::at)");
+    }
+    return (*this)[row];
+}
+
+template <typename Offset>
+GiString::BasicStringColumn<Offset> GiString::BasicStringColumn<Offset>::with_data(std::vector<char> data, std::vector<Offset> offsets) const {
+    BasicStringColumn column;
+    column.data_ = std::move(data);
+    column.offsets_ = std::move(offsets);
+    column.validity_ = validity_;
+    column.null_count_ = null_count_;
+    return column;
+}
+
+/**
+ * @brief Returns the column with every row upper-cased (ASCII).
+ *
+ * Case conversion preserves lengths, so the offsets are reused and the whole byte buffer
+ * is converted in one pass.
+ */
+template <typename Offset>
+GiString::BasicStringColumn<Offset> GiString::BasicStringColumn<Offset>::upper() const {
+    std::vector<char> data = data_;
+    GiStringCore::to_upper(data.data(), data.size());
+    return with_data(std::move(data), offsets_);
+}
+
+/**
+ * @brief Returns the column with every row lower-cased (ASCII).
+ */
+template <typename Offset>
+GiString::BasicStringColumn<Offset> GiString::BasicStringColumn<Offset>::lower() const {
+    std::vector<char> data = data_;
+    GiStringCore::to_lower(data.data(), data.size());
+    return with_data(std::move(data), offsets_);
+}
+
+/**
+ * @brief Returns the column with leading and trailing whitespace removed from every row.
+ */
+template <typename Offset>
+GiString::BasicStringColumn<Offset> GiString::BasicStringColumn<Offset>::trim() const {
+    std::vector<char> data;
+    data.reserve(data_.size());
+    std::vector<Offset> offsets;
+    offsets.reserve(offsets_.size());
+    offsets.push_back(0);
+    for (size_t row = 0; row < size(); ++row) {
+        std::string_view trimmed = GiStringCore::trim((*this)[row]);
+        data.insert(data.end(), trimmed.begin(), trimmed.end());
+        offsets.push_back(static_cast<Offset>(data.size()));
+    }
+    return with_data(std::move(data), std::move(offsets));
+}
+
+template <typename Offset>
+template <typename Predicate>
+std::vector<char> GiString::BasicStringColumn<Offset>::test(Predicate predicate) const {
+    std::vector<char> result(size());
+    for (size_t row = 0; row < size(); ++row) {
+        result[row] = !is_null(row) && predicate((*this)[row]);
+    }
+    return result;
+}
+
+/**
+ * @brief Tests which rows consist only of ASCII digits; empty rows test false.
+ */
+template <typename Offset>
+std::vector<char> GiString::BasicStringColumn<Offset>::is_numeric() const {
+    return test([](std::string_view str) { return !str.empty() && GiStringCore::is_numeric(str); });
+}
+
+/**
+ * @brief Tests which rows consist only of ASCII letters; empty rows test false.
+ */
+template <typename Offset>
+std::vector<char> GiString::BasicStringColumn<Offset>::is_alpha() const {
+    return test([](std::string_view str) { return !str.empty() && GiStringCore::is_alpha(str); });
+}
+
+/**
+ * @brief Tests which rows consist only of ASCII letters and digits; empty rows test false.
+ */
+template <typename Offset>
+std::vector<char> GiString::BasicStringColumn<Offset>::is_alphanumeric() const {
+    return test([](std::string_view str) { return !str.empty() && GiStringCore::is_alphanumeric(str); });
+}
+
+/**
+ * @brief Tests which rows contain only ASCII bytes.
+ */
+template <typename Offset>
+std::vector<char> GiString::BasicStringColumn<Offset>::is_ascii() const {
+    return test([](std::string_view str) { return GiStringCore::is_ascii(str); });
+}
+
+/**
+ * @brief Tests which rows start with prefix.
+ */
+template <typename Offset>
+std::vector<char> GiString::BasicStringColumn<Offset>::startswith(std::string_view prefix) const {
+    return test([prefix](std::string_view str) { return GiStringCore::startswith(str, prefix); });
+}
+
+/**
+ * @brief Tests which rows end with suffix.
+ */
+template <typename Offset>
+std::vector<char> GiString::BasicStringColumn<Offset>::endswith(std::string_view suffix) const {
+    return test([suffix](std::string_view str) { return GiStringCore::endswith(str, suffix); });
+}
+
+/**
+ * @brief Tests which rows contain sub.
+ */
+template <typename Offset>
+std::vector<char> GiString::BasicStringColumn<Offset>::contains(std::string_view sub) const {
+    return test([sub](std::string_view str) { return GiStringCore::contains(str, sub); });
+}
+
+/**
+ * @brief Returns the 64-bit FNV-1a hash of every row (GiStringCore::hash); null rows hash to 0.
+ */
+template <typename Offset>
+std::vector<uint64_t> GiString::BasicStringColumn<Offset>::hash() const {
+    std::vector<uint64_t> result(size());
+    for (size_t row = 0; row < size(); ++row) {
+        result[row] = is_null(row) ? 0 : GiStringCore::hash((*this)[row]);
+    }
+    return result;
+}
+
+/**
+ * @brief Computes the edit distance from every row to target.
+ *
+ * One scratch buffer of two DP rows, each target.size() + 1 entries long, is shared by all rows.
+ *
+ * @param target The string each row is compared with.
+ * @return The distance for each row, or -1 for null rows.
+ */
+template <typename Offset>
+std::vector<int> GiString::BasicStringColumn<Offset>::levenshtein_distance(std::string_view target) const {
+    std::vector<int> rows(2 * (target.size() + 1));
+    std::vector<int> result(size());
+    for (size_t row = 0; row < size(); ++row) {
+        result[row] = is_null(row) ? -1 : levenshtein_rows((*this)[row], target, rows.data());
+    }
+    return result;
+}
+
+namespace {
+    const char column_magic[4] = {'G', 'S', 'C', '1'};
+
+    template <typename T>
+    void append_raw(std::string& output, const T* values, size_t count) {
+        output.append(reinterpret_cast<const char*>(values), count * sizeof(T));
+    }
+}
+
+/**
+ * @brief Appends the column's buffers to output in a memcpy-able layout.
+ *
+ * The layout is a 4-byte tag, the offset width, the row, byte and null counts as
+ * uint64, then the offsets, the bytes and (if there are nulls) the validity bitmap, all
+ * in native byte order.
+ *
+ * @param output The string the serialized column is appended to.
+ */
+template <typename Offset>
+void GiString::BasicStringColumn<Offset>::serialize(std::string& output) const {
+    uint64_t header[3] = {size(), data_.size(), null_count_};
+    output.reserve(output.size() + 5 + sizeof(header) + offsets_.size() * sizeof(Offset) + data_.size() + validity_.size());
+    output.append(column_magic, 4);
+    output.push_back(static_cast<char>(sizeof(Offset)));
+    append_raw(output, header, 3);
+    append_raw(output, offsets_.data(), offsets_.size());
+    output.append(data_.data(), data_.size());
+    if (null_count_ > 0) {
+        append_raw(output, validity_.data(), validity_.size());
+    }
+}
+
+/**
+ * @brief Reconstructs a column written by serialize().
+ *
+ * @param buffer The serialized column.
+ * @return The column.
+ *
+ * @throws std::invalid_argument If the buffer is truncated, was written with a different
+ * offset width, or its offsets are inconsistent.
+ */
+template <typename Offset>
+GiString::BasicStringColumn<Offset> GiString::BasicStringColumn<Offset>::deserialize(std::string_view buffer) {
+    const char* error = "Malformed column buffer (GiString::StringColumn::deserialize)";
+    uint64_t header[3];
+    if (buffer.size() < 5 + sizeof(header) || std::memcmp(buffer.data(), column_magic, 4) != 0 ||
+        static_cast<size_t>(buffer[4]) != sizeof(Offset)) {
+        throw std::invalid_argument(error);
+    }
+    std::memcpy(header, buffer.data() + 5, sizeof(header));
+    buffer.remove_prefix(5 + sizeof(header));
+
+    uint64_t rows = header[0];
+    uint64_t bytes = header[1];
+    uint64_t nulls = header[2];
+    uint64_t bitmap = nulls > 0 ? (rows + 7) / 8 : 0;
+    if (rows >= buffer.size() / sizeof(Offset) || bytes > buffer.size() || nulls > rows ||
+        buffer.size() != (rows + 1) * sizeof(Offset) + bytes + bitmap) {
+        throw std::invalid_argument(error);
+    }
+
+    BasicStringColumn column;
+    column.offsets_.resize(rows + 1);
+    std::memcpy(column.offsets_.data(), buffer.data(), (rows + 1) * sizeof(Offset));
+    buffer.remove_prefix((rows + 1) * sizeof(Offset));
+    if (column.offsets_[0] != 0 || column.offsets_[rows] != bytes ||
+        !std::is_sorted(column.offsets_.begin(), column.offsets_.end())) {
+        throw std::invalid_argument(error);
+    }
+    column.data_.assign(buffer.data(), buffer.data() + bytes);
+    column.validity_.assign(buffer.data() + bytes, buffer.data() + bytes + bitmap);
+    column.null_count_ = nulls;
+    return column;
+}
+
+template class GiString::BasicStringColumn<uint32_t>;
+template class GiString::BasicStringColumn<uint64_t>;
+
+// Example usage:
+// GiString::StringColumn names(std::vector<std::string>{" Alice ", "bob"});
+// names.push_null();
+// GiString::StringColumn keys = names.trim().lower();
+// std::vector<char> starts = keys.startswith("b");
+// std::string wire;
+// keys.serialize(wire);
+// GiString::StringColumn copy = GiString::StringColumn::deserialize(wire);
+// std::cout << copy[0] << " " << int(starts[1]) << " " << copy.is_null(2) << std::endl;
+// Output: "alice 1 1"
+
+
+namespace {
+    // Suffix rules: a word ending in suffix has it replaced by replacement. The longest
+    // matching suffix wins; the empty suffix is the fallback.
+    struct InflectionRule
+    {
+        const char* suffix;
+        const char* replacement;
+    };
+
+    const InflectionRule plural_rules[] = {
+        {"", "s"},
+        {"s", "ses"},
+        {"ss", "sses"},
+        {"us", "uses"},
+        {"sis", "ses"},
+        {"x", "xes"},
+        {"z", "zes"},
+        {"zz", "zzes"},
+        {"ch", "ches"},
+        {"sh", "shes"},
+        {"y", "ies"},
+        {"ay", "ays"},
+        {"ey", "eys"},
+        {"iy", "iys"},
+        {"oy", "oys"},
+        {"uy", "uys"},
+        {"quy", "quies"},
+        {"atrix", "atrices"},
+        {"ertex", "ertices"},
+    };
+
+    const InflectionRule singular_rules[] = {
+        {"", ""}, // Already singular
+        {"s", ""},
+        {"ss", "ss"},
+        {"us", "us"},
+        {"is", "is"},
+        {"ies", "y"},
+        {"sses", "ss"},
+        {"xes", "x"},
+        {"zzes", "zz"},
+        {"ches", "ch"},
+        {"shes", "sh"},
+        {"yses", "ysis"},
+        {"theses", "thesis"},
+        {"atrices", "atrix"},
+        {"ertices", "ertex"},
+        {"ndices", "ndex"},
+    };
+
+    // Rule suffixes in a trie keyed by the suffix read backwards, so one walk from the end
+    // of a word finds its longest matching rule
+    class SuffixTrie
+    {
+    public:
+        template <size_t N>
+        explicit SuffixTrie(const InflectionRule (&rules)[N]) : rules_(rules) {
+            nodes_.push_back(Node{'\0', -1, -1, -1});
+            for (size_t r = 0; r < N; ++r) {
+                int32_t node = 0;
+                for (size_t i = std::strlen(rules[r].suffix); i > 0; --i) {
+                    int32_t next = child(node, rules[r].suffix[i - 1]);
+                    node = next >= 0 ? next : add_child(node, rules[r].suffix[i - 1]);
+                }
+                nodes_[node].rule = static_cast<int32_t>(r);
+            }
+        }
+
+        const InflectionRule& match(std::string_view word) const {
+            int32_t best = nodes_[0].rule;
+            int32_t node = 0;
+            for (size_t i = word.size(); i > 0; --i) {
+                node = child(node, GiStringCore::to_lower(word[i - 1]));
+                if (node < 0) {
+                    break;
+                }
+                if (nodes_[node].rule >= 0) {
+                    best = nodes_[node].rule;
+                }
+            }
+            return rules_[best];
+        }
+
+    private:
+        struct Node
+        {
+            char c;
+            int32_t first_child;
+            int32_t next_sibling;
+            int32_t rule;
+        };
+
+        int32_t child(int32_t node, char c) const {
+            for (int32_t next = nodes_[node].first_child; next >= 0; next = nodes_[next].next_sibling) {
+                if (nodes_[next].c == c) {
+                    return next;
+                }
+            }
+            return -1;
+        }
+
+        int32_t add_child(int32_t node, char c) {
+            nodes_.push_back(Node{c, -1, nodes_[node].first_child, -1});
+            nodes_[node].first_child = static_cast<int32_t>(nodes_.size() - 1);
+            return nodes_[node].first_child;
+        }
+
+        std::vector<Node> nodes_;
+        const InflectionRule* rules_;
+    };
+
+    const char* const uncountable_words[] = {
+        "advice", "aircraft", "bison", "data", "deer", "equipment", "evidence", "feedback",
+        "fish", "furniture", "hardware", "homework", "information", "jeans", "knowledge",
+        "luggage", "metadata", "moose", "money", "music", "news", "offspring", "police",
+        "rice", "salmon", "series", "sheep", "shrimp", "software", "species", "swine",
+        "traffic", "trout", "weather",
+    };
+
+    struct IrregularWord
+    {
+        const char* singular;
+        const char* plural;
+    };
+
+    // Singular and plural pairs the suffix rules get wrong, including singulars ending in
+    // "s" whose "-ses" plural the singular rules would otherwise cut back to "-se"
+    const IrregularWord irregular_words[] = {
+        {"alias", "aliases"}, {"alumnus", "alumni"}, {"analysis", "analyses"}, {"appendix", "appendices"},
+        {"atlas", "atlases"}, {"axis", "axes"}, {"basis", "bases"}, {"bias", "biases"},
+        {"bonus", "bonuses"}, {"bus", "buses"}, {"cache", "caches"}, {"cactus", "cacti"},
+        {"calf", "calves"}, {"campus", "campuses"}, {"canvas", "canvases"}, {"child", "children"},
+        {"cookie", "cookies"}, {"crisis", "crises"}, {"criterion", "criteria"}, {"curriculum", "curricula"},
+        {"diagnosis", "diagnoses"}, {"die", "dice"}, {"echo", "echoes"}, {"elf", "elves"},
+        {"focus", "foci"}, {"foot", "feet"}, {"fungus", "fungi"}, {"gas", "gases"},
+        {"genus", "genera"}, {"goose", "geese"}, {"half", "halves"}, {"hero", "heroes"},
+        {"iris", "irises"}, {"knife", "knives"}, {"leaf", "leaves"}, {"lens", "lenses"},
+        {"life", "lives"}, {"loaf", "loaves"}, {"louse", "lice"}, {"man", "men"},
+        {"medium", "media"}, {"memorandum", "memoranda"}, {"mouse", "mice"}, {"movie", "movies"},
+        {"niche", "niches"}, {"nucleus", "nuclei"}, {"octopus", "octopi"}, {"ox", "oxen"},
+        {"person", "people"}, {"phenomenon", "phenomena"}, {"pie", "pies"}, {"potato", "potatoes"},
+        {"quiz", "quizzes"}, {"radius", "radii"}, {"self", "selves"}, {"shelf", "shelves"},
+        {"status", "statuses"}, {"stimulus", "stimuli"}, {"syllabus", "syllabi"}, {"that", "those"},
+        {"thief", "thieves"}, {"this", "these"}, {"tie", "ties"}, {"tomato", "tomatoes"},
+        {"tooth", "teeth"}, {"torpedo", "torpedoes"}, {"veto", "vetoes"}, {"virus", "viruses"},
+        {"wife", "wives"}, {"wolf", "wolves"}, {"woman", "women"},
+    };
+
+    bool equals_lowercase(const char* key, std::string_view word) {
+        size_t i = 0;
+        for (; i < word.size() && key[i] != '\0'; ++i) {
+            if (GiStringCore::to_lower(word[i]) != key[i]) {
+                return false;
+            }
+        }
+        return i == word.size() && key[i] == '\0';
+    }
+
+    // Perfect hash over the irregular and uncountable words, built with hash-and-displace:
+    // keys are grouped into buckets by one hash, and each bucket gets the seed for a second
+    // hash that sends all of its keys to free slots. A lookup is two hashes and one compare.
+    class InflectionLexicon
+    {
+    public:
+        enum Kind : uint8_t { uncountable, singular, plural };
+
+        struct Entry
+        {
+            const char* word = nullptr;
+            const char* partner = nullptr; // The other form of an irregular word
+            Kind kind = uncountable;
+        };
+
+        InflectionLexicon() {
+            std::vector<Entry> entries;
+            for (const char* word : uncountable_words) {
+                entries.push_back(Entry{word, word, uncountable});
+            }
+            for (const IrregularWord& pair : irregular_words) {
+                entries.push_back(Entry{pair.singular, pair.plural, singular});
+                entries.push_back(Entry{pair.plural, pair.singular, plural});
+            }
+            // Equal keys always hash to the same slot, so the seed search below would never end
+            std::vector<std::string_view> words(entries.size());
+            for (size_t i = 0; i < entries.size(); ++i) {
+                words[i] = entries[i].word;
+            }
+            std::sort(words.begin(), words.end());
+            if (std::adjacent_find(words.begin(), words.end()) != words.end()) {
+                throw std::logic_error("Duplicate word in the inflection tables (GiString::Inflector)");
+            }
+
+            size_t slots = 1;
+            while (slots < entries.size() * 2) {
+                slots <<= 1;
+            }
+            slots_.resize(slots);
+            mask_ = slots - 1;
+            seeds_.assign(entries.size() / 2 + 1, 0);
+
+            std::vector<std::vector<const Entry*>> buckets(seeds_.size());
+            for (const Entry& entry : entries) {
+                buckets[hash(entry.word, 0) % seeds_.size()].push_back(&entry);
+            }
+            std::vector<size_t> order(buckets.size());
+            for (size_t b = 0; b < order.size(); ++b) {
+                order[b] = b;
+            }
+            std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return buckets[a].size() > buckets[b].size(); });
+
+            std::vector<size_t> placed;
+            for (size_t b : order) {
+                for (uint32_t seed = 1; !buckets[b].empty(); ++seed) {
+                    placed.clear();
+                    for (const Entry* entry : buckets[b]) {
+                        size_t slot = hash(entry->word, seed) & mask_;
+                        if (slots_[slot].word || std::find(placed.begin(), placed.end(), slot) != placed.end()) {
+                            break;
+                        }
+                        placed.push_back(slot);
+                    }
+                    if (placed.size() == buckets[b].size()) {
+                        for (size_t k = 0; k < placed.size(); ++k) {
+                            slots_[placed[k]] = *buckets[b][k];
+                        }
+                        seeds_[b] = seed;
+                        break;
+                    }
+                }
+            }
+        }
+
+        const Entry* find(std::string_view word) const {
+            uint32_t seed = seeds_[hash(word, 0) % seeds_.size()];
+            const Entry& entry = slots_[hash(word, seed) & mask_];
+            return entry.word && equals_lowercase(entry.word, word) ? &entry : nullptr;
+        }
+
+    private:
+        // Case-insensitive FNV-1a, seeded
+        static uint64_t hash(std::string_view word, uint32_t seed) {
+            uint64_t h = 0xCBF29CE484222325ULL ^ (static_cast<uint64_t>(seed) * 0x9E3779B97F4A7C15ULL);
+            for (char c : word) {
+                h ^= static_cast<unsigned char>(GiStringCore::to_lower(c));
+                h *= 0x100000001B3ULL;
+            }
+            return h ^ (h >> 29);
+        }
+
+        std::vector<Entry> slots_;
+        std::vector<uint32_t> seeds_;
+        size_t mask_ = 0;
+    };
+
+    struct InflectionTables
+    {
+        SuffixTrie plural{plural_rules};
+        SuffixTrie singular{singular_rules};
+        InflectionLexicon lexicon;
+    };
+
+    const InflectionTables& inflection_tables() {
+        static const InflectionTables tables;
+        return tables;
+    }
+
+    // Start of the last word of an identifier: after the last non-letter or where
+    // GiStringCore::word_starts_at begins a new word ("SalesPerson", "HTTPServer", "getJSONId";
+    // "userIDs" ends in "IDs")
+    size_t last_word_start(std::string_view word) {
+        size_t i = word.size();
+        while (i > 0 && GiStringCore::is_alpha(word[i - 1])) {
+            --i;
+            if (i > 0 && GiStringCore::word_starts_at(word, i)) {
+                break;
+            }
+        }
+        return i;
+    }
+
+    // Appends text in the case of the word it replaces: all caps, capitalized or lowercase
+    void append_in_case(const char* text, std::string_view model, bool capitalize, GiString::Appender& out) {
+        bool all_caps = model.size() > 1 && GiStringCore::all_of(model, [](char c) { return !GiStringCore::is_lower(c); });
+        for (size_t i = 0; text[i] != '\0'; ++i) {
+            bool upper = all_caps || (capitalize && i == 0);
+            out.push_back(upper ? GiStringCore::to_upper(text[i]) : text[i]);
+        }
+    }
+
+    size_t common_prefix_lowercase(const char* key, std::string_view word) {
+        size_t i = 0;
+        while (i < word.size() && key[i] != '\0' && GiStringCore::to_lower(word[i]) == key[i]) {
+            ++i;
+        }
+        return i;
+    }
+
+    void inflect_word(std::string_view word, bool plural, GiString::Appender out) {
+        if (word.empty()) {
+            return;
+        }
+        const InflectionTables& tables = inflection_tables();
+        size_t start = last_word_start(word);
+        std::string_view last = word.substr(start);
+        if (const InflectionLexicon::Entry* entry = tables.lexicon.find(last)) {
+            out.append(word.data(), start);
+            size_t shared = common_prefix_lowercase(entry->partner, last);
+            if (entry->kind == InflectionLexicon::uncountable || entry->kind == (plural ? InflectionLexicon::plural : InflectionLexicon::singular)) {
+                out.append(last.data(), last.size());
+            } else if (shared == last.size() || entry->partner[shared] == '\0') {
+                // The forms differ only by a suffix ("children", "statuses"): keep the word's
+                // own letters and add lowercase ones, as the rules do
+                out.append(last.data(), shared);
+                out.append(entry->partner + shared);
+            } else {
+                append_in_case(entry->partner, last, GiStringCore::is_upper(last[0]), out);
+            }
+            return;
+        }
+
+        // A rule never consumes the whole last word ("S" is not "" plus "ses"); such words
+        // take the default rule
+        const InflectionRule* rule = &(plural ? tables.plural : tables.singular).match(word);
+        if (std::strlen(rule->suffix) >= last.size()) {
+            rule = plural ? &plural_rules[0] : &singular_rules[0];
+        }
+        // The letters the rule keeps stay in the word's case and added letters are lowercase,
+        // so acronyms read "IDs" and "userIDs" alike
+        size_t suffix = std::strlen(rule->suffix);
+        size_t kept = 0;
+        while (kept < suffix && rule->replacement[kept] == rule->suffix[kept]) {
+            ++kept;
+        }
+        out.append(word.data(), word.size() - suffix + kept);
+        out.append(rule->replacement + kept);
+    }
+}
+
+struct GiString::Inflector::Cache
+{
+    struct Entry
+    {
+        uint64_t key;
+        bool plural;
+        std::string word;
+        std::string result;
+    };
+
+    explicit Cache(size_t capacity) : capacity(capacity) {}
+
+    static uint64_t key(std::string_view word, bool plural) {
+        return GiStringCore::hash(word) ^ (plural ? 0x9E3779B97F4A7C15ULL : 0);
+    }
+
+    size_t capacity;
+    std::mutex mutex;
+    std::list<Entry> entries; // Most recently used first
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> index;
+    size_t hits = 0;
+    size_t misses = 0;
+};
+
+/**
+ * @brief Creates an inflector, optionally with an LRU cache of cache_capacity results.
+ *
+ * The rule trie and the irregular word table are shared by all inflectors and built on
+ * first use; an inflector without a cache holds no state of its own.
+ */
+GiString::Inflector::Inflector(size_t cache_capacity) {
+    inflection_tables();
+    if (cache_capacity > 0) {
+        cache_ = std::make_unique<Cache>(cache_capacity);
+    }
+}
+
+GiString::Inflector::~Inflector() = default;
+GiString::Inflector::Inflector(Inflector&& other) noexcept = default;
+GiString::Inflector& GiString::Inflector::operator=(Inflector&& other) noexcept = default;
+
+/**
+ * @brief Returns the plural form of a noun or identifier ("category" to "categories").
+ */
+std::string GiString::Inflector::pluralize(std::string_view word) {
+    std::string result;
+    result.reserve(word.size() + 3);
+    inflect(word, true, result);
+    return result;
+}
+
+/**
+ * @brief Returns the singular form of a noun or identifier ("UserAddresses" to "UserAddress").
+ */
+std::string GiString::Inflector::singularize(std::string_view word) {
+    std::string result;
+    result.reserve(word.size());
+    inflect(word, false, result);
+    return result;
+}
+
+void GiString::Inflector::pluralize(std::string_view word, Appender out) {
+    inflect(word, true, out);
+}
+
+void GiString::Inflector::singularize(std::string_view word, Appender out) {
+    inflect(word, false, out);
+}
+
+/**
+ * @brief Checks whether the last word of word has no plural form ("metadata", "UserFeedback").
+ */
+bool GiString::Inflector::is_uncountable(std::string_view word) const {
+    const InflectionLexicon::Entry* entry = inflection_tables().lexicon.find(word.substr(last_word_start(word)));
+    return entry && entry->kind == InflectionLexicon::uncountable;
+}
+
+size_t GiString::Inflector::cache_hits() const {
+    if (!cache_) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(cache_->mutex);
+    return cache_->hits;
+}
+
+size_t GiString::Inflector::cache_misses() const {
+    if (!cache_) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(cache_->mutex);
+    return cache_->misses;
+}
+
+void GiString::Inflector::inflect(std::string_view word, bool plural, Appender out) {
+    if (cache_) {
+        uint64_t key = Cache::key(word, plural);
+        {
+            std::lock_guard<std::mutex> lock(cache_->mutex);
+            auto found = cache_->index.find(key);
+            if (found != cache_->index.end() && found->second->plural == plural && found->second->word == word) {
+                cache_->entries.splice(cache_->entries.begin(), cache_->entries, found->second);
+                ++cache_->hits;
+                out.append(found->second->result.data(), found->second->result.size());
+                return;
+            }
+            ++cache_->misses;
+        }
+
+        Cache::Entry entry{key, plural, std::string(word), std::string()};
+        inflect_word(word, plural, entry.result);
+        out.append(entry.result.data(), entry.result.size());
+
+        std::lock_guard<std::mutex> lock(cache_->mutex);
+        auto found = cache_->index.find(key);
+        if (found != cache_->index.end()) {
+            cache_->entries.erase(found->second);
+        }
+        cache_->entries.push_front(std::move(entry));
+        cache_->index[key] = cache_->entries.begin();
+        if (cache_->entries.size() > cache_->capacity) {
+            cache_->index.erase(cache_->entries.back().key);
+            cache_->entries.pop_back();
+        }
+        return;
+    }
+
+    inflect_word(word, plural, out);
+}
+
+// Example usage:
+// GiString::Inflector inflector(4096);            // cache the entity names of a schema
+// for (const std::string& entity : {"UserCategory", "SalesPerson", "order_status", "Metadata"}) {
+//     std::cout << inflector.pluralize(entity) << " ";
+// }
+// Output: "UserCategories SalesPeople order_statuses Metadata "
+// std::cout << inflector.singularize("ADDRESSES") << std::endl;
+// Output: "ADDRESS"
+
+
+
+namespace
+{
+    constexpr size_t sorted_leaf_capacity = 64;
+    constexpr size_t sorted_inner_capacity = 64;
+    constexpr size_t sorted_bulk_fill = sorted_leaf_capacity * 3 / 4;
+
+    // A front-coded leaf entry: its key is the previous key's first `shared` bytes followed
+    // by `suffix`. Multiset entries also carry the number of copies.
+    struct SortedEntry
+    {
+        size_t shared;
+        std::string_view suffix;
+        size_t count;
+        size_t end;
+    };
+
+    void write_varint(std::string& out, size_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    size_t read_varint(const std::string& data, size_t& offset) {
+        size_t value = 0;
+        for (int shift = 0;; shift += 7) {
+            unsigned char byte = static_cast<unsigned char>(data[offset++]);
+            value |= static_cast<size_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+    }
+
+    template <bool Multi>
+    SortedEntry read_sorted_entry(const std::string& data, size_t offset) {
+        SortedEntry entry;
+        entry.shared = read_varint(data, offset);
+        size_t length = read_varint(data, offset);
+        entry.count = Multi ? read_varint(data, offset) : 1;
+        entry.suffix = std::string_view(data.data() + offset, length);
+        entry.end = offset + length;
+        return entry;
+    }
+
+    template <bool Multi>
+    void encode_sorted_entry(std::string& out, size_t shared, std::string_view suffix, size_t count) {
+        write_varint(out, shared);
+        write_varint(out, suffix.size());
+        if (Multi) {
+            write_varint(out, count);
+        }
+        out.append(suffix.data(), suffix.size());
+    }
+
+    // Appends key front-coded against previous.
+    template <bool Multi>
+    void write_sorted_entry(std::string& out, std::string_view previous, std::string_view key, size_t count) {
+        size_t shared = 0;
+        size_t limit = std::min(previous.size(), key.size());
+        while (shared < limit && previous[shared] == key[shared]) {
+            ++shared;
+        }
+        encode_sorted_entry<Multi>(out, shared, key.substr(shared), count);
+    }
+
+    // Compares key with the key of entry, whose predecessor is previous.
+    int compare_sorted_entry(std::string_view key, std::string_view previous, const SortedEntry& entry) {
+        int order = key.substr(0, entry.shared).compare(previous.substr(0, entry.shared));
+        if (order != 0) {
+            return order;
+        }
+        return key.substr(entry.shared).compare(entry.suffix);
+    }
+
+    void apply_sorted_entry(std::string& key, const SortedEntry& entry) {
+        key.resize(entry.shared);
+        key.append(entry.suffix.data(), entry.suffix.size());
+    }
+
+    // Returns the offset of the first entry not less than key; previous receives the key
+    // before it and found whether the entry equals key.
+    template <bool Multi>
+    size_t seek_sorted_entry(const std::string& data, std::string_view key, std::string& previous, bool& found) {
+        previous.clear();
+        size_t offset = 0;
+        while (offset < data.size()) {
+            SortedEntry entry = read_sorted_entry<Multi>(data, offset);
+            int order = compare_sorted_entry(key, previous, entry);
+            if (order <= 0) {
+                found = order == 0;
+                return offset;
+            }
+            apply_sorted_entry(previous, entry);
+            offset = entry.end;
+        }
+        found = false;
+        return offset;
+    }
+
+    // Moves the entries from position index on to right and returns the first of them,
+    // which becomes right's first entry and is stored whole.
+    template <bool Multi>
+    std::string split_sorted_entries(std::string& data, size_t index, std::string& right) {
+        std::string key;
+        size_t offset = 0;
+        for (size_t i = 0; i < index; ++i) {
+            SortedEntry entry = read_sorted_entry<Multi>(data, offset);
+            apply_sorted_entry(key, entry);
+            offset = entry.end;
+        }
+        SortedEntry middle = read_sorted_entry<Multi>(data, offset);
+        apply_sorted_entry(key, middle);
+        right.clear();
+        encode_sorted_entry<Multi>(right, 0, key, middle.count);
+        right.append(data, middle.end, std::string::npos);
+        data.resize(offset);
+        return key;
+    }
+
+    // Appends the entries of right, all greater than those of data.
+    template <bool Multi>
+    void append_sorted_entries(std::string& data, const std::string& right) {
+        if (right.empty()) {
+            return;
+        }
+        std::string last;
+        for (size_t offset = 0; offset < data.size();) {
+            SortedEntry entry = read_sorted_entry<Multi>(data, offset);
+            apply_sorted_entry(last, entry);
+            offset = entry.end;
+        }
+        SortedEntry first = read_sorted_entry<Multi>(right, 0);
+        write_sorted_entry<Multi>(data, last, first.suffix, first.count);
+        data.append(right, first.end, std::string::npos);
+    }
+}
+
+template <bool Multi>
+struct GiString::BasicSortedStrings<Multi>::Node
+{
+    explicit Node(bool is_leaf) : leaf(is_leaf) {}
+    virtual ~Node() = default;
+
+    bool leaf;
+};
+
+template <bool Multi>
+struct GiString::BasicSortedStrings<Multi>::Leaf : Node
+{
+    Leaf() : Node(true) {}
+
+    std::string data;      // Front-coded entries in order, the first one stored whole
+    size_t count = 0;      // Distinct keys in data
+    Leaf* next = nullptr;  // Following leaf in key order
+};
+
+template <bool Multi>
+struct GiString::BasicSortedStrings<Multi>::Inner : Node
+{
+    Inner() : Node(false) {}
+
+    // children[i] holds keys below keys[i], children[i + 1] keys from keys[i] on
+    std::vector<std::string> keys;
+    std::vector<std::unique_ptr<Node>> children;
+};
+
+/**
+ * @brief Creates an empty set.
+ */
+template <bool Multi>
+GiString::BasicSortedStrings<Multi>::BasicSortedStrings() = default;
+
+/**
+ * @brief Bulk-loads the set from unsorted strings (see assign).
+ *
+ * @param strings The keys, in any order; duplicates are dropped unless Multi is true.
+ */
+template <bool Multi>
+GiString::BasicSortedStrings<Multi>::BasicSortedStrings(std::vector<std::string> strings) {
+    assign(std::move(strings));
+}
+
+template <bool Multi>
+GiString::BasicSortedStrings<Multi>::BasicSortedStrings(const BasicSortedStrings& other) : size_(other.size_) {
+    if (other.root_) {
+        Leaf* last = nullptr;
+        root_ = clone(*other.root_, last);
+    }
+}
+
+template <bool Multi>
+GiString::BasicSortedStrings<Multi>::BasicSortedStrings(BasicSortedStrings&& other) noexcept
+    : root_(std::move(other.root_)), size_(std::exchange(other.size_, 0)) {}
+
+template <bool Multi>
+GiString::BasicSortedStrings<Multi>& GiString::BasicSortedStrings<Multi>::operator=(const BasicSortedStrings& other) {
+    if (this != &other) {
+        *this = BasicSortedStrings(other);
+    }
+    return *this;
+}
+
+template <bool Multi>
+GiString::BasicSortedStrings<Multi>& GiString::BasicSortedStrings<Multi>::operator=(BasicSortedStrings&& other) noexcept {
+    root_ = std::move(other.root_);
+    size_ = std::exchange(other.size_, 0);
+    return *this;
+}
+
+template <bool Multi>
+GiString::BasicSortedStrings<Multi>::~BasicSortedStrings() = default;
+
+/**
+ * @brief Replaces the contents with strings, sorting them and building the tree bottom-up.
+ *
+ * O(n log n) for the sort and O(n) for the build, much faster than inserting one key at a
+ * time. Leaves are filled to three quarters so that later inserts do not split at once.
+ *
+ * @param strings The keys, in any order; duplicates are dropped unless Multi is true.
+ */
+template <bool Multi>
+void GiString::BasicSortedStrings<Multi>::assign(std::vector<std::string> strings) {
+    clear();
+    std::sort(strings.begin(), strings.end());
+    size_t distinct = 0;
+    for (size_t i = 0; i < strings.size(); ++i) {
+        if (i == 0 || strings[i] != strings[i - 1]) {
+            ++distinct;
+        }
+    }
+    if (distinct == 0) {
+        return;
+    }
+
+    // Spread the keys evenly so the last node is not left nearly empty
+    std::vector<std::unique_ptr<Node>> level;
+    std::vector<std::string> firsts;
+    size_t leaves = (distinct + sorted_bulk_fill - 1) / sorted_bulk_fill;
+    Leaf* previous_leaf = nullptr;
+    size_t i = 0;
+    for (size_t l = 0; l < leaves; ++l) {
+        auto leaf = std::make_unique<Leaf>();
+        leaf->count = distinct / leaves + (l < distinct % leaves ? 1 : 0);
+        firsts.push_back(strings[i]);
+        std::string_view previous;
+        for (size_t k = 0; k < leaf->count; ++k) {
+            size_t j = i + 1;
+            while (j < strings.size() && strings[j] == strings[i]) {
+                ++j;
+            }
+            write_sorted_entry<Multi>(leaf->data, previous, strings[i], j - i);
+            previous = strings[i];
+            i = j;
+        }
+        if (previous_leaf) {
+            previous_leaf->next = leaf.get();
+        }
+        previous_leaf = leaf.get();
+        level.push_back(std::move(leaf));
+    }
+
+    while (level.size() > 1) {
+        std::vector<std::unique_ptr<Node>> parents;
+        std::vector<std::string> parent_firsts;
+        size_t groups = (level.size() + sorted_bulk_fill - 1) / sorted_bulk_fill;
+        size_t c = 0;
+        for (size_t g = 0; g < groups; ++g) {
+            size_t quota = level.size() / groups + (g < level.size() % groups ? 1 : 0);
+            auto inner = std::make_unique<Inner>();
+            parent_firsts.push_back(std::move(firsts[c]));
+            for (size_t k = 0; k < quota; ++k, ++c) {
+                if (k > 0) {
+                    inner->keys.push_back(std::move(firsts[c]));
+                }
+                inner->children.push_back(std::move(level[c]));
+            }
+            parents.push_back(std::move(inner));
+        }
+        level = std::move(parents);
+        firsts = std::move(parent_firsts);
+    }
+    root_ = std::move(level[0]);
+    size_ = Multi ? strings.size() : distinct;
+}
+
+/**
+ * @brief Inserts key.
+ *
+ * @return false if the set already holds key (a multiset always inserts another copy).
+ */
+template <bool Multi>
+bool GiString::BasicSortedStrings<Multi>::insert(std::string_view key) {
+    if (!root_) {
+        root_ = std::make_unique<Leaf>();
+    }
+    Path path;
+    Leaf* leaf = descend(key, &path);
+    std::string previous;
+    bool found;
+    size_t offset = seek_sorted_entry<Multi>(leaf->data, key, previous, found);
+    std::string bytes;
+    if (found) {
+        if (!Multi) {
+            return false;
+        }
+        SortedEntry entry = read_sorted_entry<Multi>(leaf->data, offset);
+        encode_sorted_entry<Multi>(bytes, entry.shared, entry.suffix, entry.count + 1);
+        leaf->data.replace(offset, entry.end - offset, bytes);
+        ++size_;
+        return true;
+    }
+
+    // The new entry goes before the one at offset, which is re-coded against it
+    write_sorted_entry<Multi>(bytes, previous, key, 1);
+    size_t end = offset;
+    if (offset < leaf->data.size()) {
+        SortedEntry next = read_sorted_entry<Multi>(leaf->data, offset);
+        apply_sorted_entry(previous, next);
+        write_sorted_entry<Multi>(bytes, key, previous, next.count);
+        end = next.end;
+    }
+    leaf->data.replace(offset, end - offset, bytes);
+    ++leaf->count;
+    ++size_;
+
+    if (leaf->count > sorted_leaf_capacity) {
+        auto right = std::make_unique<Leaf>();
+        std::string separator = split(*leaf, *right);
+        grow(path, std::move(separator), std::move(right));
+    }
+    return true;
+}
+
+/**
+ * @brief Removes one copy of key.
+ *
+ * @return false if key is not in the set.
+ */
+template <bool Multi>
+bool GiString::BasicSortedStrings<Multi>::erase(std::string_view key) {
+    if (!root_) {
+        return false;
+    }
+    Path path;
+    Leaf* leaf = descend(key, &path);
+    std::string previous;
+    bool found;
+    size_t offset = seek_sorted_entry<Multi>(leaf->data, key, previous, found);
+    if (!found) {
+        return false;
+    }
+    SortedEntry entry = read_sorted_entry<Multi>(leaf->data, offset);
+    std::string bytes;
+    if (entry.count > 1) {
+        encode_sorted_entry<Multi>(bytes, entry.shared, entry.suffix, entry.count - 1);
+        leaf->data.replace(offset, entry.end - offset, bytes);
+        --size_;
+        return true;
+    }
+
+    // The following entry was coded against key and is re-coded against previous
+    size_t end = entry.end;
+    if (end < leaf->data.size()) {
+        SortedEntry next = read_sorted_entry<Multi>(leaf->data, end);
+        std::string following(key.substr(0, next.shared));
+        following.append(next.suffix.data(), next.suffix.size());
+        write_sorted_entry<Multi>(bytes, previous, following, next.count);
+        end = next.end;
+    }
+    leaf->data.replace(offset, end - offset, bytes);
+    --leaf->count;
+    --size_;
+
+    auto underfull = [](const Node* node) {
+        return node->leaf ? static_cast<const Leaf*>(node)->count < sorted_leaf_capacity / 4
+                          : static_cast<const Inner*>(node)->children.size() < sorted_inner_capacity / 4;
+    };
+    const Node* node = leaf;
+    while (!path.empty() && underfull(node)) {
+        auto [parent, index] = path.back();
+        path.pop_back();
+        merge(*parent, index + 1 < parent->children.size() ? index : index - 1);
+        node = parent;
+    }
+    while (!root_->leaf && static_cast<Inner&>(*root_).children.size() == 1) {
+        std::unique_ptr<Node> child = std::move(static_cast<Inner&>(*root_).children[0]);
+        root_ = std::move(child);
+    }
+    return true;
+}
+
+template <bool Multi>
+void GiString::BasicSortedStrings<Multi>::clear() {
+    root_.reset();
+    size_ = 0;
+}
+
+template <bool Multi>
+bool GiString::BasicSortedStrings<Multi>::contains(std::string_view key) const {
+    return find(key) != end();
+}
+
+/**
+ * @brief Returns the number of copies of key (0 or 1 for a set).
+ */
+template <bool Multi>
+size_t GiString::BasicSortedStrings<Multi>::count(std::string_view key) const {
+    const_iterator found = find(key);
+    return found == end() ? 0 : found.repeat_ + 1;
+}
+
+/**
+ * @brief Returns the bytes the front-coded leaves take, a measure of the prefix compression.
+ */
+template <bool Multi>
+size_t GiString::BasicSortedStrings<Multi>::stored_bytes() const {
+    size_t bytes = 0;
+    for (const_iterator first = begin(); first.leaf_; first.leaf_ = first.leaf_->next) {
+        bytes += first.leaf_->data.size();
+    }
+    return bytes;
+}
+
+template <bool Multi>
+typename GiString::BasicSortedStrings<Multi>::const_iterator GiString::BasicSortedStrings<Multi>::begin() const {
+    const_iterator first;
+    if (root_) {
+        const Node* node = root_.get();
+        while (!node->leaf) {
+            node = static_cast<const Inner*>(node)->children[0].get();
+        }
+        first.enter(static_cast<const Leaf*>(node), 0);
+    }
+    return first;
+}
+
+template <bool Multi>
+typename GiString::BasicSortedStrings<Multi>::const_iterator GiString::BasicSortedStrings<Multi>::find(std::string_view key) const {
+    const_iterator found = lower_bound(key);
+    return found != end() && *found == key ? found : end();
+}
+
+/**
+ * @brief Returns the first key not less than key.
+ */
+template <bool Multi>
+typename GiString::BasicSortedStrings<Multi>::const_iterator GiString::BasicSortedStrings<Multi>::lower_bound(std::string_view key) const {
+    return seek(key, false);
+}
+
+/**
+ * @brief Returns the first key greater than key.
+ */
+template <bool Multi>
+typename GiString::BasicSortedStrings<Multi>::const_iterator GiString::BasicSortedStrings<Multi>::upper_bound(std::string_view key) const {
+    return seek(key, true);
+}
+
+/**
+ * @brief Returns the keys in [first, last) as a pair of iterators.
+ */
+template <bool Multi>
+std::pair<typename GiString::BasicSortedStrings<Multi>::const_iterator, typename GiString::BasicSortedStrings<Multi>::const_iterator>
+GiString::BasicSortedStrings<Multi>::range(std::string_view first, std::string_view last) const {
+    const_iterator from = lower_bound(first);
+    if (!(first < last)) {
+        return {from, from};
+    }
+    return {from, lower_bound(last)};
+}
+
+/**
+ * @brief Returns the keys starting with prefix as a pair of iterators.
+ */
+template <bool Multi>
+std::pair<typename GiString::BasicSortedStrings<Multi>::const_iterator, typename GiString::BasicSortedStrings<Multi>::const_iterator>
+GiString::BasicSortedStrings<Multi>::prefix_range(std::string_view prefix) const {
+    // The first string past every key with the prefix: drop trailing 0xFF bytes, bump the last
+    std::string past(prefix);
+    while (!past.empty() && static_cast<unsigned char>(past.back()) == 0xFF) {
+        past.pop_back();
+    }
+    if (past.empty()) {
+        return {lower_bound(prefix), end()};
+    }
+    past.back() = static_cast<char>(static_cast<unsigned char>(past.back()) + 1);
+    return {lower_bound(prefix), lower_bound(past)};
+}
+
+/**
+ * @brief Returns every key in order (a multiset repeats duplicates).
+ */
+template <bool Multi>
+std::vector<std::string> GiString::BasicSortedStrings<Multi>::to_vector() const {
+    std::vector<std::string> keys;
+    keys.reserve(size_);
+    for (const std::string& key : *this) {
+        keys.push_back(key);
+    }
+    return keys;
+}
+
+template <bool Multi>
+typename GiString::BasicSortedStrings<Multi>::Leaf* GiString::BasicSortedStrings<Multi>::descend(std::string_view key, Path* path) const {
+    Node* node = root_.get();
+    while (!node->leaf) {
+        Inner* inner = static_cast<Inner*>(node);
+        size_t index = std::upper_bound(inner->keys.begin(), inner->keys.end(), key,
+                                        [](std::string_view lhs, const std::string& rhs) { return lhs < rhs; }) -
+                       inner->keys.begin();
+        if (path) {
+            path->emplace_back(inner, index);
+        }
+        node = inner->children[index].get();
+    }
+    return static_cast<Leaf*>(node);
+}
+
+// Finds the first key not less than key, or greater than key when after is set.
+template <bool Multi>
+typename GiString::BasicSortedStrings<Multi>::const_iterator GiString::BasicSortedStrings<Multi>::seek(std::string_view key, bool after) const {
+    const_iterator found;
+    if (!root_) {
+        return found;
+    }
+    const Leaf* leaf = descend(key, nullptr);
+    bool equal;
+    size_t offset = seek_sorted_entry<Multi>(leaf->data, key, found.key_, equal);
+    if (equal && after) {
+        SortedEntry entry = read_sorted_entry<Multi>(leaf->data, offset);
+        apply_sorted_entry(found.key_, entry);
+        offset = entry.end;
+    }
+    found.enter(leaf, offset);
+    return found;
+}
+
+// Adds right after the node at the bottom of path, splitting full parents on the way up.
+template <bool Multi>
+void GiString::BasicSortedStrings<Multi>::grow(Path& path, std::string separator, std::unique_ptr<Node> right) {
+    while (!path.empty()) {
+        auto [parent, index] = path.back();
+        path.pop_back();
+        parent->keys.insert(parent->keys.begin() + index, std::move(separator));
+        parent->children.insert(parent->children.begin() + index + 1, std::move(right));
+        if (parent->children.size() <= sorted_inner_capacity) {
+            return;
+        }
+        auto sibling = std::make_unique<Inner>();
+        separator = split(*parent, *sibling);
+        right = std::move(sibling);
+    }
+    auto root = std::make_unique<Inner>();
+    root->keys.push_back(std::move(separator));
+    root->children.push_back(std::move(root_));
+    root->children.push_back(std::move(right));
+    root_ = std::move(root);
+}
+
+// Merges children index and index + 1 of parent; when the result overflows it is split
+// again, which leaves two evenly filled nodes.
+template <bool Multi>
+void GiString::BasicSortedStrings<Multi>::merge(Inner& parent, size_t index) {
+    Node& left = *parent.children[index];
+    Node& right = *parent.children[index + 1];
+    bool overflow;
+    if (left.leaf) {
+        Leaf& left_leaf = static_cast<Leaf&>(left);
+        Leaf& right_leaf = static_cast<Leaf&>(right);
+        append_sorted_entries<Multi>(left_leaf.data, right_leaf.data);
+        left_leaf.count += right_leaf.count;
+        left_leaf.next = right_leaf.next;
+        overflow = left_leaf.count > sorted_leaf_capacity;
+    } else {
+        Inner& left_inner = static_cast<Inner&>(left);
+        Inner& right_inner = static_cast<Inner&>(right);
+        left_inner.keys.push_back(std::move(parent.keys[index]));
+        std::move(right_inner.keys.begin(), right_inner.keys.end(), std::back_inserter(left_inner.keys));
+        std::move(right_inner.children.begin(), right_inner.children.end(), std::back_inserter(left_inner.children));
+        overflow = left_inner.children.size() > sorted_inner_capacity;
+    }
+    parent.keys.erase(parent.keys.begin() + index);
+    parent.children.erase(parent.children.begin() + index + 1);
+
+    if (overflow) {
+        std::unique_ptr<Node> sibling;
+        std::string separator;
+        if (left.leaf) {
+            auto leaf = std::make_unique<Leaf>();
+            separator = split(static_cast<Leaf&>(left), *leaf);
+            sibling = std::move(leaf);
+        } else {
+            auto inner = std::make_unique<Inner>();
+            separator = split(static_cast<Inner&>(left), *inner);
+            sibling = std::move(inner);
+        }
+        parent.keys.insert(parent.keys.begin() + index, std::move(separator));
+        parent.children.insert(parent.children.begin() + index + 1, std::move(sibling));
+    }
+}
+
+// Moves the upper half of leaf to right and returns right's first key.
+template <bool Multi>
+std::string GiString::BasicSortedStrings<Multi>::split(Leaf& leaf, Leaf& right) {
+    size_t keep = leaf.count / 2;
+    std::string separator = split_sorted_entries<Multi>(leaf.data, keep, right.data);
+    right.count = leaf.count - keep;
+    leaf.count = keep;
+    right.next = leaf.next;
+    leaf.next = &right;
+    return separator;
+}
+
+// Moves the upper half of inner's children to right and returns the key between them.
+template <bool Multi>
+std::string GiString::BasicSortedStrings<Multi>::split(Inner& inner, Inner& right) {
+    size_t middle = inner.children.size() / 2;
+    std::string separator = std::move(inner.keys[middle - 1]);
+    right.keys.assign(std::make_move_iterator(inner.keys.begin() + middle), std::make_move_iterator(inner.keys.end()));
+    right.children.assign(std::make_move_iterator(inner.children.begin() + middle), std::make_move_iterator(inner.children.end()));
+    inner.keys.resize(middle - 1);
+    inner.children.resize(middle);
+    return separator;
+}
+
+// Deep-copies node, linking the copied leaves after last.
+template <bool Multi>
+std::unique_ptr<typename GiString::BasicSortedStrings<Multi>::Node> GiString::BasicSortedStrings<Multi>::clone(const Node& node, Leaf*& last) {
+    if (node.leaf) {
+        auto leaf = std::make_unique<Leaf>(static_cast<const Leaf&>(node));
+        leaf->next = nullptr;
+        if (last) {
+            last->next = leaf.get();
+        }
+        last = leaf.get();
+        return leaf;
+    }
+    const Inner& inner = static_cast<const Inner&>(node);
+    auto copy = std::make_unique<Inner>();
+    copy->keys = inner.keys;
+    copy->children.reserve(inner.children.size());
+    for (const std::unique_ptr<Node>& child : inner.children) {
+        copy->children.push_back(clone(*child, last));
+    }
+    return copy;
+}
+
+template <bool Multi>
+typename GiString::BasicSortedStrings<Multi>::const_iterator& GiString::BasicSortedStrings<Multi>::const_iterator::operator++() {
+    if (repeat_ > 0) {
+        --repeat_;
+    } else {
+        enter(leaf_, next_);
+    }
+    return *this;
+}
+
+// Moves to the entry at offset in leaf, or to the next leaf when offset is past the end;
+// key_ must hold the key before that entry.
+template <bool Multi>
+void GiString::BasicSortedStrings<Multi>::const_iterator::enter(const Leaf* leaf, size_t offset) {
+    if (offset >= leaf->data.size()) {
+        leaf = leaf->next;
+        offset = 0;
+        if (!leaf) {
+            *this = const_iterator();
+            return;
+        }
+    }
+    SortedEntry entry = read_sorted_entry<Multi>(leaf->data, offset);
+    apply_sorted_entry(key_, entry);
+    leaf_ = leaf;
+    offset_ = offset;
+    next_ = entry.end;
+    repeat_ = entry.count - 1;
+}
+
+template class GiString::BasicSortedStrings<false>;
+template class GiString::BasicSortedStrings<true>;
+
+// Example usage:
+// std::vector<std::string> paths = load_paths();           // millions of keys, unsorted
+// GiString::SortedStringSet index(std::move(paths));       // bulk-load
+// index.insert("/usr/lib/libfoo.so");
+// index.erase("/tmp/scratch");
+// auto [first, last] = index.prefix_range("/usr/lib/");
+// for (auto it = first; it != last; ++it) {
+//     std::cout << *it << std::endl;
+// }
+// std::cout << index.size() << " keys in " << index.stored_bytes() << " bytes" << std::endl;
+
+
+
+/**
+ * @brief Removes leading and trailing whitespace from str in place.
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::inplace::trim(std::string& str) {
+    std::string_view trimmed = views::trim(str);
+    if (trimmed.empty()) {
+        str.clear();
+        return;
+    }
+    size_t start = static_cast<size_t>(trimmed.data() - str.data());
+    str.erase(start + trimmed.size());
+    str.erase(0, start);
+}
+
+/**
+ * @brief Converts all letters of str to uppercase in place.
+ *
+ * ASCII strings are converted without reallocating; other UTF-8 strings are replaced by
+ * their full Unicode mapping, which may change the length.
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::inplace::upper(std::string& str) {
+    if (GiUnicode::is_ascii(str.data(), str.size())) {
+        upper(str.data(), str.size());
+        return;
+    }
+    str = GiUnicode::upper(str);
+}
+
+/**
+ * @brief Converts all ASCII letters of a fixed buffer to uppercase; other bytes are left as they are.
+ *
+ * @throws std::invalid_argument If the buffer is empty.
+ */
+void GiString::inplace::upper(char* data, size_t size) {
+    if (size == 0) {
+        throw std::invalid_argument("Input string is empty (GiString::upper)");
+    }
+    GiStringCore::to_upper(data, size);
+}
+
+/**
+ * @brief Converts all letters of str to lowercase in place.
+ *
+ * As with upper(), only non-ASCII strings are reallocated.
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::inplace::lower(std::string& str) {
+    if (GiUnicode::is_ascii(str.data(), str.size())) {
+        lower(str.data(), str.size());
+        return;
+    }
+    str = GiUnicode::lower(str);
+}
+
+/**
+ * @brief Converts all ASCII letters of a fixed buffer to lowercase; other bytes are left as they are.
+ *
+ * @throws std::invalid_argument If the buffer is empty.
+ */
+void GiString::inplace::lower(char* data, size_t size) {
+    if (size == 0) {
+        throw std::invalid_argument("Input string is empty (GiString::lower)");
+    }
+    GiStringCore::to_lower(data, size);
+}
+
+/**
+ * @brief Reverses str in place.
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::inplace::reverse(std::string& str) {
+    reverse(str.data(), str.size());
+}
+
+/**
+ * @brief Reverses a fixed buffer.
+ *
+ * @throws std::invalid_argument If the buffer is empty.
+ */
+void GiString::inplace::reverse(char* data, size_t size) {
+    if (size == 0) {
+        throw std::invalid_argument("Input string is empty");
+    }
+    std::reverse(data, data + size);
+}
+
+/**
+ * @brief Replaces the first occurrence of from with to in place.
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::inplace::replace_first(std::string& str, const std::string& from, const std::string& to) {
+    if (str.empty()) {
+        throw std::invalid_argument("Input string is empty (GiString::replace_first)");
+    }
+    size_t pos = str.find(from);
+    if (pos != std::string::npos) {
+        str.replace(pos, from.length(), to);
+    }
+}
+
+/**
+ * @brief Replaces the last occurrence of from with to in place.
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::inplace::replace_last(std::string& str, const std::string& from, const std::string& to) {
+    if (str.empty()) {
+        throw std::invalid_argument("Input string is empty (GiString::replace_last)");
+    }
+    size_t pos = str.rfind(from);
+    if (pos != std::string::npos) {
+        str.replace(pos, from.length(), to);
+    }
+}
+
+/**
+ * @brief Erases the last occurrence of ch from str.
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::inplace::remove_last(std::string& str, const std::string& ch) {
+    if (str.empty()) {
+        throw std::invalid_argument("remove_last: Input string is empty.");
+    }
+    size_t found = str.rfind(ch);
+    if (found != std::string::npos) {
+        str.erase(found, ch.length());
+    }
+}
+
+/**
+ * @brief Appends suffix to str unless it already ends with it.
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::inplace::ensure_suffix(std::string& str, const std::string& suffix) {
+    if (str.empty()) {
+        throw std::invalid_argument("ensure_suffix: Input string is empty.");
+    }
+    if (str.size() < suffix.size() || str.compare(str.size() - suffix.size(), suffix.size(), suffix) != 0) {
+        str += suffix;
+    }
+}
+
+/**
+ * @brief Collapses runs of identical characters to a single character in place.
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::inplace::squeeze(std::string& str) {
+    if (str.empty()) {
+        throw std::invalid_argument("Input string is empty (GiString::squeeze)");
+    }
+    str.erase(std::unique(str.begin(), str.end()), str.end());
+}
+
+/**
+ * @brief Applies ROT13 to str in place (the cipher is its own inverse).
+ */
+void GiString::inplace::rot13(std::string& str) {
+    rot13(str.data(), str.size());
+}
+
+/**
+ * @brief Applies ROT13 to a fixed buffer.
+ */
+void GiString::inplace::rot13(char* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        char ch = data[i];
+        if (ch >= 'A' && ch <= 'Z') {
+            data[i] = static_cast<char>((ch - 'A' + 13) % 26 + 'A');
+        } else if (ch >= 'a' && ch <= 'z') {
+            data[i] = static_cast<char>((ch - 'a' + 13) % 26 + 'a');
+        }
+    }
+}
+
+/**
+ * @brief XORs str with a repeating key in place.
+ *
+ * @throws std::invalid_argument If the key is empty and the input is not.
+ */
+void GiString::inplace::xor_cipher(std::string& str, const std::string& key) {
+    xor_cipher(str.data(), str.size(), key);
+}
+
+/**
+ * @brief XORs a fixed buffer with a repeating key.
+ *
+ * @throws std::invalid_argument If the key is empty and the buffer is not.
+ */
+void GiString::inplace::xor_cipher(char* data, size_t size, const std::string& key) {
+    if (size == 0) {
+        return;
+    }
+    if (key.empty()) {
+        throw std::invalid_argument("Key is empty (GiString::xor_cipher)");
+    }
+    for (size_t i = 0, k = 0; i < size; ++i) {
+        data[i] ^= key[k];
+        if (++k == key.size()) {
+            k = 0;
+        }
+    }
+}
+
+/**
+ * @brief Replaces every character from sensitiveChars with maskChar in place.
+ *
+ * @throws std::invalid_argument If the input string or the list of sensitive characters is empty.
+ */
+void GiString::inplace::mask_sensitive(std::string& str, const std::string& sensitiveChars, char maskChar) {
+    mask_sensitive(str.data(), str.size(), sensitiveChars, maskChar);
+}
+
+/**
+ * @brief Replaces every character from sensitiveChars with maskChar in a fixed buffer.
+ *
+ * @throws std::invalid_argument If the buffer or the list of sensitive characters is empty.
+ */
+void GiString::inplace::mask_sensitive(char* data, size_t size, const std::string& sensitiveChars, char maskChar) {
+    if (size == 0) {
+        throw std::invalid_argument("Input string is empty (GiString::mask_sensitive)");
+    }
+    if (sensitiveChars.empty()) {
+        throw std::invalid_argument("List of sensitive characters is empty (GiString::mask_sensitive)");
+    }
+
+    bool sensitive[256] = {};
+    for (char c : sensitiveChars) {
+        sensitive[static_cast<unsigned char>(c)] = true;
+    }
+    for (size_t i = 0; i < size; ++i) {
+        if (sensitive[static_cast<unsigned char>(data[i])]) {
+            data[i] = maskChar;
+        }
+    }
+}
+
+/**
+ * @brief Overwrites length characters starting at start with mask.
+ *
+ * @throws std::invalid_argument If the start index is out of range or the length is invalid.
+ */
+void GiString::inplace::anonymize(std::string& str, size_t start, size_t length, char mask) {
+    if (start >= str.length() || length == 0 || start + length > str.length()) {
+        throw std::invalid_argument("Invalid start index or length for anonymization. GiString::anonymize");
+    }
+    std::fill_n(str.begin() + start, length, mask);
+}
+
+/**
+ * @brief Overwrites the characters at the given positions with mask; out-of-range positions are ignored.
+ *
+ * @throws std::invalid_argument If the input string is empty.
+ */
+void GiString::inplace::mask_characters(std::string& input, char mask, const std::vector<int>& positions) {
+    if (input.empty()) {
+        throw std::invalid_argument("GiString::mask_characters: Input string is empty.");
+    }
+    for (int pos : positions) {
+        if (pos >= 0 && pos < static_cast<int>(input.size())) {
+            input[pos] = mask;
+        }
+    }
+}
+
+/**
+ * @brief Replaces everything but the last four characters with twelve asterisks.
+ *
+ * @throws std::invalid_argument If the input has fewer than four characters.
+ */
+void GiString::inplace::mask_credit_card(std::string& creditCardNumber) {
+    if (creditCardNumber.size() < 4) {
+        throw std::invalid_argument("mask_credit_card: Error - Input credit card number is empty or has less than four digits.");
+    }
+    creditCardNumber.replace(0, creditCardNumber.size() - 4, 12, '*');
+}
+
+/**
+ * @brief Masks alphanumeric characters of str whose mask digit is '1', cycling through mask.
+ *
+ * @throws std::invalid_argument If the input string or mask is empty.
+ */
+void GiString::inplace::apply_mask(std::string& str, const std::string& mask) {
+    apply_mask(str.data(), str.size(), mask);
+}
+
+/**
+ * @brief Masks alphanumeric characters of a fixed buffer whose mask digit is '1', cycling through mask.
+ *
+ * @throws std::invalid_argument If the buffer or mask is empty.
+ */
+void GiString::inplace::apply_mask(char* data, size_t size, const std::string& mask) {
+    if (size == 0 || mask.empty()) {
+        throw std::invalid_argument("apply_mask: Input string or mask is empty.");
+    }
+    size_t maskIndex = 0;
+    for (size_t i = 0; i < size; ++i) {
+        if (std::isalnum(static_cast<unsigned char>(data[i]))) {
+            if (mask[maskIndex] == '1') {
+                data[i] = '*';
+            }
+            maskIndex = (maskIndex + 1) % mask.length();
+        }
+    }
+}
+
+std::string GiString::inplace::trim(std::string&& str) {
+    trim(str);
+    return std::move(str);
+}
+
+std::string GiString::inplace::upper(std::string&& str) {
+    upper(str);
+    return std::move(str);
+}
+
+std::string GiString::inplace::lower(std::string&& str) {
+    lower(str);
+    return std::move(str);
+}
+
+std::string GiString::inplace::reverse(std::string&& str) {
+    reverse(str);
+    return std::move(str);
+}
+
+std::string GiString::inplace::replace_first(std::string&& str, const std::string& from, const std::string& to) {
+    replace_first(str, from, to);
+    return std::move(str);
+}
+
+std::string GiString::inplace::replace_last(std::string&& str, const std::string& from, const std::string& to) {
+    replace_last(str, from, to);
+    return std::move(str);
+}
+
+std::string GiString::inplace::remove_last(std::string&& str, const std::string& ch) {
+    remove_last(str, ch);
+    return std::move(str);
+}
+
+std::string GiString::inplace::ensure_suffix(std::string&& str, const std::string& suffix) {
+    ensure_suffix(str, suffix);
+    return std::move(str);
+}
+
+std::string GiString::inplace::squeeze(std::string&& str) {
+    squeeze(str);
+    return std::move(str);
+}
+
+std::string GiString::inplace::rot13(std::string&& str) {
+    rot13(str);
+    return std::move(str);
+}
+
+std::string GiString::inplace::xor_cipher(std::string&& str, const std::string& key) {
+    xor_cipher(str, key);
+    return std::move(str);
+}
+
+std::string GiString::inplace::mask_sensitive(std::string&& str, const std::string& sensitiveChars, char maskChar) {
+    mask_sensitive(str, sensitiveChars, maskChar);
+    return std::move(str);
+}
+
+std::string GiString::inplace::anonymize(std::string&& str, size_t start, size_t length, char mask) {
+    anonymize(str, start, length, mask);
+    return std::move(str);
+}
+
+std::string GiString::inplace::mask_characters(std::string&& input, char mask, const std::vector<int>& positions) {
+    mask_characters(input, mask, positions);
+    return std::move(input);
+}
+
+std::string GiString::inplace::mask_credit_card(std::string&& creditCardNumber) {
+    mask_credit_card(creditCardNumber);
+    return std::move(creditCardNumber);
+}
+
+std::string GiString::inplace::apply_mask(std::string&& str, const std::string& mask) {
+    apply_mask(str, mask);
+    return std::move(str);
+}
+
+// Example usage:
+// std::string record = "  Jan Kowalski, 4111111111111111  ";
+// GiString::inplace::trim(record);
+// GiString::inplace::upper(record);
+// std::string cleaned = GiString::inplace::replace_first(std::move(record), ",", ";");
+// std::cout << cleaned << std::endl;
+// Output: "JAN KOWALSKI; 4111111111111111"
+
+
+
+/**
+ * @brief Inserts a substring into a rope at the specified position in O(log n).
+ *
+ * @param rope The input rope; it is not modified.
+ * @param pos The position at which to insert the substring.
+ * @param sub The substring to insert.
+ * @return The edited rope, sharing unchanged chunks with the input.
+ *
+ * @throws std::out_of_range If the position is out of range.
+ */
+GiRope GiString::insert(const GiRope& rope, size_t pos, const std::string& sub) {
+    if (pos > rope.size()) {
+        throw std::out_of_range("Position is out of range (GiString::insert)");
+    }
+    GiRope result = rope;
+    result.insert(pos, sub);
+    return result;
+}
+
+/**
+ * @brief Inserts a string into a rope at the specified position in O(log n).
+ *
+ * @param rope The input rope; it is not modified.
+ * @param position The position at which to insert.
+ * @param insertion The string to insert.
+ * @return The edited rope, sharing unchanged chunks with the input.
+ *
+ * @throws std::out_of_range If the position is out of range.
+ */
+GiRope GiString::insert_at(const GiRope& rope, size_t position, const std::string& insertion) {
+    if (position > rope.size()) {
+        throw std::out_of_range("Position is out of range (GiString::insert_at)");
+    }
+    GiRope result = rope;
+    result.insert(position, insertion);
+    return result;
+}
+
+/**
+ * @brief Inserts str into the rope at index unless it already occurs somewhere in it.
+ *
+ * @param data The rope to modify.
+ * @param index The position at which to insert.
+ * @param str The string to insert.
+ * @return True if the string was inserted, false if it was already present.
+ *
+ * @throws std::out_of_range If the index is out of range.
+ */
+bool GiString::insert_if_absent(GiRope& data, size_t index, const std::string& str) {
+    if (index > data.size()) {
+        throw std::out_of_range("Index out of range in insert_if_absent function");
+    }
+    if (data.find(str) != GiRope::npos) {
+        return false;
+    }
+    data.insert(index, str);
+    return true;
+}
+
+/**
+ * @brief Inserts a string after every n characters of a rope.
+ *
+ * The result is assembled from slices of the input, so the input's chunks are shared
+ * rather than copied.
+ *
+ * @param rope The input rope.
+ * @param insert The string to insert.
+ * @param n The interval, in characters.
+ * @return The rope with the string inserted after every n characters.
+ *
+ * @throws std::invalid_argument If the rope is empty or n is not positive.
+ */
+GiRope GiString::insert_every_n(const GiRope& rope, const std::string& insert, int n) {
+    if (rope.empty()) {
+        throw std::invalid_argument("GiString::insert_every_n: Input string is empty.");
+    }
+    if (n <= 0) {
+        throw std::invalid_argument("GiString::insert_every_n: Interval must be greater than 0.");
+    }
+
+    GiRope separator(insert);
+    GiRope result;
+    size_t step = static_cast<size_t>(n);
+    size_t pos = 0;
+    for (; pos + step <= rope.size(); pos += step) {
+        result.append(rope.substr(pos, step));
+        result.append(separator);
+    }
+    result.append(rope.substr(pos));
+    return result;
+}
+
+/**
+ * @brief Prefixes each line of a rope, using the cached line offsets.
+ *
+ * Produces the same text as prefix_lines(const std::string&, ...): every line gets the
+ * prefix and ends with a newline.
+ *
+ * @param rope The input rope.
+ * @param prefix The prefix to add to each line.
+ * @return The rope with every line prefixed.
+ *
+ * @throws std::invalid_argument If the rope is empty.
+ */
+GiRope GiString::prefix_lines(const GiRope& rope, const std::string& prefix) {
+    if (rope.empty()) {
+        throw std::invalid_argument("prefix_lines: Error caused by empty input string");
+    }
+
+    GiRope head(prefix);
+    GiRope result;
+    size_t lines = rope.line_count();
+    for (size_t line = 0; line < lines; ++line) {
+        size_t start = rope.line_offset(line);
+        size_t end = line + 1 < lines ? rope.line_offset(line + 1) : rope.size();
+        result.append(head);
+        result.append(rope.substr(start, end - start));
+    }
+    if (rope[rope.size() - 1] != '\n') {
+        result.append("\n");
+    }
+    return result;
+}
+
+// Example usage:
+// GiString gs;
+// GiRope source("int x;\nint y;\n");
+// for (int i = 0; i < 1000; ++i) {
+//     source = gs.insert(source, source.line_offset(1), "// generated\n");
+// }
+// GiRope quoted = gs.prefix_lines(source, "> ");
+// std::cout << quoted.line_count() << std::endl;
+// Output: "1002"
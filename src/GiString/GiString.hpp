@@ -22,9 +22,58 @@
 #include <unordered_set>
 #include <fstream>
 #include <chrono>
+#include <array>
+#include <string_view>
+#include <iterator>
+#include <cstring>
+#include <thread>
+#include <tuple>
+#include <cstdint>
+#include <memory_resource>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <list>
+#include <climits>
+#include "GiStringCore.hpp"
+#include "GiStringResult.hpp"
+#include "../GiRope/GiRope.hpp"
+#include "../GiExecutor/GiExecutor.hpp"
 class GiString
 {
 public:
+    class Reflow;
+    class Pipeline;
+    class NGramRange;
+    class MinHash;
+    class TextStats;
+    struct views;
+    struct inplace;
+    struct FixedBuffer;
+    class Appender;
+    class Arena;
+    class Interner;
+    class Batch;
+    class Inflector;
+    template <bool Multi>
+    class BasicSortedStrings;
+    using SortedStringSet = BasicSortedStrings<false>;
+    using SortedStringMultiset = BasicSortedStrings<true>;
+    template <typename Offset>
+    class BasicStringColumn;
+    using StringColumn = BasicStringColumn<uint32_t>;
+    using LargeStringColumn = BasicStringColumn<uint64_t>;
+    using CaseStyle = GiStringCore::case_style;
+
+    struct WhitespaceOptions
+    {
+        std::string whitespace = " \t\n\r\f\v"; // Bytes treated as whitespace
+        bool collapse = true;                     // Replace each run with a single replacement byte
+        bool trim = false;                        // Drop runs at both ends of the input
+        bool keep_newlines = false;               // Runs containing newlines collapse to those newlines
+        char replacement = ' ';
+    };
+
     std::string capitalize(const std::string &str);
     std::string capitalizeWords(const std::string &str);
     std::string swapcase(const std::string &str);
@@ -56,7 +105,7 @@ public:
     size_t rfind(const std::string &str, const std::string &sub);
     bool contains(const std::string &str, const std::string &sub);
     bool equals_ignore_case(const std::string &str1, const std::string &str2);
-    std::string insert(std::string str, size_t pos, const std::string &sub);
+    std::string insert(const std::string &str, size_t pos, const std::string &sub);
     std::string remove(const std::string &str, const std::string &sub);
     char pop(std::string &str);
     void push_back(std::string &str, char ch);
@@ -70,7 +119,7 @@ public:
     bool all_of(const std::string &str, std::function<bool(char)> predicate);
     bool none_of(const std::string &str, std::function<bool(char)> predicate);
     std::string slice(const std::string &str, size_t start, size_t end);
-    std::string ascii_only(std::string str);
+    std::string ascii_only(const std::string &str);
     int to_int(const std::string &str);
     float to_float(const std::string &str);
     std::string indent(const std::string &str, int count);
@@ -153,14 +202,14 @@ public:
     std::string substring_between(const std::string &str, const std::string &startDelim, const std::string &endDelim);
     std::string concat(std::initializer_list<std::string> strings);
     int nth_occurrence(const std::string &str, const std::string &target, int n);
-    std::string chop(std::string str);
-    std::string ensure_prefix(std::string str, const std::string &prefix);
-    std::string ensure_suffix(std::string str, const std::string &suffix);
+    std::string chop(const std::string &str);
+    std::string ensure_prefix(const std::string &str, const std::string &prefix);
+    std::string ensure_suffix(const std::string &str, const std::string &suffix);
     std::string remove_last(std::string str, const std::string &ch);
     bool is_sorted(const std::string &str);
     std::string unique(std::string str);
     std::vector<std::string> split_lines(const std::string &str);
-    std::pair<std::string, std::string> split_at(std::string str, size_t index);
+    std::pair<std::string, std::string> split_at(const std::string &str, size_t index);
     std::vector<std::string> partition(const std::string &str, const std::string &separator);
     std::tuple<std::string, std::string, std::string> rpartition(const std::string &str, const std::string &delimiter);
     int count_lines(const std::string &input);
@@ -222,6 +271,8 @@ public:
     std::string from_kebab_case(const std::string &kebabCaseStr);
     std::string to_pascal_case(const std::string &str);
     std::string from_pascal_case(const std::string &str);
+    std::string convert_case_style(const std::string &str, CaseStyle style);
+    bool parse_case_style(const std::string &name, CaseStyle &style);
     std::string randomize_case(const std::string &str);
     std::string singularize(const std::string &pluralWord);
     std::string capitalize_each_word(const std::string &str);
@@ -267,7 +318,7 @@ public:
     std::string lexicographically_previous(const std::string &str);
     std::string adjust_whitespace(const std::string &input);
     std::string generate_identifier(const std::string &data);
-    int count_substring(std::string str, const std::string &substring);
+    int count_substring(const std::string &str, const std::string &substring);
     std::string replace_substring(std::string str, const std::string &oldSubstr, const std::string &newSubstr);
     int visible_length(const std::string &str);
     std::string to_spongebob_mocking(const std::string &input);
@@ -296,4 +347,938 @@ public:
     int calculate_reading_time(const std::string &text);
     std::string unswap_pairs(const std::string &str);
     std::string apply_mask(const std::string &str, const std::string &mask);
+    std::string clean_whitespace(const std::string &str, const WhitespaceOptions &options);
+    void clean_whitespace(const char *data, size_t size, const WhitespaceOptions &options, std::string &output);
+    NGramRange ngrams(std::string_view text, size_t n);
+    NGramRange word_ngrams(std::string_view text, size_t n);
+    std::vector<uint64_t> ngram_fingerprints(std::string_view text, size_t n, bool words = false);
+    uint64_t simhash(std::string_view text, size_t n, bool words = false);
+    int simhash_distance(uint64_t a, uint64_t b);
+    TextStats text_stats(const std::string &text, bool vocabulary = false);
+    TextStats text_stats(std::istream &in, bool vocabulary = false, size_t chunk_size = 1 << 20);
+    TextStats text_stats_parallel(const std::string &text, size_t threads = 0, bool vocabulary = false);
+    size_t count_parallel(const std::string &str, const std::string &sub, size_t threshold = 1 << 20, GiExecutor &executor = GiExecutor::shared());
+    std::string replace_parallel(const std::string &str, const std::string &old_sub, const std::string &new_sub, size_t threshold = 1 << 20, GiExecutor &executor = GiExecutor::shared());
+    std::string upper_parallel(const std::string &str, size_t threshold = 1 << 20, GiExecutor &executor = GiExecutor::shared());
+    std::string lower_parallel(const std::string &str, size_t threshold = 1 << 20, GiExecutor &executor = GiExecutor::shared());
+    std::string to_hex_parallel(const std::string &str, size_t threshold = 1 << 20, GiExecutor &executor = GiExecutor::shared());
+    std::string base64_encode_parallel(const std::string &str, size_t threshold = 1 << 20, GiExecutor &executor = GiExecutor::shared());
+    std::vector<size_t> find_all_patterns_parallel(const std::string &pattern, const std::string &text, size_t threshold = 1 << 20, GiExecutor &executor = GiExecutor::shared());
+    void capitalize(const std::string &str, Appender out);
+    void capitalizeWords(const std::string &str, Appender out);
+    void swapcase(const std::string &str, Appender out);
+    void upper(const std::string &str, Appender out);
+    void lower(const std::string &str, Appender out);
+    void convert_case_style(const std::string &str, CaseStyle style, Appender out);
+    void trim_left(const std::string &str, Appender out);
+    void trim_right(const std::string &str, Appender out);
+    void trim(const std::string &str, Appender out);
+    void ltrim(const std::string &str, Appender out);
+    void rtrim(const std::string &str, Appender out);
+    void center(const std::string &str, size_t width, char fill, Appender out);
+    void ljust(const std::string &str, size_t width, char fillchar, Appender out);
+    void rjust(const std::string &str, size_t width, char fillchar, Appender out);
+    void zfill(const std::string &str, size_t width, Appender out);
+    void xml_escape(const std::string &input, Appender out);
+    void escape_regex(const std::string &input, Appender out);
+    void quote_for_shell(const std::string &input, Appender out);
+    void url_encode(const std::string &str, Appender out);
+    void base64_encode(const std::string &str, Appender out);
+    void to_hex(const std::string &str, Appender out);
+    void replace(const std::string &str, const std::string &old_sub, const std::string &new_sub, Appender out);
+    void replace_first(const std::string &str, const std::string &from, const std::string &to, Appender out);
+    void replace_last(const std::string &str, const std::string &from, const std::string &to, Appender out);
+    std::pmr::vector<std::pmr::string> split(const std::string &str, char delimiter, std::pmr::memory_resource *resource);
+    int levenshtein_distance(const std::string &s1, const std::string &s2, std::pmr::memory_resource *resource);
+    std::pmr::string dedent(const std::string &str, std::pmr::memory_resource *resource);
+    std::pmr::string auto_indent(const std::string &str, std::pmr::memory_resource *resource);
+    GiRope insert(const GiRope &rope, size_t pos, const std::string &sub);
+    GiRope insert_at(const GiRope &rope, size_t position, const std::string &insertion);
+    bool insert_if_absent(GiRope &data, size_t index, const std::string &str);
+    GiRope insert_every_n(const GiRope &rope, const std::string &insert, int n);
+    GiRope prefix_lines(const GiRope &rope, const std::string &prefix);
+    Batch batch(GiExecutor &executor = GiExecutor::shared(), size_t grain = 64);
+};
+
+/**
+ * @brief Reduces a string to a single value using a given binary function.
+ *
+ * Defined in the header so callers can instantiate it for their own result types.
+ *
+ * @param str The input string to reduce.
+ * @param init The initial value for the reduction.
+ * @param binary_func The binary function to apply to each character.
+ * @return The result of the reduction.
+ */
+template <typename T>
+T GiString::reduce(const std::string &str, T init, std::function<T(T, char)> binary_func)
+{
+    T result = init;
+    for (char c : str)
+    {
+        result = binary_func(result, c);
+    }
+    return result;
+}
+
+// Example usage:
+// GiString* gs = new GiString();
+// std::string str = "hello";
+// int result_length = gs->reduce<int>(str, 0, [](int acc, char c) { return acc + 1; });
+// std::cout << "Length of the string: " << result_length << std::endl;
+
+/**
+ * @brief Caller-owned, fixed-capacity output buffer.
+ *
+ * Writes never allocate and never go past capacity; required keeps counting the full
+ * output size, so after a truncated write the caller knows how large a buffer to retry
+ * with. The buffer is not NUL-terminated.
+ */
+struct GiString::FixedBuffer
+{
+    FixedBuffer(char *data, size_t capacity) : data(data), capacity(capacity) {}
+
+    size_t size() const { return required < capacity ? required : capacity; }
+    bool truncated() const { return required > capacity; }
+    void clear() { required = 0; }
+
+    char *data;
+    size_t capacity;
+    size_t required = 0;
+};
+
+/**
+ * @brief Output sink taken by the buffer overloads of the transforming functions.
+ *
+ * Converts implicitly from a std::string or std::pmr::string, which the result is
+ * appended to so its capacity is reused across calls, or from a FixedBuffer. The output
+ * must not refer to any of the function's input strings.
+ */
+class GiString::Appender
+{
+public:
+    Appender(std::string &output) : string_(&output) {}
+    Appender(std::pmr::string &output) : pmr_string_(&output) {}
+    Appender(FixedBuffer &buffer) : buffer_(&buffer) {}
+
+    void reserve(size_t extra)
+    {
+        if (string_) {
+            grow(*string_, extra);
+        } else if (pmr_string_) {
+            grow(*pmr_string_, extra);
+        }
+    }
+
+    void push_back(char c)
+    {
+        if (string_) {
+            string_->push_back(c);
+        } else if (pmr_string_) {
+            pmr_string_->push_back(c);
+        } else {
+            if (buffer_->required < buffer_->capacity) {
+                buffer_->data[buffer_->required] = c;
+            }
+            ++buffer_->required;
+        }
+    }
+
+    void append(const char *data, size_t size)
+    {
+        if (string_) {
+            string_->append(data, size);
+        } else if (pmr_string_) {
+            pmr_string_->append(data, size);
+        } else {
+            copy_to_buffer(size, [&](char *dest, size_t n) { std::memcpy(dest, data, n); });
+        }
+    }
+
+    void append(size_t count, char c)
+    {
+        if (string_) {
+            string_->append(count, c);
+        } else if (pmr_string_) {
+            pmr_string_->append(count, c);
+        } else {
+            copy_to_buffer(count, [&](char *dest, size_t n) { std::memset(dest, c, n); });
+        }
+    }
+
+    void append(std::string_view str) { append(str.data(), str.size()); }
+
+private:
+    // Grows geometrically: reserve() allocates exactly on some implementations, so reserving
+    // size() + extra on every call would make a run of small appends quadratic
+    template <typename String>
+    static void grow(String &str, size_t extra)
+    {
+        size_t needed = str.size() + extra;
+        if (needed > str.capacity()) {
+            size_t doubled = 2 * str.capacity();
+            str.reserve(needed > doubled ? needed : doubled);
+        }
+    }
+
+    template <typename Fill>
+    void copy_to_buffer(size_t size, const Fill &fill)
+    {
+        if (buffer_->required < buffer_->capacity) {
+            size_t room = buffer_->capacity - buffer_->required;
+            fill(buffer_->data + buffer_->required, size < room ? size : room);
+        }
+        buffer_->required += size;
+    }
+
+    std::string *string_ = nullptr;
+    std::pmr::string *pmr_string_ = nullptr;
+    FixedBuffer *buffer_ = nullptr;
+};
+
+/**
+ * @brief Bump-pointer memory resource for per-request string work.
+ *
+ * Allocations are carved sequentially out of blocks obtained from the upstream resource;
+ * deallocation is a no-op and reset() rewinds to the first block while keeping every
+ * block, so after warm-up a request that fits in the retained blocks never touches the
+ * upstream allocator. Everything allocated from the arena is invalidated by reset().
+ */
+class GiString::Arena : public std::pmr::memory_resource
+{
+public:
+    explicit Arena(size_t block_size = 64 * 1024, std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+    ~Arena() override;
+
+    void reset();
+    size_t bytes_used() const;
+    size_t bytes_reserved() const;
+
+private:
+    struct Block
+    {
+        Block *next;
+        size_t size;
+    };
+
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+    void *carve(Block *block, size_t bytes, size_t alignment);
+
+    size_t block_size_;
+    std::pmr::memory_resource *upstream_;
+    Block *head_ = nullptr;
+    Block *current_ = nullptr;
+    size_t offset_ = 0;
+    size_t used_ = 0;
+};
+
+/**
+ * @brief Thread-safe string interner mapping each distinct string to a stable 32-bit id.
+ *
+ * Bytes are copied once into per-shard arena pages and never move, so the string_view
+ * returned by view() stays valid for the interner's lifetime. Lookups (find, view) take no
+ * locks; inserting a new string locks only the shard its hash falls into. Ids are dense,
+ * assigned in insertion order starting at 0, so they can index side tables directly.
+ */
+class GiString::Interner
+{
+public:
+    using id_type = uint32_t;
+    static constexpr id_type npos = static_cast<id_type>(-1);
+
+    explicit Interner(size_t page_size = 64 * 1024);
+    Interner(const Interner &) = delete;
+    Interner &operator=(const Interner &) = delete;
+    ~Interner();
+
+    id_type intern(std::string_view str);
+    id_type find(std::string_view str) const;
+    std::string_view view(id_type id) const;
+    std::string_view operator[](id_type id) const { return view(id); }
+    size_t size() const;
+    size_t bytes_used() const;
+
+    std::vector<id_type> intern_all(const std::vector<std::string> &strings);
+    std::vector<id_type> intern_all(const std::vector<std::string_view> &strings);
+    void intern_all(const std::string_view *strings, size_t count, id_type *ids);
+
+private:
+    static const size_t shard_count = 16;
+    static const size_t first_chunk = 1024;
+    static const size_t max_chunks = 23;
+
+    struct Entry
+    {
+        const char *data;
+        size_t size;
+    };
+
+    // Open-addressing slots: upper half is the string hash, lower half id + 1 (0 = empty).
+    struct Table
+    {
+        explicit Table(size_t capacity) : mask(capacity - 1), slots(new std::atomic<uint64_t>[capacity]()) {}
+
+        size_t mask;
+        std::unique_ptr<std::atomic<uint64_t>[]> slots;
+    };
+
+    struct alignas(64) Shard
+    {
+        explicit Shard(size_t page_size) : arena(page_size) {}
+
+        mutable std::mutex mutex;
+        std::atomic<Table *> table{nullptr};
+        std::vector<std::unique_ptr<Table>> tables;
+        size_t count = 0;
+        Arena arena;
+    };
+
+    static uint64_t hash(std::string_view str);
+    static size_t chunk_of(id_type id, size_t &offset);
+    id_type lookup(const Shard &shard, std::string_view str, uint64_t hash) const;
+    id_type insert_locked(Shard &shard, std::string_view str, uint64_t hash);
+    void grow_locked(Shard &shard);
+    const Entry &entry(id_type id) const;
+
+    std::unique_ptr<Shard> shards_[shard_count];
+    mutable std::atomic<Entry *> chunks_[max_chunks];
+    std::atomic<id_type> next_id_{0};   // Next id to hand out
+    std::atomic<id_type> committed_{0}; // Ids below this have their entries written
+};
+
+/**
+ * @brief Applies GiString functions to whole vectors of strings on a GiExecutor.
+ *
+ * The input is split into chunks of at least grain strings which idle threads steal from
+ * each other, and every result is written to its own preallocated output slot. Output
+ * vectors are resized to the input size; existing output strings keep their capacity.
+ * Predicate results are stored as char (0 or 1) because std::vector<bool> elements cannot
+ * be written from different threads.
+ */
+class GiString::Batch
+{
+public:
+    Batch(GiString &owner, GiExecutor &executor, size_t grain) : owner_(&owner), executor_(&executor), grain_(grain) {}
+
+    template <typename Result, typename Function>
+    void map(const std::string *input, size_t count, Result *output, Function function);
+
+    void upper(const std::vector<std::string> &input, std::vector<std::string> &output);
+    void lower(const std::vector<std::string> &input, std::vector<std::string> &output);
+    void trim(const std::vector<std::string> &input, std::vector<std::string> &output);
+    void capitalize(const std::vector<std::string> &input, std::vector<std::string> &output);
+    void swapcase(const std::vector<std::string> &input, std::vector<std::string> &output);
+    void reverse(const std::vector<std::string> &input, std::vector<std::string> &output);
+    void xml_escape(const std::vector<std::string> &input, std::vector<std::string> &output);
+    void url_encode(const std::vector<std::string> &input, std::vector<std::string> &output);
+    void base64_encode(const std::vector<std::string> &input, std::vector<std::string> &output);
+    void replace(const std::vector<std::string> &input, const std::string &old_sub, const std::string &new_sub, std::vector<std::string> &output);
+    void convert_case_style(const std::vector<std::string> &input, CaseStyle style, std::vector<std::string> &output);
+    std::vector<std::string> convert_case_style(const std::vector<std::string> &input, CaseStyle style);
+    std::vector<std::string> upper(const std::vector<std::string> &input);
+    std::vector<std::string> lower(const std::vector<std::string> &input);
+    std::vector<std::string> trim(const std::vector<std::string> &input);
+
+    std::vector<char> is_numeric(const std::vector<std::string> &input);
+    std::vector<char> is_alpha(const std::vector<std::string> &input);
+    std::vector<char> is_alphanumeric(const std::vector<std::string> &input);
+    std::vector<char> is_ascii(const std::vector<std::string> &input);
+    std::vector<char> is_valid_email(const std::vector<std::string> &input);
+    std::vector<char> contains(const std::vector<std::string> &input, const std::string &sub);
+    std::vector<char> startswith(const std::vector<std::string> &input, const std::string &prefix);
+    std::vector<char> endswith(const std::vector<std::string> &input, const std::string &suffix);
+    std::vector<size_t> count(const std::vector<std::string> &input, const std::string &sub);
+    std::vector<int> levenshtein_distance(const std::vector<std::string> &input, const std::string &target);
+    std::vector<std::vector<size_t>> group_anagrams(const std::vector<std::string> &input);
+
+private:
+    template <typename Result, typename Function>
+    std::vector<Result> map_all(const std::vector<std::string> &input, Function function)
+    {
+        std::vector<Result> output(input.size());
+        map(input.data(), input.size(), output.data(), function);
+        return output;
+    }
+
+    GiString *owner_;
+    GiExecutor *executor_;
+    size_t grain_;
+};
+
+/**
+ * @brief Calls function(input[i], output[i]) for every i, spread over the executor.
+ *
+ * Defined in the header so callers can batch their own functions; function must be safe
+ * to call concurrently on different elements.
+ */
+template <typename Result, typename Function>
+void GiString::Batch::map(const std::string *input, size_t count, Result *output, Function function)
+{
+    executor_->parallel_for(0, count, grain_, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            function(input[i], output[i]);
+        }
+    });
+}
+
+/**
+ * @brief Arrow-style column of nullable strings.
+ *
+ * All row bytes live in one contiguous buffer; row i spans [offsets[i], offsets[i + 1]).
+ * Null rows are recorded in an LSB-first validity bitmap, which stays empty while the
+ * column has no nulls. Kernels walk the buffers sequentially and never allocate per row.
+ * Null rows are empty, test false and hash to 0. StringColumn uses 32-bit offsets (up to
+ * 4 GiB of bytes), LargeStringColumn 64-bit ones.
+ */
+template <typename Offset>
+class GiString::BasicStringColumn
+{
+public:
+    BasicStringColumn();
+    explicit BasicStringColumn(const std::vector<std::string> &strings);
+
+    void reserve(size_t rows, size_t bytes);
+    void push_back(std::string_view str);
+    void push_null();
+    void clear();
+
+    size_t size() const { return offsets_.size() - 1; }
+    bool empty() const { return size() == 0; }
+    size_t null_count() const { return null_count_; }
+    bool is_null(size_t row) const { return !validity_.empty() && !(validity_[row / 8] & (1u << (row % 8))); }
+    std::string_view operator[](size_t row) const { return std::string_view(data_.data() + offsets_[row], offsets_[row + 1] - offsets_[row]); }
+    std::string_view at(size_t row) const;
+
+    const std::vector<char> &data() const { return data_; }
+    const std::vector<Offset> &offsets() const { return offsets_; }
+    const std::vector<uint8_t> &validity() const { return validity_; }
+
+    BasicStringColumn upper() const;
+    BasicStringColumn lower() const;
+    BasicStringColumn trim() const;
+
+    std::vector<char> is_numeric() const;
+    std::vector<char> is_alpha() const;
+    std::vector<char> is_alphanumeric() const;
+    std::vector<char> is_ascii() const;
+    std::vector<char> startswith(std::string_view prefix) const;
+    std::vector<char> endswith(std::string_view suffix) const;
+    std::vector<char> contains(std::string_view sub) const;
+    std::vector<uint64_t> hash() const;
+    std::vector<int> levenshtein_distance(std::string_view target) const;
+
+    void serialize(std::string &output) const;
+    static BasicStringColumn deserialize(std::string_view buffer);
+
+private:
+    template <typename Predicate>
+    std::vector<char> test(Predicate predicate) const;
+    BasicStringColumn with_data(std::vector<char> data, std::vector<Offset> offsets) const;
+
+    std::vector<char> data_;
+    std::vector<Offset> offsets_;
+    std::vector<uint8_t> validity_;
+    size_t null_count_ = 0;
+};
+
+/**
+ * @brief English noun inflection for identifiers and entity names.
+ *
+ * Irregular ("person"/"people") and uncountable ("metadata") words are looked up in a
+ * perfect hash built once for the whole process; everything else goes through suffix
+ * rules compiled into a trie over reversed suffixes, so each direction costs O(word
+ * length) and writes nothing but the output. Only the last word of an identifier is
+ * inflected ("SalesPerson" becomes "SalesPeople"); its letters keep their case and added
+ * letters are lowercase, so acronyms become "IDs" and "URLs". With a non-zero
+ * cache_capacity, results are kept in an LRU cache that is safe to share between threads.
+ */
+class GiString::Inflector
+{
+public:
+    explicit Inflector(size_t cache_capacity = 0);
+    ~Inflector();
+    Inflector(Inflector &&other) noexcept;
+    Inflector &operator=(Inflector &&other) noexcept;
+
+    std::string pluralize(std::string_view word);
+    std::string singularize(std::string_view word);
+    void pluralize(std::string_view word, Appender out);
+    void singularize(std::string_view word, Appender out);
+    bool is_uncountable(std::string_view word) const;
+
+    size_t cache_hits() const;
+    size_t cache_misses() const;
+
+private:
+    struct Cache;
+
+    void inflect(std::string_view word, bool plural, Appender out);
+
+    std::unique_ptr<Cache> cache_;
+};
+
+/**
+ * @brief Ordered set (Multi = false) or multiset (Multi = true) of strings.
+ *
+ * A B+-tree whose leaves hold up to 64 keys front-coded against the previous key, so long
+ * runs of shared prefixes (paths, URLs, generated ids) are stored once. insert, erase,
+ * find and lower_bound are O(log n) plus a scan of one leaf. Duplicates in a multiset are
+ * stored once with a count. Iterators walk the linked leaves in order and hold a decoded
+ * copy of the current key; any insert or erase invalidates them.
+ */
+template <bool Multi>
+class GiString::BasicSortedStrings
+{
+    struct Node;
+    struct Leaf;
+    struct Inner;
+
+public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::string;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string *;
+        using reference = const std::string &;
+
+        const_iterator() = default;
+
+        reference operator*() const { return key_; }
+        pointer operator->() const { return &key_; }
+        const_iterator &operator++();
+        const_iterator operator++(int)
+        {
+            const_iterator copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(const const_iterator &other) const { return leaf_ == other.leaf_ && offset_ == other.offset_ && repeat_ == other.repeat_; }
+        bool operator!=(const const_iterator &other) const { return !(*this == other); }
+
+    private:
+        friend class BasicSortedStrings;
+
+        void enter(const Leaf *leaf, size_t offset);
+
+        const Leaf *leaf_ = nullptr;
+        size_t offset_ = 0;          // Start of the current entry in the leaf
+        size_t next_ = 0;            // Start of the following entry
+        size_t repeat_ = 0;          // Copies of key_ still to visit (multiset)
+        std::string key_;
+    };
+    using iterator = const_iterator;
+
+    BasicSortedStrings();
+    explicit BasicSortedStrings(std::vector<std::string> strings);
+    BasicSortedStrings(const BasicSortedStrings &other);
+    BasicSortedStrings(BasicSortedStrings &&other) noexcept;
+    BasicSortedStrings &operator=(const BasicSortedStrings &other);
+    BasicSortedStrings &operator=(BasicSortedStrings &&other) noexcept;
+    ~BasicSortedStrings();
+
+    void assign(std::vector<std::string> strings);
+    bool insert(std::string_view key);
+    bool erase(std::string_view key);
+    void clear();
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    bool contains(std::string_view key) const;
+    size_t count(std::string_view key) const;
+    size_t stored_bytes() const;
+
+    const_iterator begin() const;
+    const_iterator end() const { return const_iterator(); }
+    const_iterator find(std::string_view key) const;
+    const_iterator lower_bound(std::string_view key) const;
+    const_iterator upper_bound(std::string_view key) const;
+    std::pair<const_iterator, const_iterator> range(std::string_view first, std::string_view last) const;
+    std::pair<const_iterator, const_iterator> prefix_range(std::string_view prefix) const;
+    std::vector<std::string> to_vector() const;
+
+private:
+    using Path = std::vector<std::pair<Inner *, size_t>>;
+
+    Leaf *descend(std::string_view key, Path *path) const;
+    const_iterator seek(std::string_view key, bool after) const;
+    void grow(Path &path, std::string separator, std::unique_ptr<Node> right);
+    void merge(Inner &parent, size_t index);
+    static std::string split(Leaf &leaf, Leaf &right);
+    static std::string split(Inner &inner, Inner &right);
+    static std::unique_ptr<Node> clone(const Node &node, Leaf *&last);
+
+    std::unique_ptr<Node> root_;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Streaming word-wrap / justification engine.
+ *
+ * Text is fed in arbitrary chunks and finished lines are written to a sink, so memory use
+ * is bounded by the line width rather than the input size. Widths are measured in display
+ * columns (UTF-8 aware, East Asian wide characters count as two).
+ */
+class GiString::Reflow
+{
+public:
+    enum class Mode
+    {
+        Greedy,
+        Justify
+    };
+    enum class Overflow
+    {
+        Allow,
+        Break,
+        Throw
+    };
+    using Sink = std::function<void(const char *, size_t)>;
+
+    Reflow(size_t width, Mode mode, Sink sink, Overflow overflow = Overflow::Allow);
+    void feed(const char *data, size_t size);
+    void feed(const std::string &chunk);
+    void feed(std::istream &in, size_t chunk_size = 64 * 1024);
+    void finish();
+
+private:
+    void end_word();
+    void place_word(const char *data, size_t size, size_t width);
+    void break_word();
+    void flush_line(bool last);
+
+    size_t width_;
+    Mode mode_;
+    Overflow overflow_;
+    Sink sink_;
+    std::string word_;
+    std::string line_;
+    std::vector<size_t> gaps_;
+    size_t line_width_ = 0;
+    size_t newlines_ = 0;
+    bool paragraph_pending_ = false;
+    bool emitted_ = false;
+};
+
+/**
+ * @brief Builder for chains of byte-local transforms executed in a single fused pass.
+ *
+ * Adjacent stateless stages (case mapping, character removal, custom maps/filters) are
+ * composed into one 256-entry lookup table; stateful stages (whitespace collapsing,
+ * trimming) keep their state across chunks, so the same pipeline runs over in-memory
+ * strings and chunked streams.
+ */
+class GiString::Pipeline
+{
+public:
+    using Sink = std::function<void(const char *, size_t)>;
+
+    struct StageProfile
+    {
+        std::string name;
+        size_t bytes_in = 0;
+        size_t bytes_out = 0;
+        std::chrono::nanoseconds time{0};
+    };
+
+    Pipeline &lower();
+    Pipeline &upper();
+    Pipeline &swapcase();
+    Pipeline &remove_punctuation();
+    Pipeline &remove_chars(const std::string &charSet);
+    Pipeline &keep_chars(const std::string &charSet);
+    Pipeline &replace_char(char from, char to);
+    Pipeline &map(std::function<char(char)> func, const std::string &name = "map");
+    Pipeline &filter(std::function<bool(char)> predicate, const std::string &name = "filter");
+    Pipeline &normalize_whitespace();
+    Pipeline &trim();
+    Pipeline &trim_left();
+    Pipeline &trim_right();
+    Pipeline &profile(bool enabled = true);
+
+    std::string run(const std::string &input);
+    void run(const char *data, size_t size, std::string &output);
+    void run(std::istream &in, const Sink &sink, size_t chunk_size = 64 * 1024);
+    const std::vector<StageProfile> &profile_report() const;
+
+private:
+    enum class Kind
+    {
+        Table,
+        CollapseWhitespace,
+        Trim
+    };
+    struct Stage
+    {
+        Kind kind;
+        std::string name;
+        std::array<int16_t, 256> table;
+        bool trim_left;
+        bool trim_right;
+    };
+    struct Op
+    {
+        Kind kind;
+        std::array<int16_t, 256> table;
+        bool trim_left;
+        bool trim_right;
+        bool state;
+        std::string pending;
+    };
+
+    Pipeline &add_table(const std::string &name, const std::function<int16_t(unsigned char)> &entry);
+    Pipeline &add_stateful(Kind kind, const std::string &name, bool left, bool right);
+    void compile();
+    void reset();
+    void push(size_t first, size_t last, unsigned char c, std::string &out);
+    void process(const char *data, size_t size, std::string &out);
+
+    std::vector<Stage> stages_;
+    std::vector<Op> ops_;
+    std::vector<StageProfile> report_;
+    std::string scratch_[2];
+    bool compiled_ = false;
+    bool profiling_ = false;
+};
+
+/**
+ * @brief Zero-copy range of character or word n-grams over a string_view.
+ *
+ * Each n-gram is a view into the original text; a word n-gram spans from the start of its
+ * first word to the end of its last word, including the separating whitespace.
+ */
+class GiString::NGramRange
+{
+public:
+    enum class Unit
+    {
+        Chars,
+        Words
+    };
+
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view *;
+        using reference = std::string_view;
+
+        iterator() = default;
+        std::string_view operator*() const;
+        iterator &operator++();
+        iterator operator++(int);
+        bool operator==(const iterator &other) const { return first_ == other.first_; }
+        bool operator!=(const iterator &other) const { return first_ != other.first_; }
+
+    private:
+        friend class NGramRange;
+        iterator(std::string_view text, size_t n, Unit unit, size_t first, size_t last);
+
+        std::string_view text_;
+        size_t n_ = 0;
+        Unit unit_ = Unit::Chars;
+        size_t first_ = std::string_view::npos;
+        size_t last_ = 0;
+    };
+
+    NGramRange(std::string_view text, size_t n, Unit unit = Unit::Chars);
+    iterator begin() const;
+    iterator end() const;
+    bool empty() const;
+    size_t size() const;
+
+private:
+    std::string_view text_;
+    size_t n_;
+    Unit unit_;
+};
+
+/**
+ * @brief MinHash signature builder over n-gram fingerprints.
+ *
+ * A signature keeps the minimum of num_hashes independent hash permutations, so the
+ * Jaccard similarity of two n-gram sets is estimated by the fraction of equal slots.
+ */
+class GiString::MinHash
+{
+public:
+    explicit MinHash(size_t num_hashes = 128, uint64_t seed = 0x9E3779B97F4A7C15ULL);
+
+    std::vector<uint64_t> signature(std::string_view text, size_t n, NGramRange::Unit unit = NGramRange::Unit::Chars) const;
+    std::vector<uint64_t> empty_signature() const;
+    void update(std::vector<uint64_t> &signature, uint64_t fingerprint) const;
+    double similarity(const std::vector<uint64_t> &a, const std::vector<uint64_t> &b) const;
+
+private:
+    std::vector<uint64_t> multipliers_;
+    std::vector<uint64_t> increments_;
+};
+
+/**
+ * @brief Byte histogram and run counters gathered in a single sweep over a text.
+ *
+ * All character-class metrics are derived from the 256-bin histogram; word, alphabetic-word
+ * and sentence counts come from run edges tracked in the same loop. Statistics of
+ * consecutive chunks can be merged exactly, so chunks may be processed in parallel.
+ */
+class GiString::TextStats
+{
+public:
+    TextStats() = default;
+    TextStats(const char *data, size_t size, bool vocabulary = false);
+
+    void merge(const TextStats &next);
+
+    const std::array<uint64_t, 256> &histogram() const;
+    uint64_t count(unsigned char c) const;
+    uint64_t bytes() const;
+    uint64_t words() const;
+    uint64_t alpha_words() const;
+    uint64_t sentences() const;
+    uint64_t lines() const;
+    uint64_t letters() const;
+    uint64_t vowels() const;
+    uint64_t consonants() const;
+    uint64_t digits() const;
+    uint64_t whitespace() const;
+    uint64_t punctuation() const;
+    char most_common_char() const;
+    char least_common_char() const;
+    int reading_time() const;
+    double lexical_density() const;
+
+private:
+    // Polynomial hash of a word with punctuation removed; raw counts all bytes of the word
+    struct WordPiece
+    {
+        uint64_t hash = 0;
+        uint64_t length = 0;
+        uint64_t raw = 0;
+    };
+
+    template <bool Vocabulary>
+    void scan(const unsigned char *data, size_t size);
+    static WordPiece concat(const WordPiece &left, const WordPiece &right);
+
+    std::array<uint64_t, 256> histogram_{};
+    uint64_t bytes_ = 0;
+    uint64_t words_ = 0;
+    uint64_t alpha_words_ = 0;
+    uint64_t sentences_ = 0;
+    uint8_t first_class_ = 0;
+    uint8_t last_class_ = 0;
+    unsigned char first_byte_ = 0;
+    unsigned char last_byte_ = 0;
+
+    bool vocabulary_ = false;
+    bool split_ = false; // Whether the text contains whitespace, i.e. head_ and tail_ are separate pieces
+    WordPiece head_;
+    WordPiece tail_;
+    std::unordered_set<uint64_t> words_seen_;
+};
+
+/**
+ * @brief string_view layer over the non-mutating GiString functions.
+ *
+ * Inputs are taken as views so callers never materialize a std::string just to ask a
+ * question, and extractors return views into the input instead of copies. Returned views
+ * are only valid while the input buffer is alive. Error handling matches the std::string API.
+ */
+struct GiString::views
+{
+    static std::string_view substring(std::string_view str, size_t start, size_t end);
+    static std::string_view slice(std::string_view str, size_t start, size_t end);
+    static std::string_view substring_after(std::string_view str, std::string_view separator);
+    static std::string_view substring_before(std::string_view str, std::string_view separator);
+    static std::string_view substring_between(std::string_view str, std::string_view startDelim, std::string_view endDelim);
+    static std::array<std::string_view, 3> partition(std::string_view str, std::string_view separator);
+    static std::tuple<std::string_view, std::string_view, std::string_view> rpartition(std::string_view str, std::string_view delimiter);
+    static std::pair<std::string_view, std::string_view> split_at(std::string_view str, size_t index);
+    static std::string_view chop(std::string_view str);
+    static std::string_view trim(std::string_view str);
+    static std::string_view trim_left(std::string_view str);
+    static std::string_view trim_right(std::string_view str);
+    static std::string_view ltrim(std::string_view str);
+    static std::string_view rtrim(std::string_view str);
+    static std::vector<std::string_view> split(std::string_view str, char delimiter);
+    static std::vector<std::string_view> split_lines(std::string_view str);
+    static std::string_view extract_field(std::string_view input, char delimiter, int fieldIndex);
+
+    static size_t count(std::string_view str, std::string_view sub);
+    static int count_substring(std::string_view str, std::string_view substring);
+    static size_t find(std::string_view str, std::string_view sub);
+    static size_t rfind(std::string_view str, std::string_view sub);
+    static bool contains(std::string_view str, std::string_view sub);
+    static bool startswith(std::string_view str, std::string_view prefix);
+    static bool endswith(std::string_view str, std::string_view suffix);
+    static bool equals_ignore_case(std::string_view str1, std::string_view str2);
+    static bool is_ascii(std::string_view str);
+    static bool is_numeric(std::string_view str);
+    static bool is_alpha(std::string_view str);
+    static bool is_alphanumeric(std::string_view str);
+
+    static std::string insert(std::string_view str, size_t pos, std::string_view sub);
+    static std::string ascii_only(std::string_view str);
+    static std::string ensure_prefix(std::string_view str, std::string_view prefix);
+    static std::string ensure_suffix(std::string_view str, std::string_view suffix);
+};
+
+/**
+ * @brief Mutating counterparts of common transforms.
+ *
+ * The std::string& overloads rewrite the caller's buffer without copying it; the
+ * pointer-and-size overloads cover the size-preserving transforms on fixed buffers; the
+ * rvalue overloads take over the argument's buffer and return it. Error handling
+ * matches the copying std::string API.
+ */
+struct GiString::inplace
+{
+    static void trim(std::string &str);
+    static void upper(std::string &str);
+    static void upper(char *data, size_t size);
+    static void lower(std::string &str);
+    static void lower(char *data, size_t size);
+    static void reverse(std::string &str);
+    static void reverse(char *data, size_t size);
+    static void replace_first(std::string &str, const std::string &from, const std::string &to);
+    static void replace_last(std::string &str, const std::string &from, const std::string &to);
+    static void remove_last(std::string &str, const std::string &ch);
+    static void ensure_suffix(std::string &str, const std::string &suffix);
+    static void squeeze(std::string &str);
+    static void rot13(std::string &str);
+    static void rot13(char *data, size_t size);
+    static void xor_cipher(std::string &str, const std::string &key);
+    static void xor_cipher(char *data, size_t size, const std::string &key);
+    static void mask_sensitive(std::string &str, const std::string &sensitiveChars, char maskChar = '*');
+    static void mask_sensitive(char *data, size_t size, const std::string &sensitiveChars, char maskChar = '*');
+    static void anonymize(std::string &str, size_t start, size_t length, char mask);
+    static void mask_characters(std::string &input, char mask, const std::vector<int> &positions);
+    static void mask_credit_card(std::string &creditCardNumber);
+    static void apply_mask(std::string &str, const std::string &mask);
+    static void apply_mask(char *data, size_t size, const std::string &mask);
+
+    static std::string trim(std::string &&str);
+    static std::string upper(std::string &&str);
+    static std::string lower(std::string &&str);
+    static std::string reverse(std::string &&str);
+    static std::string replace_first(std::string &&str, const std::string &from, const std::string &to);
+    static std::string replace_last(std::string &&str, const std::string &from, const std::string &to);
+    static std::string remove_last(std::string &&str, const std::string &ch);
+    static std::string ensure_suffix(std::string &&str, const std::string &suffix);
+    static std::string squeeze(std::string &&str);
+    static std::string rot13(std::string &&str);
+    static std::string xor_cipher(std::string &&str, const std::string &key);
+    static std::string mask_sensitive(std::string &&str, const std::string &sensitiveChars, char maskChar = '*');
+    static std::string anonymize(std::string &&str, size_t start, size_t length, char mask);
+    static std::string mask_characters(std::string &&input, char mask, const std::vector<int> &positions);
+    static std::string mask_credit_card(std::string &&creditCardNumber);
+    static std::string apply_mask(std::string &&str, const std::string &mask);
 };
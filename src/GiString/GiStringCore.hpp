@@ -0,0 +1,529 @@
+#ifndef GISTRINGCORE_HPP
+#define GISTRINGCORE_HPP
+
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <cstdlib>
+
+// Builds with -fno-exceptions abort where exception-enabled builds throw
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define GISTRINGCORE_THROW(exception) throw exception
+#else
+#define GISTRINGCORE_THROW(exception) std::abort()
+#endif
+
+/**
+ * @brief Header-only core of the small, hot GiString operations.
+ *
+ * Everything here is inline (and constexpr where the standard library allows it), so
+ * calls inline into the caller's loops across translation units. Character classes are
+ * ASCII, matching the <cctype> functions in the default "C" locale. Unlike the GiString
+ * facade, the core does not validate its arguments: empty inputs simply yield the
+ * natural result (e.g. every predicate holds for an empty string).
+ */
+namespace GiStringCore
+{
+    constexpr bool is_space(char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+    constexpr bool is_digit(char c) { return c >= '0' && c <= '9'; }
+    constexpr bool is_upper(char c) { return c >= 'A' && c <= 'Z'; }
+    constexpr bool is_lower(char c) { return c >= 'a' && c <= 'z'; }
+    constexpr bool is_alpha(char c) { return is_upper(c) || is_lower(c); }
+    constexpr bool is_alnum(char c) { return is_alpha(c) || is_digit(c); }
+    constexpr bool is_ascii(char c) { return static_cast<unsigned char>(c) < 0x80; }
+    constexpr char to_upper(char c) { return is_lower(c) ? static_cast<char>(c - 'a' + 'A') : c; }
+    constexpr char to_lower(char c) { return is_upper(c) ? static_cast<char>(c - 'A' + 'a') : c; }
+
+    template <typename Predicate>
+    constexpr bool all_of(std::string_view str, Predicate predicate)
+    {
+        for (char c : str) {
+            if (!predicate(c)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    constexpr bool is_ascii(std::string_view str) { return all_of(str, [](char c) { return is_ascii(c); }); }
+    constexpr bool is_numeric(std::string_view str) { return all_of(str, [](char c) { return is_digit(c); }); }
+    constexpr bool is_alpha(std::string_view str) { return all_of(str, [](char c) { return is_alpha(c); }); }
+    constexpr bool is_alphanumeric(std::string_view str) { return all_of(str, [](char c) { return is_alnum(c); }); }
+    constexpr bool is_whitespace(std::string_view str) { return all_of(str, [](char c) { return is_space(c); }); }
+
+    constexpr bool startswith(std::string_view str, std::string_view prefix)
+    {
+        return str.size() >= prefix.size() && str.compare(0, prefix.size(), prefix) == 0;
+    }
+
+    constexpr bool endswith(std::string_view str, std::string_view suffix)
+    {
+        return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    constexpr size_t find(std::string_view str, std::string_view sub, size_t pos = 0) { return str.find(sub, pos); }
+    constexpr size_t rfind(std::string_view str, std::string_view sub) { return str.rfind(sub); }
+    constexpr bool contains(std::string_view str, std::string_view sub) { return str.find(sub) != std::string_view::npos; }
+
+    constexpr size_t count(std::string_view str, std::string_view sub)
+    {
+        if (sub.empty()) {
+            return 0;
+        }
+        size_t total = 0;
+        for (size_t pos = str.find(sub); pos != std::string_view::npos; pos = str.find(sub, pos + sub.size())) {
+            ++total;
+        }
+        return total;
+    }
+
+    constexpr bool equals_ignore_case(std::string_view a, std::string_view b)
+    {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (to_lower(a[i]) != to_lower(b[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    constexpr std::string_view ltrim(std::string_view str)
+    {
+        size_t start = 0;
+        while (start < str.size() && is_space(str[start])) {
+            ++start;
+        }
+        return str.substr(start);
+    }
+
+    constexpr std::string_view rtrim(std::string_view str)
+    {
+        size_t end = str.size();
+        while (end > 0 && is_space(str[end - 1])) {
+            --end;
+        }
+        return str.substr(0, end);
+    }
+
+    constexpr std::string_view trim(std::string_view str) { return rtrim(ltrim(str)); }
+
+    inline void to_upper(char *data, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = to_upper(data[i]);
+        }
+    }
+
+    inline void to_lower(char *data, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = to_lower(data[i]);
+        }
+    }
+
+    /**
+     * @brief Fixed-capacity string usable in constant expressions.
+     *
+     * Holds up to N characters plus a terminating NUL. Deduces its capacity from a string
+     * literal, so constexpr transforms can size their results from the input at compile
+     * time. With C++20 class-type template parameters it can also be passed as a
+     * template argument (template <GiStringCore::fixed_string S>).
+     */
+    template <size_t N>
+    struct fixed_string
+    {
+        char data[N + 1] = {};
+        size_t length = 0;
+
+        constexpr fixed_string() = default;
+        constexpr fixed_string(const char (&str)[N + 1])
+        {
+            for (size_t i = 0; i < N; ++i) {
+                data[i] = str[i];
+            }
+            length = N;
+        }
+
+        constexpr void push_back(char c)
+        {
+            if (length >= N) {
+                GISTRINGCORE_THROW(std::length_error("fixed_string capacity exceeded (GiStringCore::fixed_string)"));
+            }
+            data[length++] = c;
+            data[length] = '\0';
+        }
+
+        constexpr size_t size() const { return length; }
+        constexpr size_t capacity() const { return N; }
+        constexpr bool empty() const { return length == 0; }
+        constexpr const char *c_str() const { return data; }
+        constexpr char operator[](size_t index) const { return data[index]; }
+        constexpr std::string_view view() const { return std::string_view(data, length); }
+        constexpr operator std::string_view() const { return view(); }
+    };
+
+    template <size_t N>
+    fixed_string(const char (&)[N]) -> fixed_string<N - 1>;
+
+    template <size_t N, size_t M>
+    constexpr bool operator==(const fixed_string<N> &a, const fixed_string<M> &b) { return a.view() == b.view(); }
+    template <size_t N>
+    constexpr bool operator==(const fixed_string<N> &a, std::string_view b) { return a.view() == b; }
+    template <size_t N>
+    constexpr bool operator!=(const fixed_string<N> &a, std::string_view b) { return a.view() != b; }
+
+    // Transforms written against any output with push_back(char): std::string, fixed_string,
+    // GiString::Appender. They are constexpr whenever the output type is.
+
+    template <typename Out>
+    constexpr void upper(std::string_view str, Out &out)
+    {
+        for (char c : str) {
+            out.push_back(to_upper(c));
+        }
+    }
+
+    template <typename Out>
+    constexpr void lower(std::string_view str, Out &out)
+    {
+        for (char c : str) {
+            out.push_back(to_lower(c));
+        }
+    }
+
+    enum class case_style
+    {
+        camel,           // parseHttpRequest
+        pascal,          // ParseHttpRequest
+        snake,           // parse_http_request
+        screaming_snake, // PARSE_HTTP_REQUEST
+        kebab,           // parse-http-request
+        words            // parse http request
+    };
+
+    constexpr bool is_word_separator(char c) { return !is_alnum(c) && is_ascii(c); }
+
+    // Whether a new word starts at str[i], where str[i - 1] is a word character: at an
+    // uppercase letter that follows a lowercase letter or digit ("userId", "v2Api"), or at the
+    // last capital of an acronym followed by lowercase letters ("HTTPServer", "JSONId"). A
+    // lone "s" after an acronym is its plural and stays with it ("userIDs" is "user", "IDs").
+    constexpr bool word_starts_at(std::string_view str, size_t i)
+    {
+        char c = str[i];
+        char prev = str[i - 1];
+        if (!is_upper(c)) {
+            return false;
+        }
+        if (is_lower(prev) || is_digit(prev) || !is_ascii(prev)) {
+            return true;
+        }
+        if (!is_upper(prev) || i + 1 >= str.size() || !is_lower(str[i + 1])) {
+            return false;
+        }
+        bool plural = str[i + 1] == 's' && (i + 2 == str.size() || !is_lower(str[i + 2]));
+        return !plural;
+    }
+
+    // Calls visit(word) for each word of an identifier or phrase in any of the styles above.
+    // Words end at characters other than letters, digits and non-ASCII bytes and where
+    // word_starts_at() says a new one begins. Digits stay with the word they follow ("utf8").
+    template <typename Visit>
+    constexpr void for_each_word(std::string_view str, Visit visit)
+    {
+        size_t start = 0;
+        bool in_word = false;
+        for (size_t i = 0; i < str.size(); ++i) {
+            if (is_word_separator(str[i])) {
+                if (in_word) {
+                    visit(str.substr(start, i - start));
+                    in_word = false;
+                }
+                continue;
+            }
+            if (!in_word) {
+                start = i;
+                in_word = true;
+                continue;
+            }
+            if (word_starts_at(str, i)) {
+                visit(str.substr(start, i - start));
+                start = i;
+            }
+        }
+        if (in_word) {
+            visit(str.substr(start));
+        }
+    }
+
+    // Lengths of the separator runs that open and close str ("_private", "__init__"). They
+    // mark the identifier rather than split words, so the converters copy them unchanged; a
+    // string of separators only is all leading run.
+    constexpr size_t leading_separators(std::string_view str)
+    {
+        size_t n = 0;
+        while (n < str.size() && is_word_separator(str[n])) {
+            ++n;
+        }
+        return n;
+    }
+
+    constexpr size_t trailing_separators(std::string_view str)
+    {
+        size_t lead = leading_separators(str);
+        size_t n = 0;
+        while (n < str.size() - lead && is_word_separator(str[str.size() - 1 - n])) {
+            ++n;
+        }
+        return n;
+    }
+
+    constexpr char case_style_separator(case_style style)
+    {
+        switch (style) {
+        case case_style::snake:
+        case case_style::screaming_snake:
+            return '_';
+        case case_style::kebab:
+            return '-';
+        case case_style::words:
+            return ' ';
+        default:
+            return '\0';
+        }
+    }
+
+    // Exact output size of to_case_style, so callers can allocate once
+    constexpr size_t case_style_length(std::string_view str, case_style style)
+    {
+        size_t letters = 0;
+        size_t words = 0;
+        for_each_word(str, [&](std::string_view word) {
+            letters += word.size();
+            ++words;
+        });
+        size_t markers = leading_separators(str) + trailing_separators(str);
+        return markers + letters + (words > 1 && case_style_separator(style) != '\0' ? words - 1 : 0);
+    }
+
+    // Rewrites str in the given style; the input may be in any style or plain words
+    template <typename Out>
+    constexpr void to_case_style(std::string_view str, case_style style, Out &out)
+    {
+        char separator = case_style_separator(style);
+        size_t lead = leading_separators(str);
+        size_t trail = trailing_separators(str);
+        for (size_t i = 0; i < lead; ++i) {
+            out.push_back(str[i]);
+        }
+        bool first = true;
+        for_each_word(str, [&](std::string_view word) {
+            if (!first && separator != '\0') {
+                out.push_back(separator);
+            }
+            bool capitalize = style == case_style::pascal || (style == case_style::camel && !first);
+            for (size_t i = 0; i < word.size(); ++i) {
+                bool upper = style == case_style::screaming_snake || (capitalize && i == 0);
+                out.push_back(upper ? to_upper(word[i]) : to_lower(word[i]));
+            }
+            first = false;
+        });
+        for (size_t i = str.size() - trail; i < str.size(); ++i) {
+            out.push_back(str[i]);
+        }
+    }
+
+    template <typename Out>
+    constexpr void to_snake_case(std::string_view str, Out &out)
+    {
+        to_case_style(str, case_style::snake, out);
+    }
+
+    template <typename Out>
+    constexpr void to_kebab_case(std::string_view str, Out &out)
+    {
+        to_case_style(str, case_style::kebab, out);
+    }
+
+    template <typename Out>
+    constexpr void to_camel_case(std::string_view str, Out &out)
+    {
+        to_case_style(str, case_style::camel, out);
+    }
+
+    template <typename Out>
+    constexpr void to_pascal_case(std::string_view str, Out &out)
+    {
+        to_case_style(str, case_style::pascal, out);
+    }
+
+    template <typename Out>
+    constexpr void to_hex(std::string_view str, Out &out)
+    {
+        constexpr char digits[] = "0123456789abcdef";
+        for (char c : str) {
+            unsigned char byte = static_cast<unsigned char>(c);
+            out.push_back(digits[byte >> 4]);
+            out.push_back(digits[byte & 0x0F]);
+        }
+    }
+
+    template <typename Out>
+    constexpr void base64_encode(std::string_view str, Out &out)
+    {
+        constexpr char chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        size_t i = 0;
+        for (; i + 3 <= str.size(); i += 3) {
+            uint32_t triple = (uint32_t(static_cast<unsigned char>(str[i])) << 16) |
+                              (uint32_t(static_cast<unsigned char>(str[i + 1])) << 8) |
+                              uint32_t(static_cast<unsigned char>(str[i + 2]));
+            out.push_back(chars[(triple >> 18) & 0x3F]);
+            out.push_back(chars[(triple >> 12) & 0x3F]);
+            out.push_back(chars[(triple >> 6) & 0x3F]);
+            out.push_back(chars[triple & 0x3F]);
+        }
+        size_t rest = str.size() - i;
+        if (rest > 0) {
+            uint32_t triple = uint32_t(static_cast<unsigned char>(str[i])) << 16;
+            if (rest == 2) {
+                triple |= uint32_t(static_cast<unsigned char>(str[i + 1])) << 8;
+            }
+            out.push_back(chars[(triple >> 18) & 0x3F]);
+            out.push_back(chars[(triple >> 12) & 0x3F]);
+            out.push_back(rest == 2 ? chars[(triple >> 6) & 0x3F] : '=');
+            out.push_back('=');
+        }
+    }
+
+    constexpr bool is_regex_special(char c)
+    {
+        return c == '.' || c == '^' || c == '$' || c == '|' || c == '?' || c == '*' || c == '+' || c == '(' ||
+               c == ')' || c == '[' || c == ']' || c == '{' || c == '}' || c == '\\' || c == '/';
+    }
+
+    template <typename Out>
+    constexpr void escape_regex(std::string_view str, Out &out)
+    {
+        for (char c : str) {
+            if (is_regex_special(c)) {
+                out.push_back('\\');
+            }
+            out.push_back(c);
+        }
+    }
+
+    // 64-bit FNV-1a; stable across platforms, so compile-time and runtime keys agree
+    constexpr uint64_t hash(std::string_view str)
+    {
+        uint64_t h = 0xCBF29CE484222325ULL;
+        for (char c : str) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 0x100000001B3ULL;
+        }
+        return h;
+    }
+
+    // fixed_string overloads, sized for the worst case of each transform
+
+    template <size_t N>
+    constexpr fixed_string<N> upper(const fixed_string<N> &str)
+    {
+        fixed_string<N> out;
+        upper(str.view(), out);
+        return out;
+    }
+
+    template <size_t N>
+    constexpr fixed_string<N> lower(const fixed_string<N> &str)
+    {
+        fixed_string<N> out;
+        lower(str.view(), out);
+        return out;
+    }
+
+    template <size_t N>
+    constexpr fixed_string<2 * N> to_snake_case(const fixed_string<N> &str)
+    {
+        fixed_string<2 * N> out;
+        to_snake_case(str.view(), out);
+        return out;
+    }
+
+    template <size_t N>
+    constexpr fixed_string<2 * N> to_kebab_case(const fixed_string<N> &str)
+    {
+        fixed_string<2 * N> out;
+        to_kebab_case(str.view(), out);
+        return out;
+    }
+
+    template <size_t N>
+    constexpr fixed_string<N> to_camel_case(const fixed_string<N> &str)
+    {
+        fixed_string<N> out;
+        to_camel_case(str.view(), out);
+        return out;
+    }
+
+    template <size_t N>
+    constexpr fixed_string<N> to_pascal_case(const fixed_string<N> &str)
+    {
+        fixed_string<N> out;
+        to_pascal_case(str.view(), out);
+        return out;
+    }
+
+    template <size_t N>
+    constexpr fixed_string<2 * N> to_hex(const fixed_string<N> &str)
+    {
+        fixed_string<2 * N> out;
+        to_hex(str.view(), out);
+        return out;
+    }
+
+    template <size_t N>
+    constexpr fixed_string<(N + 2) / 3 * 4> base64_encode(const fixed_string<N> &str)
+    {
+        fixed_string<(N + 2) / 3 * 4> out;
+        base64_encode(str.view(), out);
+        return out;
+    }
+
+    template <size_t N>
+    constexpr fixed_string<2 * N> escape_regex(const fixed_string<N> &str)
+    {
+        fixed_string<2 * N> out;
+        escape_regex(str.view(), out);
+        return out;
+    }
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+    namespace literals
+    {
+        // "content-type"_fs is a fixed_string; requires C++20 class-type template parameters
+        template <fixed_string S>
+        constexpr auto operator""_fs() { return S; }
+    }
+#endif
+}
+
+// Example usage:
+// static_assert(GiStringCore::startswith("GET /index.html", "GET "));
+// std::string_view field = GiStringCore::trim("  value\r\n");
+// std::cout << field << std::endl;
+// Output: "value"
+//
+// constexpr auto header = GiStringCore::upper(GiStringCore::fixed_string("content-type"));
+// constexpr auto column = GiStringCore::to_snake_case(GiStringCore::fixed_string("RequestCount"));
+// constexpr auto token = GiStringCore::base64_encode(GiStringCore::fixed_string("user:secret"));
+// constexpr uint64_t key = GiStringCore::hash(column);
+// static_assert(header == "CONTENT-TYPE" && column == "request_count");
+//
+// std::string field;
+// GiStringCore::to_case_style("parseHTTPResponse2XX", GiStringCore::case_style::snake, field);
+// Output: "parse_http_response2_xx"
+
+#endif // GISTRINGCORE_HPP
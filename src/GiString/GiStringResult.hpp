@@ -0,0 +1,320 @@
+#ifndef GISTRINGRESULT_HPP
+#define GISTRINGRESULT_HPP
+
+#include "GiStringCore.hpp"
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Non-throwing counterparts of the GiString functions that throw on bad input.
+ *
+ * Empty input is an ordinary case here: it yields the natural result (an empty string,
+ * a count of 0) instead of std::invalid_argument. Arguments that have no meaningful
+ * answer, such as an empty search pattern or an index past the end, are reported through
+ * GiStringCore::result, an expected-style value-or-error code. Functions that cannot
+ * fail once empty input is accepted return plain values. Nothing in this header throws
+ * (apart from std::bad_alloc) and it compiles with -fno-exceptions; result::value() on
+ * an error throws bad_result_access, or aborts when exceptions are disabled.
+ */
+namespace GiStringCore
+{
+    enum class errc
+    {
+        empty_argument = 1, // A pattern, separator or delimiter argument is empty
+        out_of_range,       // An index lies outside the input
+        invalid_argument    // Any other argument outside its domain
+    };
+
+    constexpr const char *message(errc error)
+    {
+        switch (error) {
+        case errc::empty_argument:
+            return "Argument is empty";
+        case errc::out_of_range:
+            return "Index out of range";
+        case errc::invalid_argument:
+            return "Invalid argument";
+        }
+        return "Unknown error";
+    }
+
+    class bad_result_access : public std::logic_error
+    {
+    public:
+        explicit bad_result_access(errc error) : std::logic_error(message(error)), error_(error) {}
+        errc error() const { return error_; }
+
+    private:
+        errc error_;
+    };
+
+    /**
+     * @brief Holds either a value or the errc explaining why there is none.
+     */
+    template <typename T>
+    class result
+    {
+    public:
+        result(T value) : value_(std::move(value)) {}
+        result(errc error) : error_(error) {}
+
+        bool has_value() const { return value_.has_value(); }
+        explicit operator bool() const { return has_value(); }
+        errc error() const { return error_; }
+
+        T &value() &
+        {
+            check();
+            return *value_;
+        }
+        const T &value() const &
+        {
+            check();
+            return *value_;
+        }
+        T &&value() &&
+        {
+            check();
+            return std::move(*value_);
+        }
+
+        // A string_view result cannot fall back to a temporary std::string: the view would
+        // dangle as soon as the call returns, so such calls do not compile
+        template <typename U>
+        static constexpr bool dangles = std::is_same<T, std::string_view>::value && !std::is_lvalue_reference<U>::value &&
+                                        std::is_same<typename std::decay<U>::type, std::string>::value;
+
+        template <typename U, typename = std::enable_if_t<!dangles<U>>>
+        T value_or(U &&fallback) const & { return has_value() ? *value_ : static_cast<T>(std::forward<U>(fallback)); }
+        template <typename U, typename = std::enable_if_t<!dangles<U>>>
+        T value_or(U &&fallback) && { return has_value() ? std::move(*value_) : static_cast<T>(std::forward<U>(fallback)); }
+
+        T &operator*() { return *value_; }
+        const T &operator*() const { return *value_; }
+        T *operator->() { return &*value_; }
+        const T *operator->() const { return &*value_; }
+
+    private:
+        void check() const
+        {
+            if (!value_) {
+                GISTRINGCORE_THROW(bad_result_access(error_));
+            }
+        }
+
+        std::optional<T> value_;
+        errc error_ = errc::invalid_argument;
+    };
+
+    namespace nothrow
+    {
+        inline std::string upper(std::string_view str)
+        {
+            std::string out;
+            out.reserve(str.size());
+            GiStringCore::upper(str, out);
+            return out;
+        }
+
+        inline std::string lower(std::string_view str)
+        {
+            std::string out;
+            out.reserve(str.size());
+            GiStringCore::lower(str, out);
+            return out;
+        }
+
+        inline std::string capitalize(std::string_view str)
+        {
+            std::string out;
+            out.reserve(str.size());
+            GiStringCore::lower(str, out);
+            if (!out.empty()) {
+                out[0] = to_upper(out[0]);
+            }
+            return out;
+        }
+
+        inline std::string swapcase(std::string_view str)
+        {
+            std::string out(str);
+            for (char &c : out) {
+                c = is_upper(c) ? to_lower(c) : to_upper(c);
+            }
+            return out;
+        }
+
+        inline std::string reverse(std::string_view str) { return std::string(str.rbegin(), str.rend()); }
+
+        inline std::string join(const std::vector<std::string> &strs, std::string_view separator)
+        {
+            std::string out;
+            for (size_t i = 0; i < strs.size(); ++i) {
+                if (i > 0) {
+                    out.append(separator.data(), separator.size());
+                }
+                out += strs[i];
+            }
+            return out;
+        }
+
+        inline result<size_t> count(std::string_view str, std::string_view sub)
+        {
+            if (sub.empty()) {
+                return errc::empty_argument;
+            }
+            return GiStringCore::count(str, sub);
+        }
+
+        // npos when sub does not occur in str
+        inline result<size_t> find(std::string_view str, std::string_view sub)
+        {
+            if (sub.empty()) {
+                return errc::empty_argument;
+            }
+            return GiStringCore::find(str, sub);
+        }
+
+        inline result<size_t> rfind(std::string_view str, std::string_view sub)
+        {
+            if (sub.empty()) {
+                return errc::empty_argument;
+            }
+            return GiStringCore::rfind(str, sub);
+        }
+
+        inline result<bool> contains(std::string_view str, std::string_view sub)
+        {
+            if (sub.empty()) {
+                return errc::empty_argument;
+            }
+            return GiStringCore::contains(str, sub);
+        }
+
+        inline result<std::string> replace(std::string_view str, std::string_view old_sub, std::string_view new_sub)
+        {
+            if (old_sub.empty()) {
+                return errc::empty_argument;
+            }
+            std::string out;
+            out.reserve(str.size());
+            size_t start = 0;
+            for (size_t pos = str.find(old_sub); pos != std::string_view::npos; pos = str.find(old_sub, start)) {
+                out.append(str.data() + start, pos - start);
+                out.append(new_sub.data(), new_sub.size());
+                start = pos + old_sub.size();
+            }
+            out.append(str.data() + start, str.size() - start);
+            return out;
+        }
+
+        inline result<std::string> replace_first(std::string_view str, std::string_view from, std::string_view to)
+        {
+            if (from.empty()) {
+                return errc::empty_argument;
+            }
+            std::string out(str);
+            size_t pos = str.find(from);
+            if (pos != std::string_view::npos) {
+                out.replace(pos, from.size(), to.data(), to.size());
+            }
+            return out;
+        }
+
+        inline result<std::string> replace_last(std::string_view str, std::string_view from, std::string_view to)
+        {
+            if (from.empty()) {
+                return errc::empty_argument;
+            }
+            std::string out(str);
+            size_t pos = str.rfind(from);
+            if (pos != std::string_view::npos) {
+                out.replace(pos, from.size(), to.data(), to.size());
+            }
+            return out;
+        }
+
+        // Tokenizes like GiString::split: a trailing empty token is not produced
+        inline result<std::vector<std::string_view>> split(std::string_view str, char delimiter)
+        {
+            if (delimiter == '\0') {
+                return errc::empty_argument;
+            }
+            std::vector<std::string_view> tokens;
+            size_t start = 0;
+            while (start < str.size()) {
+                size_t pos = str.find(delimiter, start);
+                if (pos == std::string_view::npos) {
+                    tokens.push_back(str.substr(start));
+                    break;
+                }
+                tokens.push_back(str.substr(start, pos - start));
+                start = pos + 1;
+            }
+            return tokens;
+        }
+
+        // [start, end); an empty range is allowed, unlike GiString::substring
+        inline result<std::string_view> substring(std::string_view str, size_t start, size_t end)
+        {
+            if (start > str.size() || end > str.size()) {
+                return errc::out_of_range;
+            }
+            if (start > end) {
+                return errc::invalid_argument;
+            }
+            return str.substr(start, end - start);
+        }
+
+        // A trailing delimiter ends with an empty field
+        inline result<std::string_view> extract_field(std::string_view input, char delimiter, size_t index)
+        {
+            size_t start = 0;
+            for (size_t field = 0;; ++field) {
+                size_t pos = input.find(delimiter, start);
+                if (field == index) {
+                    return input.substr(start, pos == std::string_view::npos ? std::string_view::npos : pos - start);
+                }
+                if (pos == std::string_view::npos) {
+                    return errc::out_of_range;
+                }
+                start = pos + 1;
+            }
+        }
+
+        inline result<std::string> repeat(std::string_view str, int times)
+        {
+            if (times < 0) {
+                return errc::invalid_argument;
+            }
+            std::string out;
+            if (!str.empty() && static_cast<size_t>(times) > out.max_size() / str.size()) {
+                return errc::invalid_argument;
+            }
+            out.reserve(str.size() * static_cast<size_t>(times));
+            for (int i = 0; i < times; ++i) {
+                out.append(str.data(), str.size());
+            }
+            return out;
+        }
+    }
+}
+
+// Example usage:
+// for (const std::string& field : fields) {                  // empty fields are common
+//     std::string key = GiStringCore::nothrow::lower(field);  // "" stays "", no exception
+//     GiStringCore::result<size_t> hits = GiStringCore::nothrow::count(field, needle);
+//     if (!hits) {
+//         std::cerr << GiStringCore::message(hits.error()) << std::endl;
+//         continue;
+//     }
+//     total += *hits;
+// }
+// std::string_view third = GiStringCore::nothrow::extract_field("a,b,c", ',', 2).value_or("");
+
+#endif // GISTRINGRESULT_HPP
@@ -0,0 +1,729 @@
+#include "GiUnicode.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    enum GraphemeClass : uint8_t
+    {
+        gcb_other,
+        gcb_cr,
+        gcb_lf,
+        gcb_control,
+        gcb_extend,
+        gcb_zwj,
+        gcb_regional_indicator,
+        gcb_prepend,
+        gcb_spacing_mark,
+        gcb_l,
+        gcb_v,
+        gcb_t,
+        gcb_lv,
+        gcb_lvt
+    };
+
+#include "GiUnicodeWidth.inc"
+
+    // Bits 0-1: column width (0, 1 or 2), bits 2-5: GraphemeClass, bit 6: Extended_Pictographic
+    uint8_t width_props(char32_t cp) {
+        if (cp >= width_limit) {
+            return 1;
+        }
+        return width_leaves[width_stage2[width_stage1[cp >> 10]][(cp >> 6) & 0x0F]][cp & 0x3F];
+    }
+
+    GraphemeClass grapheme_class(uint8_t props) {
+        return static_cast<GraphemeClass>((props >> 2) & 0x0F);
+    }
+
+    bool is_pictographic(uint8_t props) {
+        return (props & 0x40) != 0;
+    }
+
+    bool is_hangul_vowel_side(GraphemeClass cls) {
+        return cls == gcb_v || cls == gcb_lv;
+    }
+
+    // UAX #29 rules GB3-GB13 for the pair (prev, next); emoji_zwj is true when prev is a ZWJ
+    // ending an Extended_Pictographic Extend* ZWJ sequence, regional_count the length of the
+    // run of regional indicators ending at prev
+    bool joins_grapheme(GraphemeClass prev, uint8_t next_props, bool emoji_zwj, size_t regional_count) {
+        GraphemeClass next = grapheme_class(next_props);
+        if (prev == gcb_cr && next == gcb_lf) {
+            return true;
+        }
+        if (prev == gcb_cr || prev == gcb_lf || prev == gcb_control || next == gcb_cr || next == gcb_lf || next == gcb_control) {
+            return false;
+        }
+        if (prev == gcb_l && (next == gcb_l || next == gcb_v || next == gcb_lv || next == gcb_lvt)) {
+            return true;
+        }
+        if (is_hangul_vowel_side(prev) && (next == gcb_v || next == gcb_t)) {
+            return true;
+        }
+        if ((prev == gcb_lvt || prev == gcb_t) && next == gcb_t) {
+            return true;
+        }
+        if (next == gcb_extend || next == gcb_zwj || next == gcb_spacing_mark || prev == gcb_prepend) {
+            return true;
+        }
+        if (emoji_zwj && is_pictographic(next_props)) {
+            return true;
+        }
+        return prev == gcb_regional_indicator && next == gcb_regional_indicator && regional_count % 2 == 1;
+    }
+
+    // Columns of an all-ASCII run: printable characters take one column, controls none
+    size_t ascii_columns(const char *data, size_t size) {
+        size_t columns = 0;
+        size_t i = 0;
+#if defined(__SSE2__)
+        const __m128i below_space = _mm_set1_epi8(0x1F);
+        const __m128i del = _mm_set1_epi8(0x7F);
+        for (; i + 16 <= size; i += 16) {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            __m128i printable = _mm_andnot_si128(_mm_cmpeq_epi8(bytes, del), _mm_cmpgt_epi8(bytes, below_space));
+            columns += std::bitset<16>(static_cast<unsigned>(_mm_movemask_epi8(printable))).count();
+        }
+#endif
+        for (; i < size; ++i) {
+            columns += (data[i] >= 0x20 && data[i] != 0x7F) ? 1 : 0;
+        }
+        return columns;
+    }
+
+    struct CaseRecord
+    {
+        int32_t delta[4]; // Indexed by CaseMapping
+        uint8_t special;  // Bit k set: the full mapping k is in case_specials
+    };
+
+    struct SpecialCase
+    {
+        char32_t cp;
+        uint8_t mapping;
+        uint8_t length;
+        char32_t to[3];
+    };
+
+#include "GiUnicodeCase.inc"
+
+    const CaseRecord &case_record(char32_t cp) {
+        if (cp >= case_limit) {
+            return case_records[0];
+        }
+        return case_records[case_blocks[case_stage1[cp >> 7]][cp & 0x7F]];
+    }
+
+    char ascii_case(char c, GiUnicode::CaseMapping mapping) {
+        if (mapping == GiUnicode::CaseMapping::upper || mapping == GiUnicode::CaseMapping::title) {
+            return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 32) : c;
+        }
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + 32) : c;
+    }
+
+    // Converts an all-ASCII run; 16 bytes at a time with SSE2
+    void ascii_case_run(const char *data, size_t size, GiUnicode::CaseMapping mapping, char *out) {
+        size_t i = 0;
+#if defined(__SSE2__)
+        bool to_upper = mapping == GiUnicode::CaseMapping::upper || mapping == GiUnicode::CaseMapping::title;
+        const __m128i first = _mm_set1_epi8(to_upper ? 'a' - 1 : 'A' - 1);
+        const __m128i last = _mm_set1_epi8(to_upper ? 'z' + 1 : 'Z' + 1);
+        const __m128i flip = _mm_set1_epi8(0x20);
+        for (; i + 16 <= size; i += 16) {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            __m128i in_range = _mm_and_si128(_mm_cmpgt_epi8(bytes, first), _mm_cmplt_epi8(bytes, last));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_xor_si128(bytes, _mm_and_si128(in_range, flip)));
+        }
+#endif
+        for (; i < size; ++i) {
+            out[i] = ascii_case(data[i], mapping);
+        }
+    }
+
+    // Yields the full case folding of a UTF-8 string one code point at a time. Bytes that
+    // are not valid UTF-8 come out as values above U+10FFFF, so they only match themselves.
+    class FoldedCodepoints
+    {
+    public:
+        FoldedCodepoints(const char *data, size_t size) : data_(data), size_(size) {}
+
+        bool next(char32_t &cp) {
+            if (pending_ < count_) {
+                cp = buffer_[pending_++];
+                return true;
+            }
+            if (pos_ >= size_) {
+                return false;
+            }
+            unsigned char lead = static_cast<unsigned char>(data_[pos_]);
+            if (lead < 0x80) {
+                ++pos_;
+                cp = (lead >= 'A' && lead <= 'Z') ? lead + 32 : lead;
+                return true;
+            }
+            size_t length;
+            char32_t decoded = GiUnicode::decode_utf8(data_ + pos_, size_ - pos_, length);
+            pos_ += length;
+            if (decoded == 0xFFFD && length == 1) {
+                cp = 0x110000 + lead;
+                return true;
+            }
+            count_ = GiUnicode::full_case(decoded, GiUnicode::CaseMapping::fold, buffer_);
+            pending_ = 1;
+            cp = buffer_[0];
+            return true;
+        }
+
+    private:
+        const char *data_;
+        size_t size_;
+        size_t pos_ = 0;
+        char32_t buffer_[3];
+        size_t count_ = 0;
+        size_t pending_ = 0;
+    };
+}
+
+/**
+ * @brief Decodes a single UTF-8 sequence.
+ *
+ * Malformed, overlong or truncated sequences decode to U+FFFD and consume one byte,
+ * so callers always make progress through arbitrary input.
+ *
+ * @param data Pointer to the first byte of the sequence.
+ * @param size Number of bytes available at data (must be greater than 0).
+ * @param length Receives the number of bytes consumed.
+ * @return The decoded code point.
+ */
+char32_t GiUnicode::decode_utf8(const char *data, size_t size, size_t &length) {
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+    unsigned char lead = bytes[0];
+    length = 1;
+
+    if (lead < 0x80) {
+        return lead;
+    }
+
+    size_t needed;
+    char32_t cp;
+    char32_t min_value;
+    if ((lead & 0xE0) == 0xC0) {
+        needed = 2;
+        cp = lead & 0x1F;
+        min_value = 0x80;
+    } else if ((lead & 0xF0) == 0xE0) {
+        needed = 3;
+        cp = lead & 0x0F;
+        min_value = 0x800;
+    } else if ((lead & 0xF8) == 0xF0) {
+        needed = 4;
+        cp = lead & 0x07;
+        min_value = 0x10000;
+    } else {
+        return 0xFFFD;
+    }
+
+    if (size < needed) {
+        return 0xFFFD;
+    }
+    for (size_t i = 1; i < needed; ++i) {
+        if ((bytes[i] & 0xC0) != 0x80) {
+            return 0xFFFD;
+        }
+        cp = (cp << 6) | (bytes[i] & 0x3F);
+    }
+    if (cp < min_value || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+        return 0xFFFD;
+    }
+
+    length = needed;
+    return cp;
+}
+
+// Example usage:
+// size_t length = 0;
+// char32_t cp = GiUnicode::decode_utf8("\xC5\x82", 2, length);
+// std::cout << std::hex << cp << " (" << length << " bytes)" << std::endl;
+// Output: "142 (2 bytes)"
+
+/**
+ * @brief Returns the number of terminal columns a code point occupies.
+ *
+ * @param cp The code point to measure.
+ * @return 0 for control, combining and format characters, 2 for East Asian wide/fullwidth
+ *         and emoji presentation characters, 1 otherwise.
+ * @note As in wcwidth(), U+00AD SOFT HYPHEN takes one column although it is a format
+ *       character, and Hangul jamo vowels and trailing consonants (U+1160-11FF, U+D7B0-D7FF)
+ *       take none since they join the preceding leading consonant's two columns.
+ */
+int GiUnicode::codepoint_width(char32_t cp) {
+    if (cp < 0x7F) {
+        return cp >= 0x20 ? 1 : 0;
+    }
+    return width_props(cp) & 0x03;
+}
+
+// Example usage:
+// std::cout << GiUnicode::codepoint_width(U'a') << GiUnicode::codepoint_width(U'中') << std::endl;
+// Output: "12"
+
+/**
+ * @brief Finds the extended grapheme cluster (user-perceived character) starting at data.
+ *
+ * Boundaries follow UAX #29 (Unicode 14.0), including Hangul syllables, emoji ZWJ sequences
+ * and flags. The cluster is as wide as its first code point with a non-zero width; clusters
+ * with U+FE0F, an emoji with a skin tone modifier and a pair of regional indicators are 2
+ * columns wide.
+ *
+ * @param data Pointer to the first byte of the cluster.
+ * @param size Number of bytes available at data (must be greater than 0).
+ * @param width Receives the display width of the cluster.
+ * @return The length of the cluster in bytes.
+ */
+size_t GiUnicode::next_grapheme(const char *data, size_t size, size_t &width) {
+    size_t length;
+    char32_t cp = decode_utf8(data, size, length);
+    uint8_t props = width_props(cp);
+    width = codepoint_width(cp);
+
+    GraphemeClass prev = grapheme_class(props);
+    bool base_pictographic = is_pictographic(props);
+    bool pictographic_run = base_pictographic; // Extended_Pictographic Extend* so far
+    bool emoji_zwj = false;
+    size_t regional_count = prev == gcb_regional_indicator ? 1 : 0;
+    size_t pos = length;
+    while (pos < size) {
+        cp = decode_utf8(data + pos, size - pos, length);
+        props = width_props(cp);
+        if (!joins_grapheme(prev, props, emoji_zwj, regional_count)) {
+            break;
+        }
+        GraphemeClass next = grapheme_class(props);
+        if (width == 0) {
+            width = codepoint_width(cp);
+        }
+        if (cp == 0xFE0F || (base_pictographic && cp >= 0x1F3FB && cp <= 0x1F3FF)) {
+            width = 2; // Emoji presentation selector (also on keycaps) or skin tone modifier
+        }
+        if (next == gcb_regional_indicator) {
+            width = 2;
+        }
+
+        emoji_zwj = next == gcb_zwj && pictographic_run;
+        pictographic_run = is_pictographic(props) || (next == gcb_extend && pictographic_run);
+        regional_count = next == gcb_regional_indicator ? regional_count + 1 : 0;
+        prev = next;
+        pos += length;
+    }
+    return pos;
+}
+
+/**
+ * @brief Counts the extended grapheme clusters (user-perceived characters) in a UTF-8 buffer.
+ */
+size_t GiUnicode::grapheme_count(const char *data, size_t size) {
+    size_t count = 0;
+    size_t width;
+    for (size_t i = 0; i < size; i += next_grapheme(data + i, size - i, width)) {
+        ++count;
+    }
+    return count;
+}
+
+size_t GiUnicode::grapheme_count(const std::string &str) {
+    return grapheme_count(str.data(), str.size());
+}
+
+// Example usage:
+// std::string family = "\xF0\x9F\x91\xA9\xE2\x80\x8D\xF0\x9F\x91\xA7";  // woman, ZWJ, girl
+// std::cout << GiUnicode::grapheme_count("e\xCC\x81" + family) << std::endl;
+// Output: "2"
+
+/**
+ * @brief Calculates the display width (terminal columns) of a UTF-8 buffer.
+ *
+ * The text is measured per grapheme cluster, so combining marks, emoji sequences and flags
+ * count once. ASCII runs are measured 16 bytes at a time without decoding; only the byte
+ * before a non-ASCII sequence goes through the cluster rules.
+ *
+ * @param data Pointer to the UTF-8 bytes.
+ * @param size Number of bytes to measure.
+ * @return The total display width.
+ */
+size_t GiUnicode::display_width(const char *data, size_t size) {
+    size_t width = 0;
+    size_t i = 0;
+    while (i < size) {
+        size_t run = ascii_prefix(data + i, size - i);
+        if (run == size - i) {
+            return width + ascii_columns(data + i, run);
+        }
+        if (run > 1) {
+            // The last ASCII character may start a cluster with the marks that follow it
+            width += ascii_columns(data + i, run - 1);
+            i += run - 1;
+        }
+        size_t cluster_width;
+        i += next_grapheme(data + i, size - i, cluster_width);
+        width += cluster_width;
+    }
+    return width;
+}
+
+/**
+ * @brief Calculates the display width (terminal columns) of a UTF-8 string.
+ *
+ * @param str The UTF-8 string to measure.
+ * @return The total display width.
+ */
+size_t GiUnicode::display_width(const std::string &str) {
+    return display_width(str.data(), str.size());
+}
+
+// Example usage:
+// std::cout << GiUnicode::display_width("Zażółć 中文") << std::endl;
+// Output: "11"
+
+/**
+ * @brief Finds the longest prefix made of whole grapheme clusters that fits in max_width columns.
+ *
+ * @param data Pointer to the UTF-8 bytes.
+ * @param size Number of bytes available.
+ * @param max_width The number of columns available.
+ * @param width Receives the display width of the prefix.
+ * @return The length of the prefix in bytes.
+ */
+size_t GiUnicode::fit_width(const char *data, size_t size, size_t max_width, size_t &width) {
+    width = 0;
+    size_t i = 0;
+    while (i < size) {
+        size_t run = ascii_prefix(data + i, size - i);
+        if (run > 1 || run == size - i) {
+            size_t end = run == size - i ? size : i + run - 1;
+            size_t columns = ascii_columns(data + i, end - i);
+            if (width + columns <= max_width) {
+                width += columns;
+                i = end;
+                continue;
+            }
+            for (; i < end; ++i) {
+                size_t column = (data[i] >= 0x20 && data[i] != 0x7F) ? 1 : 0;
+                if (width + column > max_width) {
+                    return i;
+                }
+                width += column;
+            }
+        }
+        size_t cluster_width;
+        size_t length = next_grapheme(data + i, size - i, cluster_width);
+        if (width + cluster_width > max_width) {
+            return i;
+        }
+        width += cluster_width;
+        i += length;
+    }
+    return i;
+}
+
+// Example usage:
+// std::string text = "中文字幕";
+// size_t width = 0;
+// size_t bytes = GiUnicode::fit_width(text.data(), text.size(), 5, width);
+// std::cout << text.substr(0, bytes) << " (" << width << " columns)" << std::endl;
+// Output: "中文 (4 columns)"
+
+/**
+ * @brief Encodes a code point as UTF-8.
+ *
+ * @param cp The code point; surrogates and values above U+10FFFF are encoded as U+FFFD.
+ * @param out Receives the encoded bytes (room for 4 bytes is required).
+ * @return The number of bytes written.
+ */
+size_t GiUnicode::encode_utf8(char32_t cp, char *out) {
+    if (cp < 0x80) {
+        out[0] = static_cast<char>(cp);
+        return 1;
+    }
+    if (cp < 0x800) {
+        out[0] = static_cast<char>(0xC0 | (cp >> 6));
+        out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+        return 2;
+    }
+    if (cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+        cp = 0xFFFD;
+    }
+    if (cp < 0x10000) {
+        out[0] = static_cast<char>(0xE0 | (cp >> 12));
+        out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    out[0] = static_cast<char>(0xF0 | (cp >> 18));
+    out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+    out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+// Example usage:
+// char bytes[4];
+// size_t length = GiUnicode::encode_utf8(U'ż', bytes);
+// std::cout << std::string(bytes, length) << " (" << length << " bytes)" << std::endl;
+// Output: "ż (2 bytes)"
+
+/**
+ * @brief Returns the length of the leading run of ASCII bytes.
+ *
+ * Scans 16 bytes per step with SSE2 (8 with a portable word-at-a-time loop otherwise).
+ *
+ * @param data Pointer to the bytes.
+ * @param size Number of bytes available.
+ * @return The number of leading bytes below 0x80.
+ */
+size_t GiUnicode::ascii_prefix(const char *data, size_t size) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 16 <= size; i += 16) {
+        int mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i)));
+        if (mask != 0) {
+            for (int bit = 0; !(mask & (1 << bit)); ++bit) {
+                ++i;
+            }
+            return i;
+        }
+    }
+#else
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        if (word & 0x8080808080808080ULL) {
+            break;
+        }
+    }
+#endif
+    while (i < size && static_cast<unsigned char>(data[i]) < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+/**
+ * @brief Checks whether a buffer contains only ASCII bytes.
+ */
+bool GiUnicode::is_ascii(const char *data, size_t size) {
+    return ascii_prefix(data, size) == size;
+}
+
+/**
+ * @brief Returns the simple (single code point) case mapping of a code point.
+ *
+ * @param cp The code point to map.
+ * @param mapping Which mapping to apply; fold is simple case folding.
+ * @return The mapped code point, or cp itself if it has no mapping.
+ */
+char32_t GiUnicode::simple_case(char32_t cp, CaseMapping mapping) {
+    return static_cast<char32_t>(static_cast<int32_t>(cp) + case_record(cp).delta[static_cast<int>(mapping)]);
+}
+
+char32_t GiUnicode::to_upper(char32_t cp) {
+    return simple_case(cp, CaseMapping::upper);
+}
+
+char32_t GiUnicode::to_lower(char32_t cp) {
+    return simple_case(cp, CaseMapping::lower);
+}
+
+char32_t GiUnicode::to_title(char32_t cp) {
+    return simple_case(cp, CaseMapping::title);
+}
+
+char32_t GiUnicode::fold(char32_t cp) {
+    return simple_case(cp, CaseMapping::fold);
+}
+
+// Example usage:
+// std::cout << std::hex << GiUnicode::to_upper(U'ł') << " " << GiUnicode::to_title(U'ǆ') << std::endl;
+// Output: "141 1c5"
+
+/**
+ * @brief Returns the full case mapping of a code point, which may expand to several code points.
+ *
+ * Uses the unconditional mappings of SpecialCasing.txt (e.g. "ß" uppercases to "SS");
+ * language-specific and context-dependent rules (Turkish dotless i, final sigma) are not applied.
+ *
+ * @param cp The code point to map.
+ * @param mapping Which mapping to apply; fold is full case folding.
+ * @param out Receives the mapped code points (room for 3 is required).
+ * @return The number of code points written (1 to 3).
+ */
+size_t GiUnicode::full_case(char32_t cp, CaseMapping mapping, char32_t *out) {
+    const CaseRecord &record = case_record(cp);
+    int index = static_cast<int>(mapping);
+    if (record.special & (1 << index)) {
+        const SpecialCase *end = case_specials + sizeof(case_specials) / sizeof(case_specials[0]);
+        const SpecialCase *it = std::lower_bound(case_specials, end, std::make_pair(cp, index),
+                                                 [](const SpecialCase &special, const std::pair<char32_t, int> &key) {
+                                                     return special.cp < key.first || (special.cp == key.first && special.mapping < key.second);
+                                                 });
+        std::copy(it->to, it->to + it->length, out);
+        return it->length;
+    }
+    out[0] = static_cast<char32_t>(static_cast<int32_t>(cp) + record.delta[index]);
+    return 1;
+}
+
+/**
+ * @brief Checks whether a code point takes part in case mapping (has any upper, lower, title or folded form).
+ */
+bool GiUnicode::is_cased(char32_t cp) {
+    const CaseRecord &record = case_record(cp);
+    return record.special || record.delta[0] || record.delta[1] || record.delta[2] || record.delta[3];
+}
+
+/**
+ * @brief Applies the full case mapping to the UTF-8 sequence at data.
+ *
+ * Bytes that are not valid UTF-8 are copied through unchanged.
+ *
+ * @param data Pointer to the first byte of the sequence.
+ * @param size Number of bytes available at data (must be greater than 0).
+ * @param mapping Which mapping to apply.
+ * @param out Receives the mapped UTF-8 bytes (room for 12 bytes is required).
+ * @param length Receives the number of input bytes consumed.
+ * @return The number of bytes written to out.
+ */
+size_t GiUnicode::map_case(const char *data, size_t size, CaseMapping mapping, char *out, size_t &length) {
+    unsigned char lead = static_cast<unsigned char>(data[0]);
+    if (lead < 0x80) {
+        length = 1;
+        out[0] = ascii_case(data[0], mapping);
+        return 1;
+    }
+    char32_t cp = decode_utf8(data, size, length);
+    if (cp == 0xFFFD && length == 1) {
+        out[0] = data[0];
+        return 1;
+    }
+    char32_t mapped[3];
+    size_t count = full_case(cp, mapping, mapped);
+    size_t written = 0;
+    for (size_t i = 0; i < count; ++i) {
+        written += encode_utf8(mapped[i], out + written);
+    }
+    return written;
+}
+
+/**
+ * @brief Applies the full case mapping to a UTF-8 buffer, appending the result to out.
+ *
+ * ASCII runs are found and converted 16 bytes at a time, so ASCII text runs at close to
+ * memcpy speed; only non-ASCII code points go through the tables. Bytes that are not
+ * valid UTF-8 are copied through unchanged.
+ *
+ * @param data Pointer to the UTF-8 bytes.
+ * @param size Number of bytes to convert.
+ * @param mapping Which mapping to apply; title maps every code point to its titlecase form.
+ * @param out The string the result is appended to.
+ */
+void GiUnicode::convert_case(const char *data, size_t size, CaseMapping mapping, std::string &out) {
+    out.reserve(out.size() + size);
+    size_t i = 0;
+    while (i < size) {
+        size_t run = ascii_prefix(data + i, size - i);
+        if (run > 0) {
+            size_t start = out.size();
+            out.resize(start + run);
+            ascii_case_run(data + i, run, mapping, &out[start]);
+            i += run;
+            continue;
+        }
+        char mapped[12];
+        size_t length;
+        size_t written = map_case(data + i, size - i, mapping, mapped, length);
+        out.append(mapped, written);
+        i += length;
+    }
+}
+
+/**
+ * @brief Converts a UTF-8 string to uppercase using the full Unicode mappings.
+ */
+std::string GiUnicode::upper(const std::string &str) {
+    std::string out;
+    convert_case(str.data(), str.size(), CaseMapping::upper, out);
+    return out;
+}
+
+/**
+ * @brief Converts a UTF-8 string to lowercase using the full Unicode mappings.
+ */
+std::string GiUnicode::lower(const std::string &str) {
+    std::string out;
+    convert_case(str.data(), str.size(), CaseMapping::lower, out);
+    return out;
+}
+
+/**
+ * @brief Applies full Unicode case folding to a UTF-8 string, for caseless matching and keys.
+ */
+std::string GiUnicode::fold(const std::string &str) {
+    std::string out;
+    convert_case(str.data(), str.size(), CaseMapping::fold, out);
+    return out;
+}
+
+// Example usage:
+// std::cout << GiUnicode::upper("zażółć gęślą jaźń") << " " << GiUnicode::upper("Straße") << std::endl;
+// Output: "ZAŻÓŁĆ GĘŚLĄ JAŹŃ STRASSE"
+
+/**
+ * @brief Compares two UTF-8 buffers for equality under full case folding.
+ *
+ * Pure ASCII inputs are compared byte by byte without decoding; otherwise both sides are
+ * folded incrementally, without allocating.
+ *
+ * @return True if the folded forms are equal (e.g. "STRASSE" and "straße").
+ */
+bool GiUnicode::equals_ignore_case(const char *data1, size_t size1, const char *data2, size_t size2) {
+    if (is_ascii(data1, size1) && is_ascii(data2, size2)) {
+        if (size1 != size2) {
+            return false;
+        }
+        for (size_t i = 0; i < size1; ++i) {
+            if (ascii_case(data1[i], CaseMapping::lower) != ascii_case(data2[i], CaseMapping::lower)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    FoldedCodepoints first(data1, size1);
+    FoldedCodepoints second(data2, size2);
+    char32_t a;
+    char32_t b;
+    for (;;) {
+        bool has_a = first.next(a);
+        bool has_b = second.next(b);
+        if (!has_a || !has_b) {
+            return has_a == has_b;
+        }
+        if (a != b) {
+            return false;
+        }
+    }
+}
+
+bool GiUnicode::equals_ignore_case(const std::string &str1, const std::string &str2) {
+    return equals_ignore_case(str1.data(), str1.size(), str2.data(), str2.size());
+}
+
+// Example usage:
+// std::cout << GiUnicode::equals_ignore_case("ŁÓDŹ", "łódź") << GiUnicode::equals_ignore_case("STRASSE", "Straße") << std::endl;
+// Output: "11"
@@ -0,0 +1,49 @@
+#ifndef GIUNICODE_HPP
+#define GIUNICODE_HPP
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+class GiUnicode
+{
+public:
+    enum class CaseMapping
+    {
+        upper,
+        lower,
+        title,
+        fold
+    };
+
+    static char32_t decode_utf8(const char *data, size_t size, size_t &length);
+    static size_t encode_utf8(char32_t cp, char *out);
+    static int codepoint_width(char32_t cp);
+    static size_t display_width(const char *data, size_t size);
+    static size_t display_width(const std::string &str);
+    static size_t next_grapheme(const char *data, size_t size, size_t &width);
+    static size_t grapheme_count(const char *data, size_t size);
+    static size_t grapheme_count(const std::string &str);
+    static size_t fit_width(const char *data, size_t size, size_t max_width, size_t &width);
+
+    static size_t ascii_prefix(const char *data, size_t size);
+    static bool is_ascii(const char *data, size_t size);
+
+    static char32_t simple_case(char32_t cp, CaseMapping mapping);
+    static char32_t to_upper(char32_t cp);
+    static char32_t to_lower(char32_t cp);
+    static char32_t to_title(char32_t cp);
+    static char32_t fold(char32_t cp);
+    static size_t full_case(char32_t cp, CaseMapping mapping, char32_t *out);
+    static bool is_cased(char32_t cp);
+    static size_t map_case(const char *data, size_t size, CaseMapping mapping, char *out, size_t &length);
+
+    static void convert_case(const char *data, size_t size, CaseMapping mapping, std::string &out);
+    static std::string upper(const std::string &str);
+    static std::string lower(const std::string &str);
+    static std::string fold(const std::string &str);
+    static bool equals_ignore_case(const char *data1, size_t size1, const char *data2, size_t size2);
+    static bool equals_ignore_case(const std::string &str1, const std::string &str2);
+};
+
+#endif // GIUNICODE_HPP
@@ -13,6 +13,11 @@
 #include "src/GiString/GiString.hpp"
 #include "src/GiInt/GiInt.hpp"
 #include "src/GiLogs/GiLogs.hpp"
+#include "src/GiUnicode/GiUnicode.hpp"
+#include "src/GiRope/GiRope.hpp"
+#include "src/GiExecutor/GiExecutor.hpp"
+#include "src/GiRandom/GiRandom.hpp"
+#include "src/GiSimilarity/GiSimilarity.hpp"
 
 
 
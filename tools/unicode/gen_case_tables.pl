@@ -0,0 +1,117 @@
+#!/usr/bin/env perl
+# Generates src/GiUnicode/GiUnicodeCase.inc, the case mapping tables used by GiUnicode.
+#
+# Input is the Unicode Character Database that ships with perl, read through Unicode::UCD
+# (UnicodeData.txt, CaseFolding.txt and SpecialCasing.txt); perl 5.36 carries Unicode 14.0.
+# To move to a newer Unicode version, run the script with a perl that bundles it.
+#
+# Usage (from the repository root):
+#     perl tools/unicode/gen_case_tables.pl > src/GiUnicode/GiUnicodeCase.inc
+use strict;
+use warnings;
+no warnings 'utf8';
+use feature qw(fc unicode_strings);
+use Unicode::UCD qw(charinfo casefold);
+
+my $block = 128;
+my ($major, $minor) = split /\./, Unicode::UCD::UnicodeVersion();
+
+# Simple mappings (upper, lower, title, fold) of every code point that has one
+my %simple;
+for my $cp (0 .. 0x10FFFF) {
+    next if $cp >= 0xD800 && $cp <= 0xDFFF;
+    my $info = charinfo($cp) or next;
+    my $upper = $info->{upper} ne '' ? hex $info->{upper} : $cp;
+    my $lower = $info->{lower} ne '' ? hex $info->{lower} : $cp;
+    my $title = $info->{title} ne '' ? hex $info->{title} : $upper;
+    my $fold = $cp;
+    if (my $folding = casefold($cp)) {
+        if ($folding->{simple} ne '') {
+            $fold = hex $folding->{simple};
+        } elsif ($folding->{status} eq 'C' || $folding->{status} eq 'S') {
+            $fold = hex $folding->{mapping};
+        }
+    }
+    $simple{$cp} = [$upper, $lower, $title, $fold] if $upper != $cp || $lower != $cp || $title != $cp || $fold != $cp;
+}
+sub simple { my $cp = shift; return $simple{$cp} || [$cp, $cp, $cp, $cp]; }
+
+# Full mappings (unconditional SpecialCasing.txt, C + F folding) that differ from the simple one
+my @specials;
+my %special_flags;
+for my $cp (0 .. 0x10FFFF) {
+    next if $cp >= 0xD800 && $cp <= 0xDFFF;
+    my $ch = chr $cp;
+    my @full = (uc $ch, lc $ch, ucfirst $ch, fc $ch);
+    for my $kind (0 .. 3) {
+        my @mapping = map { ord } split //, $full[$kind];
+        next if @mapping == 1 && $mapping[0] == simple($cp)->[$kind];
+        push @specials, [$cp, $kind, @mapping];
+        $special_flags{$cp} |= 1 << $kind;
+    }
+}
+
+my $max = 0;
+for my $cp (keys %simple, map { $_->[0] } @specials) {
+    $max = $cp if $cp > $max;
+}
+my $limit = (int($max / $block) + 1) * $block;
+
+# Records are numbered in order of first use, blocks likewise
+my (%records, @records, %blocks, @blocks, @stage1);
+my $zero = '0,0,0,0,0';
+$records{$zero} = 0;
+push @records, $zero;
+for (my $base = 0; $base < $limit; $base += $block) {
+    my @indexes;
+    for my $cp ($base .. $base + $block - 1) {
+        my $m = simple($cp);
+        my $key = join ',', (map { $_ - $cp } @$m), $special_flags{$cp} || 0;
+        unless (exists $records{$key}) {
+            $records{$key} = @records;
+            push @records, $key;
+        }
+        push @indexes, $records{$key};
+    }
+    my $key = join ',', @indexes;
+    unless (exists $blocks{$key}) {
+        $blocks{$key} = @blocks;
+        push @blocks, \@indexes;
+    }
+    push @stage1, $blocks{$key};
+}
+
+sub rows {
+    my ($values, $per, $indent) = @_;
+    my @lines;
+    for (my $i = 0; $i < @$values; $i += $per) {
+        my $last = $i + $per - 1 < $#$values ? $i + $per - 1 : $#$values;
+        push @lines, $indent . join(', ', @{$values}[$i .. $last]) . ',';
+    }
+    $lines[-1] =~ s/,$//;
+    return join "\n", @lines;
+}
+
+print "// Generated by tools/unicode/gen_case_tables.pl from the Unicode $major.$minor Character Database:\n";
+print "// simple mappings from UnicodeData.txt, simple case folding (C + S) and full mappings\n";
+print "// (unconditional SpecialCasing.txt, C + F folding).\n";
+print "// Lookup is three-stage: code point >> 7 selects a block, the block maps the low seven bits to a\n";
+print "// record, and the record holds the four deltas plus flags for the code points whose full mapping\n";
+print "// expands to several code points (listed in case_specials).\n\n";
+printf "const char32_t case_limit = 0x%X;\n\n", $limit;
+print "const uint8_t case_stage1[] = {\n", rows(\@stage1, 24, '    '), "\n};\n\n";
+print "const uint8_t case_blocks[][$block] = {\n";
+for my $i (0 .. $#blocks) {
+    print "    {\n", rows($blocks[$i], 32, '        '), "\n    }", ($i < $#blocks ? ',' : ''), "\n";
+}
+print "};\n\n";
+print "const CaseRecord case_records[] = {\n";
+print join(",\n", map { '    {' . join(', ', split /,/) . '}' } @records), "\n};\n\n";
+print "const SpecialCase case_specials[] = {\n";
+my @lines;
+for my $special (sort { $a->[0] <=> $b->[0] || $a->[1] <=> $b->[1] } @specials) {
+    my ($cp, $kind, @mapping) = @$special;
+    my @padded = (@mapping, (0) x (3 - @mapping));
+    push @lines, sprintf '    {0x%04X, %d, %d, {0x%04X, 0x%04X, 0x%04X}}', $cp, $kind, scalar @mapping, @padded;
+}
+print join(",\n", @lines), "\n};\n";
@@ -0,0 +1,108 @@
+#!/usr/bin/env perl
+# Generates src/GiUnicode/GiUnicodeWidth.inc, the display width and grapheme break tables
+# used by GiUnicode.
+#
+# Input is the Unicode Character Database that ships with perl, read through Unicode::UCD
+# (EastAsianWidth.txt, emoji-data.txt, DerivedGeneralCategory.txt and
+# GraphemeBreakProperty.txt); perl 5.36 carries Unicode 14.0. To move to a newer Unicode
+# version, run the script with a perl that bundles it.
+#
+# Usage (from the repository root):
+#     perl tools/unicode/gen_width_tables.pl > src/GiUnicode/GiUnicodeWidth.inc
+use strict;
+use warnings;
+use Unicode::UCD qw(prop_invlist);
+
+my $count = 0x110000;
+my $limit = 0xE1000; # Every code point from here up is Other, narrow and not pictographic
+my $leaf_bits = 6;
+my $row_bits = 10;
+my ($major, $minor) = split /\./, Unicode::UCD::UnicodeVersion();
+
+sub fill {
+    my ($property, $set) = @_;
+    my @list = prop_invlist($property);
+    push @list, $count if @list % 2;
+    for (my $i = 0; $i < @list; $i += 2) {
+        $set->($_) for $list[$i] .. $list[$i + 1] - 1;
+    }
+}
+
+# Must match enum GraphemeClass in GiUnicode.cpp
+my %grapheme_classes = (CR => 1, LF => 2, Control => 3, Extend => 4, ZWJ => 5, Regional_Indicator => 6, Prepend => 7,
+                        SpacingMark => 8, L => 9, V => 10, T => 11, LV => 12, LVT => 13);
+my @grapheme = (0) x $count;
+my @pictographic = (0) x $count;
+my @width = (1) x $count;
+for my $name (keys %grapheme_classes) {
+    fill("GCB=$name", sub { $grapheme[$_[0]] = $grapheme_classes{$name} });
+}
+fill('Extended_Pictographic', sub { $pictographic[$_[0]] = 1 });
+
+# Widths follow wcwidth(): wide and fullwidth characters and default-emoji-presentation
+# characters take two columns, marks, format and control characters none
+fill('ea=W', sub { $width[$_[0]] = 2 });
+fill('ea=F', sub { $width[$_[0]] = 2 });
+fill('Emoji_Presentation', sub { $width[$_[0]] = 2 });
+for my $category ('gc=Mn', 'gc=Me', 'gc=Cf', 'gc=Cc', 'gc=Zl', 'gc=Zp') {
+    fill($category, sub { $width[$_[0]] = 0 });
+}
+# Hangul jamo vowels and trailing consonants join the leading consonant's two columns
+$width[$_] = 0 for 0x1160 .. 0x11FF, 0xD7B0 .. 0xD7FF;
+# SOFT HYPHEN is Cf but terminals draw it as a hyphen
+$width[0xAD] = 1;
+
+my @props = map { $width[$_] | ($grapheme[$_] << 2) | ($pictographic[$_] << 6) } 0 .. $count - 1;
+for my $cp ($limit .. $count - 1) {
+    die sprintf("U+%04X past width_limit has properties %d\n", $cp, $props[$cp]) if $props[$cp] != 1;
+}
+
+# Leaves and rows are numbered in order of first use
+my (%leaves, @leaves, %rows, @rows, @stage1);
+my $leaf_size = 1 << $leaf_bits;
+my $row_size = 1 << ($row_bits - $leaf_bits);
+for my $high (0 .. ($limit >> $row_bits) - 1) {
+    my @row;
+    for my $middle (0 .. $row_size - 1) {
+        my $base = ($high << $row_bits) | ($middle << $leaf_bits);
+        my @leaf = @props[$base .. $base + $leaf_size - 1];
+        my $key = join ',', @leaf;
+        unless (exists $leaves{$key}) {
+            $leaves{$key} = @leaves;
+            push @leaves, \@leaf;
+        }
+        push @row, $leaves{$key};
+    }
+    my $key = join ',', @row;
+    unless (exists $rows{$key}) {
+        $rows{$key} = @rows;
+        push @rows, \@row;
+    }
+    push @stage1, $rows{$key};
+}
+die "Too many leaves or rows for uint8_t indexes\n" if @leaves > 256 || @rows > 256;
+
+print <<"END";
+// Generated by tools/unicode/gen_width_tables.pl from the Unicode $major.$minor Character Database:
+// East_Asian_Width, Emoji_Presentation, General_Category (Mn, Me, Cf, Cc, Zl, Zp are zero width),
+// Grapheme_Cluster_Break and Extended_Pictographic. Two widths deliberately follow wcwidth()
+// rather than these properties: Hangul jamo vowels and trailing consonants (U+1160-11FF,
+// U+D7B0-D7FF) are zero width, and U+00AD SOFT HYPHEN is one column.
+// Each code point has one property byte (layout at width_props in GiUnicode.cpp); lookup is
+// three-stage: code point >> 10 selects a row of width_stage2, which maps bits 6-9 to a 64-entry
+// leaf of width_leaves. Code points from width_limit up have the byte 1.
+
+END
+printf "const char32_t width_limit = 0x%X;\n\n", $limit;
+print "const uint8_t width_stage1[] = {\n";
+for (my $i = 0; $i < @stage1; $i += 24) {
+    my $last = $i + 23 < $#stage1 ? $i + 23 : $#stage1;
+    print '    ', join(', ', @stage1[$i .. $last]), ",\n";
+}
+print "};\n\n";
+print "const uint8_t width_stage2[][$row_size] = {\n";
+print '    {', join(', ', @$_), "},\n" for @rows;
+print "};\n\n";
+print "const uint8_t width_leaves[][$leaf_size] = {\n";
+print '    {', join(', ', @$_), "},\n" for @leaves;
+print "};\n";